@@ -0,0 +1,438 @@
+#include <benchmark/benchmark.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/exporter.h>
+#include <people_msgs_utils/formation.h>
+#include <people_msgs_utils/fusion.h>
+#include <people_msgs_utils/gating.h>
+#include <people_msgs_utils/group.h>
+#include <people_msgs_utils/occupancy.h>
+#include <people_msgs_utils/ospace.h>
+#include <people_msgs_utils/people_arrays.h>
+#include <people_msgs_utils/person.h>
+#include <people_msgs_utils/prediction.h>
+#include <people_msgs_utils/recording.h>
+#include <people_msgs_utils/robot_metrics.h>
+#include <people_msgs_utils/shared_frame.h>
+#include <people_msgs_utils/social_cost.h>
+#include <people_msgs_utils/spatial_index.h>
+#include <people_msgs_utils/utils.h>
+
+#include <cstdio>
+
+using namespace people_msgs_utils;
+
+std::vector<people_msgs::Person> createCrowd(size_t num_people, double group_ratio, size_t group_size = 4);
+geometry_msgs::TransformStamped createTransform();
+
+// Benchmarks
+static void BM_ParseStringDouble(benchmark::State& state) {
+	auto people_std = createCrowd(1, 0.0);
+	// pose covariance
+	std::string cov = people_std.front().tags.at(1);
+	for (auto _: state) {
+		auto values = parseString<double>(cov, " ");
+		benchmark::DoNotOptimize(values);
+	}
+	state.SetItemsProcessed(state.iterations() * Person::COV_MAT_SIZE);
+}
+BENCHMARK(BM_ParseStringDouble);
+
+static void BM_PersonFromTags(benchmark::State& state) {
+	auto people_std = createCrowd(2, 1.0, 2);
+	for (auto _: state) {
+		Person person(people_std.front());
+		benchmark::DoNotOptimize(person);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PersonFromTags);
+
+/// Arguments: number of people, percentage of people assigned to groups
+static void BM_CreateFromPeople(benchmark::State& state) {
+	auto people_std = createCrowd(state.range(0), state.range(1) / 100.0);
+	for (auto _: state) {
+		auto result = createFromPeople(people_std);
+		benchmark::DoNotOptimize(result);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreateFromPeople)
+	->ArgsProduct({{10, 100, 1000, 5000}, {0, 50, 100}})
+	->Unit(benchmark::kMicrosecond);
+
+/// Same as BM_CreateFromPeople, but reuses the output frame between iterations
+static void BM_CreateFromPeopleReusing(benchmark::State& state) {
+	auto people_std = createCrowd(state.range(0), state.range(1) / 100.0);
+	Frame frame;
+	for (auto _: state) {
+		createFromPeople(people_std, frame);
+		benchmark::DoNotOptimize(frame);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CreateFromPeopleReusing)
+	->ArgsProduct({{10, 100, 1000, 5000}, {0, 50, 100}})
+	->Unit(benchmark::kMicrosecond);
+
+/// Argument: group size; spatial model is computed in the constructor of the group
+static void BM_ComputeSpatialModel(benchmark::State& state) {
+	People members;
+	std::vector<std::string> member_ids;
+	std::tie(members, std::ignore) = createFromPeople(createCrowd(state.range(0), 0.0));
+	for (const auto& member: members) {
+		member_ids.push_back(member.getName());
+	}
+	std::vector<std::tuple<std::string, std::string, double>> relations;
+	for (auto _: state) {
+		Group group("0", 10, members, member_ids, relations, geometry_msgs::Point());
+		benchmark::DoNotOptimize(group);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ComputeSpatialModel)->RangeMultiplier(2)->Range(2, 32);
+
+static void BM_PersonTransform(benchmark::State& state) {
+	People people;
+	std::tie(people, std::ignore) = createFromPeople(createCrowd(1, 0.0));
+	auto transform = createTransform();
+	for (auto _: state) {
+		Person person = people.front();
+		person.transform(transform);
+		benchmark::DoNotOptimize(person);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PersonTransform);
+
+/// Argument: group size
+static void BM_GroupTransform(benchmark::State& state) {
+	Groups groups;
+	std::tie(std::ignore, groups) = createFromPeople(createCrowd(state.range(0), 1.0, state.range(0)));
+	auto transform = createTransform();
+	if (groups.size() != 1) {
+		state.SkipWithError("A single group was expected");
+		return;
+	}
+	for (auto _: state) {
+		Group group = groups.front();
+		group.transform(transform);
+		benchmark::DoNotOptimize(group);
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GroupTransform)->RangeMultiplier(2)->Range(2, 32);
+
+/// Argument: number of people; rebuild of the index per frame
+static void BM_SpatialIndexBuild(benchmark::State& state) {
+	auto frame = createFromPeople(createCrowd(state.range(0), 0.5));
+	SpatialIndex index;
+	for (auto _: state) {
+		index.build(frame.first, frame.second);
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpatialIndexBuild)->RangeMultiplier(10)->Range(10, 10000);
+
+/// Argument: number of people; queries of a costmap-like window
+static void BM_SpatialIndexQueryRadius(benchmark::State& state) {
+	auto frame = createFromPeople(createCrowd(state.range(0), 0.5));
+	SpatialIndex index;
+	index.build(frame.first, frame.second);
+	std::vector<size_t> indices;
+	double x = -10.0;
+	for (auto _: state) {
+		index.queryRadius(x, 0.5 * x, 2.0, indices);
+		benchmark::DoNotOptimize(indices.data());
+		x = x > 10.0 ? -10.0 : x + 0.05;
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpatialIndexQueryRadius)->RangeMultiplier(10)->Range(10, 10000);
+
+/// Argument: number of people; 10 x 10 m costmap window with 5 cm resolution, throughput in cells/second
+static void BM_SocialCostGrid(benchmark::State& state) {
+	CrowdGenerator::Parameters params;
+	params.num_people = state.range(0);
+	params.area_size = 10.0;
+	auto frame = createFromPeople(CrowdGenerator(params).generate());
+	SocialCostModel model;
+	model.setFrame(frame.first, frame.second);
+
+	GridWindow grid;
+	grid.origin_x = -5.0;
+	grid.origin_y = -5.0;
+	grid.resolution = 0.05;
+	grid.size_x = 200;
+	grid.size_y = 200;
+	std::vector<double> costs;
+	for (auto _: state) {
+		model.evaluateGrid(grid, costs);
+		benchmark::DoNotOptimize(costs.data());
+	}
+	state.SetItemsProcessed(state.iterations() * grid.size_x * grid.size_y);
+}
+BENCHMARK(BM_SocialCostGrid)->RangeMultiplier(4)->Range(4, 64)->Unit(benchmark::kMicrosecond);
+
+/// Argument: number of trajectory points tested against O-spaces of groups of 100 people
+static void BM_OSpaceContains(benchmark::State& state) {
+	Groups groups;
+	std::tie(std::ignore, groups) = createFromPeople(createCrowd(100, 1.0));
+	OSpaceQuery query;
+	query.setGroups(groups);
+
+	std::vector<double> xs;
+	std::vector<double> ys;
+	for (int k = 0; k < state.range(0); k++) {
+		xs.push_back(-20.0 + 40.0 * k / state.range(0));
+		ys.push_back(5.0 * std::sin(0.01 * k));
+	}
+	std::vector<uint8_t> inside(xs.size());
+	for (auto _: state) {
+		query.contains(xs.data(), ys.data(), xs.size(), inside.data());
+		benchmark::DoNotOptimize(inside.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OSpaceContains)->RangeMultiplier(10)->Range(100, 100000);
+
+static void BM_RobotRelativeMetrics(benchmark::State& state) {
+	People people;
+	std::tie(people, std::ignore) = createFromPeople(createCrowd(state.range(0), 0.5));
+	PeopleArrays arrays;
+	arrays.assign(people);
+	RobotState robot;
+	robot.vx = 0.5;
+
+	RobotRelativeMetrics metrics;
+	std::vector<size_t> critical;
+	for (auto _: state) {
+		computeRobotRelativeMetrics(robot, arrays, 0.6, metrics);
+		selectMostCritical(metrics, 10, CriticalityCriterion::TIME_TO_COLLISION, critical);
+		benchmark::DoNotOptimize(critical.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RobotRelativeMetrics)->RangeMultiplier(10)->Range(100, 10000);
+
+static void BM_PredictConstantVelocity(benchmark::State& state) {
+	People people;
+	Groups groups;
+	std::tie(people, groups) = createFromPeople(createCrowd(state.range(0), 0.5));
+	PeopleArrays arrays;
+	arrays.assign(people);
+
+	ConstantVelocityPredictor::Parameters params;
+	params.steps = 30;
+	ConstantVelocityPredictor predictor(params);
+	Prediction prediction;
+	for (auto _: state) {
+		predictor.predict(arrays, groups, prediction);
+		benchmark::DoNotOptimize(prediction.x.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * params.steps);
+}
+BENCHMARK(BM_PredictConstantVelocity)->RangeMultiplier(10)->Range(100, 10000);
+
+static void BM_RasterizeOccupancy(benchmark::State& state) {
+	People people;
+	Groups groups;
+	std::tie(people, groups) = createFromPeople(createCrowd(100, 0.5));
+
+	GridWindow grid;
+	grid.origin_x = -20.0;
+	grid.origin_y = -20.0;
+	grid.size_x = 800;
+	grid.size_y = 800;
+	ConstantVelocityPredictor::Parameters horizon;
+	horizon.steps = 20;
+	ConstantVelocityPredictor predictor(horizon);
+	OccupancyRasterizer rasterizer(
+		OccupancyRasterizer::Parameters(),
+		state.range(0) > 1 ? createThreadParallelFor(state.range(0)) : ParallelFor()
+	);
+	SpaceTimeOccupancy occupancy;
+	for (auto _: state) {
+		rasterizer.rasterize(people, groups, predictor, grid, occupancy);
+		benchmark::DoNotOptimize(occupancy.cells.data());
+	}
+	state.SetItemsProcessed(state.iterations() * horizon.steps);
+}
+BENCHMARK(BM_RasterizeOccupancy)->Arg(1)->Arg(4)->UseRealTime();
+
+static void BM_RasterizeCost(benchmark::State& state) {
+	People people;
+	Groups groups;
+	std::tie(people, groups) = createFromPeople(createCrowd(100, 0.5));
+
+	GridWindow grid;
+	grid.origin_x = -20.0;
+	grid.origin_y = -20.0;
+	grid.size_x = 800;
+	grid.size_y = 800;
+	ConstantVelocityPredictor::Parameters horizon;
+	horizon.steps = 20;
+	ConstantVelocityPredictor predictor(horizon);
+	OccupancyRasterizer rasterizer(
+		OccupancyRasterizer::Parameters(),
+		state.range(0) > 1 ? createThreadParallelFor(state.range(0)) : ParallelFor()
+	);
+	SpaceTimeCost cost;
+	for (auto _: state) {
+		rasterizer.rasterize(people, groups, predictor, grid, cost);
+		benchmark::DoNotOptimize(cost.cells.data());
+	}
+	state.SetItemsProcessed(state.iterations() * horizon.steps);
+}
+BENCHMARK(BM_RasterizeCost)->Arg(1)->Arg(4)->UseRealTime();
+
+static void BM_DetectFFormations(benchmark::State& state) {
+	People people;
+	Groups groups;
+	std::tie(people, groups) = createFromPeople(createCrowd(state.range(0), 0.5));
+
+	FFormationDetector detector;
+	for (auto _: state) {
+		detector.detect(people, groups);
+		benchmark::DoNotOptimize(groups.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DetectFFormations)->RangeMultiplier(10)->Range(100, 10000)->Unit(benchmark::kMicrosecond);
+
+static void BM_GateMahalanobis(benchmark::State& state) {
+	People people;
+	Groups groups;
+	std::tie(people, groups) = createFromPeople(createCrowd(state.range(0), 0.5));
+	PeopleArrays arrays;
+	arrays.assign(people);
+
+	// points along a path crossing the crowd
+	std::vector<double> xs;
+	std::vector<double> ys;
+	for (size_t i = 0; i < 100; i++) {
+		xs.push_back(-20.0 + 0.4 * i);
+		ys.push_back(0.1 * i);
+	}
+	double threshold = chiSquareQuantile2D(0.99);
+	std::vector<GatingPair> pairs;
+	for (auto _: state) {
+		gateMahalanobis(arrays, xs.data(), ys.data(), xs.size(), threshold, pairs);
+		benchmark::DoNotOptimize(pairs.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * xs.size());
+}
+BENCHMARK(BM_GateMahalanobis)->RangeMultiplier(10)->Range(100, 10000);
+
+static void BM_FusePeople(benchmark::State& state) {
+	Frame first;
+	createFromPeople(createCrowd(state.range(0), 0.5), first);
+	// the second source observes the same people with other IDs
+	Frame second = first;
+	for (auto& person: second.people) {
+		person.setName("s" + person.getName());
+		person.setPlanarState(
+			person.getPositionX() + 0.05,
+			person.getPositionY(),
+			person.getOrientationYaw(),
+			person.getVelocityX(),
+			person.getVelocityY()
+		);
+	}
+	second.groups.clear();
+
+	PeopleFusion fusion;
+	Frame fused;
+	for (auto _: state) {
+		fusion.fuse({&first, &second}, fused);
+		benchmark::DoNotOptimize(fused.people.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+BENCHMARK(BM_FusePeople)->RangeMultiplier(10)->Range(100, 1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_PublishSharedFrame(benchmark::State& state) {
+	Frame frame;
+	createFromPeople(createCrowd(state.range(0), 0.5), frame);
+	SharedFrameWriter writer("/people_msgs_utils_benchmark");
+	SharedFrameReader reader(writer.getName());
+	SharedFrameView view;
+	for (auto _: state) {
+		writer.publish(frame);
+		reader.getLatest(view);
+		benchmark::DoNotOptimize(view.x);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PublishSharedFrame)->RangeMultiplier(10)->Range(100, 1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_ReplayRecording(benchmark::State& state) {
+	const size_t NUM_FRAMES = 64;
+	std::string path = "/tmp/people_msgs_utils_benchmark.rec";
+	{
+		Frame frame;
+		createFromPeople(createCrowd(state.range(0), 0.5), frame);
+		FrameRecorder recorder(path);
+		for (size_t n = 0; n < NUM_FRAMES; n++) {
+			frame.header.stamp = ros::Time(1.0 + 0.1 * n);
+			recorder.record(frame);
+		}
+	}
+
+	FrameRecording recording(path);
+	std::vector<double> x;
+	std::vector<double> y;
+	size_t n = 0;
+	for (auto _: state) {
+		auto view = recording.getFrame(n++ % NUM_FRAMES);
+		view.decodePositions(x, y);
+		benchmark::DoNotOptimize(x.data());
+		benchmark::DoNotOptimize(y.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	std::remove(path.c_str());
+}
+BENCHMARK(BM_ReplayRecording)->RangeMultiplier(10)->Range(100, 1000)->Unit(benchmark::kMicrosecond);
+
+static void BM_ExportFrames(benchmark::State& state) {
+	Frame frame;
+	createFromPeople(createCrowd(1000, 0.5), frame);
+	std::string path = "/tmp/people_msgs_utils_benchmark.export";
+	FrameExporter::Parameters params;
+	params.format = state.range(0) ? FrameExporter::Format::ARROW : FrameExporter::Format::CSV;
+	{
+		FrameExporter exporter(path, params);
+		for (auto _: state) {
+			exporter.append(frame);
+		}
+		exporter.close();
+	}
+	state.SetItemsProcessed(state.iterations() * frame.people.size());
+	std::remove(path.c_str());
+}
+// CSV, Arrow
+BENCHMARK(BM_ExportFrames)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
+
+// .........................................................................
+
+std::vector<people_msgs::Person> createCrowd(size_t num_people, double group_ratio, size_t group_size) {
+	CrowdGenerator::Parameters params;
+	params.num_people = num_people;
+	params.group_ratio = group_ratio;
+	params.group_size_min = group_size;
+	params.group_size_max = group_size;
+	return CrowdGenerator(params).generate();
+}
+
+geometry_msgs::TransformStamped createTransform() {
+	geometry_msgs::TransformStamped transform;
+	transform.header.frame_id = "map";
+	transform.child_frame_id = "base_link";
+	transform.transform.translation.x = 1.5;
+	transform.transform.translation.y = -2.0;
+	transform.transform.rotation.z = 0.247404;
+	transform.transform.rotation.w = 0.9689124;
+	return transform;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <people_msgs/People.h>
+
+#include <people_msgs_utils/frame_snapshot.h>
+#include <people_msgs_utils/parallel.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Asynchronous stage around @ref createFromPeople
+ *
+ * Raw messages are pushed (e.g., from a subscriber callback) to a bounded queue, a worker thread converts them
+ * and publishes the result to a @ref FrameSnapshot. Does not depend on ROS spinning, so it can be driven
+ * by plain threads.
+ *
+ * The queue is meant for a single producer and the single (internal) consumer. It is guarded by a mutex, since
+ * dropping superseded frames requires the producer to evict queued items.
+ */
+class ConversionPipeline {
+public:
+	/// Defines what happens when a message is pushed to the full queue
+	enum class OverflowPolicy {
+		/// The oldest queued message is discarded (superseded by the new one)
+		DROP_OLDEST,
+		/// The new message is discarded
+		DROP_NEWEST,
+		/// Producer waits until the worker makes space in the queue
+		BLOCK
+	};
+
+	/// Counters and latency statistics (time from @ref push to the frame being ready)
+	struct Statistics {
+		unsigned long int pushed = 0;
+		unsigned long int converted = 0;
+		unsigned long int dropped = 0;
+		/// Messages that could not be converted (e.g., with malformed tags)
+		unsigned long int failed = 0;
+		/// Latencies in seconds
+		double latency_last = 0.0;
+		double latency_min = 0.0;
+		double latency_max = 0.0;
+		double latency_mean = 0.0;
+	};
+
+	/**
+	 * @param capacity maximum number of messages waiting for conversion (at least 1)
+	 * @param policy what to do with messages that do not fit into the queue; use DROP_OLDEST with capacity 1
+	 * to always convert the latest message only
+	 * @param parallel_for optional executor passed to @ref createFromPeople
+	 */
+	ConversionPipeline(
+		size_t capacity = 1,
+		OverflowPolicy policy = OverflowPolicy::DROP_OLDEST,
+		const ParallelFor& parallel_for = ParallelFor()
+	);
+
+	/// Stops the worker; messages still in the queue are discarded
+	~ConversionPipeline();
+
+	ConversionPipeline(const ConversionPipeline&) = delete;
+	ConversionPipeline& operator=(const ConversionPipeline&) = delete;
+
+	/**
+	 * @brief Enqueues the message for conversion
+	 *
+	 * @return false if the message (the new one or a queued one, depending on policy) was dropped
+	 */
+	bool push(const std::shared_ptr<const people_msgs::People>& msg);
+
+	/// Returns the most recently converted frame
+	inline std::shared_ptr<const Frame> getLatest() const {
+		return snapshot_.get();
+	}
+
+	/// Returns the snapshot that is updated by the worker; allows sharing it with other consumers
+	inline const FrameSnapshot& getSnapshot() const {
+		return snapshot_;
+	}
+
+	/// Sets a function that is called from the worker thread once a new frame is ready
+	void setCallback(const std::function<void(const std::shared_ptr<const Frame>&)>& callback);
+
+	/**
+	 * @brief Blocks until all queued messages are converted
+	 *
+	 * @return false if the @ref timeout elapsed before
+	 */
+	bool waitUntilIdle(std::chrono::milliseconds timeout);
+
+	Statistics getStatistics() const;
+
+protected:
+	typedef std::chrono::steady_clock Clock;
+
+	struct Item {
+		std::shared_ptr<const people_msgs::People> msg;
+		Clock::time_point push_time;
+	};
+
+	/// Worker's loop
+	void process();
+
+	/// Ring buffer storage
+	std::vector<Item> queue_;
+	size_t queue_head_;
+	size_t queue_size_;
+	OverflowPolicy policy_;
+	ParallelFor parallel_for_;
+
+	/// Set when the worker converts a message that was already removed from the queue
+	bool busy_;
+	bool stop_;
+	mutable std::mutex mutex_;
+	/// Notifies the worker about new items and producer/waiters about free space or finished conversion
+	std::condition_variable cv_worker_;
+	std::condition_variable cv_producer_;
+
+	std::function<void(const std::shared_ptr<const Frame>&)> callback_;
+	Statistics stats_;
+
+	FrameSnapshot snapshot_;
+	std::thread worker_;
+};
+
+} // namespace people_msgs_utils
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <people_msgs/Person.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Deterministic generator of synthetic crowds encoded as people_msgs with spencer-style tags
+ *
+ * Produces data that follow the tag scheme expected by the Person and Group parsers, which is handy for
+ * benchmarks, fuzzing and soak tests without recorded bags. Random values are derived directly from
+ * std::mt19937 (not from std distributions, whose implementations differ between standard libraries),
+ * so the same seed gives the same output on every platform.
+ */
+class CrowdGenerator {
+public:
+	struct Parameters {
+		uint32_t seed = 0;
+		size_t num_people = 100;
+		/// Fraction of people that are assigned to groups
+		double group_ratio = 0.5;
+		/// Sizes of groups are drawn uniformly from [group_size_min, group_size_max]
+		size_t group_size_min = 2;
+		size_t group_size_max = 5;
+		/// Fraction of pairs of group members that have their social relation given
+		double relation_density = 1.0;
+		/// Whether pose and twist covariance tags are generated
+		bool covariance_tags = true;
+		/// Fraction of people marked as occluded (and not matched) in each frame
+		double occlusion_ratio = 0.1;
+		/// Fraction of people with a corrupted tag (non-numeric value or missing tag value) in each frame
+		double malformed_tag_ratio = 0.0;
+		/// Side length of the square area (centered at the origin) that people move within
+		double area_size = 40.0;
+		double speed_max = 1.5;
+		/// Time step of the motion between consecutive frames
+		double dt = 0.1;
+	};
+
+	explicit CrowdGenerator(const Parameters& params);
+
+	/// Creates messages describing the current state of the crowd
+	std::vector<people_msgs::Person> generate();
+
+	/// Advances the motion of the crowd by the time step; tracks and groups get older
+	void step();
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	struct PersonState {
+		double x;
+		double y;
+		double vx;
+		double vy;
+		unsigned long int track_age;
+		/// Index of the group or -1 if not assigned
+		int group;
+	};
+
+	struct GroupState {
+		double x;
+		double y;
+		double vx;
+		double vy;
+		unsigned long int age;
+		std::vector<size_t> members;
+		/// Offsets of members relative to the group's center
+		std::vector<std::pair<double, double>> offsets;
+		/// Triplets: index of a member, index of the other member, strength
+		std::vector<std::tuple<size_t, size_t, double>> relations;
+	};
+
+	/// Uniform value in [0, 1)
+	double uniform();
+
+	/// Uniform value in [min, max)
+	double uniform(double min, double max);
+
+	/// Keeps the position within the area, reflecting the velocity at its borders
+	void reflect(double& x, double& y, double& vx, double& vy) const;
+
+	std::string createCovArray(double xx, double xy, double yy, double yawyaw) const;
+
+	Parameters params_;
+	std::mt19937 rng_;
+	std::vector<PersonState> people_;
+	std::vector<GroupState> groups_;
+};
+
+} // namespace people_msgs_utils
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <people_msgs_utils/frame.h>
+#include <people_msgs_utils/serialization.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Streams per-track time series of people into a CSV file or an Arrow IPC stream
+ *
+ * Each person of each appended frame becomes a row with the columns
+ * stamp, id, x, y, vx, vy, cov_xx, cov_yy, cov_yawyaw, reliability, group, relation, relation_strength,
+ * where the covariances are the diagonal of the pose covariance and relation is the ID of the person
+ * with the strongest social relation to this one in their group (missing, as is its strength, if there is none).
+ * Missing values, including NaN values of doubles and groups of people without one, are empty in CSV and null
+ * in Arrow.
+ *
+ * Rows are appended to columnar buffers that are flushed in row groups of Parameters::row_group_size rows,
+ * so the memory stays bounded regardless of the length of the run. In the Arrow format, each row group is
+ * a record batch of the IPC streaming format (readable, e.g., by pyarrow.ipc.open_stream); stamps are
+ * timestamps in nanoseconds, IDs are UTF-8 strings and other values are doubles.
+ */
+class FrameExporter {
+public:
+	enum class Format {
+		CSV,
+		ARROW
+	};
+
+	struct Parameters {
+		Format format = Format::CSV;
+		size_t row_group_size = 65536;
+		/// Significant digits of values written into CSV
+		int precision = 10;
+	};
+
+	/**
+	 * @brief Creates the file and writes the header (CSV) or the schema (Arrow)
+	 *
+	 * @throw std::runtime_error if the file cannot be created
+	 */
+	FrameExporter(const std::string& path, const Parameters& params);
+
+	explicit FrameExporter(const std::string& path);
+
+	/// Closes the output, see @ref close
+	~FrameExporter();
+
+	FrameExporter(const FrameExporter&) = delete;
+	FrameExporter& operator=(const FrameExporter&) = delete;
+
+	/**
+	 * @brief Appends rows of all people of the frame
+	 *
+	 * @throw std::runtime_error if writing a full row group fails
+	 */
+	void append(const Frame& frame);
+
+	/**
+	 * @brief Appends rows of a serialized people_msgs/People message
+	 *
+	 * The message is converted with @ref decodePeople and @ref createFromPeople operating on views, so tags
+	 * are parsed directly from the buffer and memory of the conversion is reused across calls
+	 *
+	 * @return false if the buffer could not be decoded
+	 */
+	bool append(const uint8_t* buffer, size_t length);
+
+	/// Writes buffered rows as a row group
+	void flush();
+
+	/**
+	 * @brief Flushes the rows and ends the stream
+	 *
+	 * Further calls have no effect
+	 */
+	void close();
+
+	/// Returns the number of appended rows
+	inline size_t getRowCount() const {
+		return num_rows_;
+	}
+
+	/// Returns the number of written row groups
+	inline size_t getRowGroupCount() const {
+		return num_row_groups_;
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	/// UTF-8 strings in the Arrow layout: offsets (one more than strings) into the characters
+	struct StringColumn {
+		std::vector<int32_t> offsets{0};
+		std::string chars;
+		/// Whether each string is missing (stored as empty)
+		std::vector<bool> nulls;
+
+		void append(std::string_view str);
+
+		void appendNull();
+
+		inline std::string_view get(size_t row) const {
+			return std::string_view(chars.data() + offsets[row], offsets[row + 1] - offsets[row]);
+		}
+
+		void clear();
+	};
+
+	/// Buffers of columns by their types
+	enum DoubleColumn {
+		X,
+		Y,
+		VX,
+		VY,
+		COV_XX,
+		COV_YY,
+		COV_YAWYAW,
+		RELIABILITY,
+		RELATION_STRENGTH,
+		NUM_DOUBLE_COLUMNS
+	};
+
+	enum StringColumnIndex {
+		ID,
+		GROUP,
+		RELATION,
+		NUM_STRING_COLUMNS
+	};
+
+	void writeCsvRows();
+
+	void writeArrowSchema();
+
+	void writeArrowRecordBatch();
+
+	/// Writes bytes, throws on failure
+	void write(const void* data, size_t size);
+
+	Parameters params_;
+	std::ofstream file_;
+	size_t num_rows_;
+	size_t num_row_groups_;
+
+	/// Buffered row group
+	std::vector<int64_t> stamps_;
+	std::array<std::vector<double>, NUM_DOUBLE_COLUMNS> doubles_;
+	std::array<StringColumn, NUM_STRING_COLUMNS> strings_;
+
+	/// Strongest relations of people in the frame being appended
+	std::unordered_map<std::string_view, size_t> person_index_;
+	std::vector<double> relation_strengths_;
+	std::vector<const std::string*> relation_ids_;
+
+	/// Conversion of serialized messages
+	PeopleView view_;
+	Frame frame_;
+
+	/// Encoding buffers
+	std::string line_;
+	std::vector<uint8_t> metadata_;
+	std::vector<std::vector<uint8_t>> validity_;
+};
+
+} // namespace people_msgs_utils
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <people_msgs_utils/group.h>
+#include <people_msgs_utils/people_arrays.h>
+#include <people_msgs_utils/person.h>
+#include <people_msgs_utils/spatial_index.h>
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Detects groups (F-formations) geometrically, for trackers that provide no group data at all
+ *
+ * Each pair of people closer than Parameters::max_distance gets a synthetic relation strength in [0, 1]:
+ * - both standing: people of an F-formation look at the shared O-space, so their O-space center candidates
+ *   (a stride ahead of each person in the direction of the gaze) should coincide,
+ * - both moving: people walking together have coherent headings and similar speeds,
+ * - one standing, the other moving: 0.
+ *
+ * People are then clustered with @ref groupByRelations, so groups are connected components of pairs with a strength
+ * of at least Parameters::threshold. Groups have their spatial models computed and store the synthetic relations.
+ *
+ * Candidate pairs are found with a SpatialIndex whose cell size matches Parameters::max_distance, so the detection
+ * runs in expected time linear in the number of people unless the crowd is extremely dense. Buffers are kept
+ * between calls, therefore a single detector must not be used from multiple threads concurrently.
+ */
+class FFormationDetector {
+public:
+	struct Parameters {
+		/// Pairs of people farther apart than this are never related
+		double max_distance = 2.0;
+		/// People moving slower than this are considered standing
+		double standing_speed = 0.3;
+		/// Distance of the O-space center candidate from a standing person
+		double stride = 0.6;
+		/// Standard deviation of the distance between O-space center candidates of a standing pair
+		double ospace_tolerance = 0.5;
+		/// Standard deviation of the difference of speeds of a moving pair
+		double speed_tolerance = 0.3;
+		/// The minimum strength of a relation linking people into a group
+		double threshold = 0.5;
+	};
+
+	FFormationDetector();
+
+	explicit FFormationDetector(const Parameters& params);
+
+	/**
+	 * @brief Detects groups among @ref people
+	 *
+	 * Existing group assignments of @ref people are ignored; people are reassigned to the detected groups
+	 * (or to no group), see @ref groupByRelations.
+	 *
+	 * @param groups output; replaced with the detected groups
+	 */
+	void detect(People& people, Groups& groups);
+
+	/// Returns the synthetic relation strength of the given pair of people
+	double computeRelationStrength(const Person& a, const Person& b) const;
+
+	/// Returns relations of all candidate pairs evaluated by the last @ref detect call
+	inline const std::vector<std::tuple<std::string, std::string, double>>& getRelations() const {
+		return relations_;
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	/// Planar state of a person with the quantities used for scoring pairs
+	struct State {
+		double x;
+		double y;
+		double vx;
+		double vy;
+		double speed;
+		/// O-space center candidate
+		double ospace_x;
+		double ospace_y;
+	};
+
+	State createState(double x, double y, double yaw, double vx, double vy) const;
+
+	double computeRelationStrength(const State& a, const State& b) const;
+
+	Parameters params_;
+
+	PeopleArrays arrays_;
+	std::vector<State> states_;
+	SpatialIndex index_;
+	std::vector<size_t> neighbors_;
+	std::vector<std::tuple<std::string, std::string, double>> relations_;
+};
+
+} // namespace people_msgs_utils
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <people_msgs_utils/group.h>
+#include <people_msgs_utils/person.h>
+
+#include <std_msgs/Header.h>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Result of a single conversion of people_msgs/People, i.e., People and Groups created from one message
+ */
+struct Frame {
+	/// Header of the message; empty if the frame was created from a vector of people only
+	std_msgs::Header header;
+	People people;
+	Groups groups;
+};
+
+} // namespace people_msgs_utils
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <people_msgs_utils/frame.h>
+
+#include <string>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/// Kind of a change between two frames
+enum class FrameEventType {
+	/// Track @ref FrameEvent::person is present only in the newer frame
+	TRACK_APPEARED = 0,
+	/// Track @ref FrameEvent::person is present only in the older frame
+	TRACK_VANISHED,
+	/// Track @ref FrameEvent::person became a member of the group @ref FrameEvent::group
+	GROUP_JOINED,
+	/// Track @ref FrameEvent::person is no longer a member of the group @ref FrameEvent::group
+	GROUP_LEFT,
+	/// Group @ref FrameEvent::group is present only in the newer frame
+	GROUP_FORMED,
+	/// Group @ref FrameEvent::group is present only in the older frame
+	GROUP_DISSOLVED,
+	/// Members of the older group @ref FrameEvent::group moved to the newer group @ref FrameEvent::other_group,
+	/// while other members of the older group moved elsewhere
+	GROUP_SPLIT,
+	/// Members of the older group @ref FrameEvent::other_group moved to the newer group @ref FrameEvent::group,
+	/// which also gathers members of other older groups
+	GROUP_MERGED
+};
+
+/// Typed change between two frames; fields not related to the type are empty
+struct FrameEvent {
+	FrameEventType type;
+	std::string person;
+	std::string group;
+	std::string other_group;
+};
+
+/**
+ * @brief Computes typed changes of tracks and group membership between frames @ref prev and @ref curr
+ *
+ * People and groups are matched by names using hash indexes, so the cost is linear in the number of people.
+ * Membership is given by Person::getGroupName. Events are ordered by type (in the order of declaration
+ * of FrameEventType), then by the order of people (or groups) in the frame the event refers to.
+ *
+ * @param events output; cleared first
+ */
+void diffFrames(const Frame& prev, const Frame& curr, std::vector<FrameEvent>& events);
+
+/// @sa diffFrames
+std::vector<FrameEvent> diffFrames(const Frame& prev, const Frame& curr);
+
+/**
+ * @brief Changes of People and Groups between two frames that allow patching the older frame forward
+ *
+ * Only people and groups that were added, removed or changed (in any attribute) are stored,
+ * so the delta is small for slowly changing scenes, e.g., when recording or transmitting frames.
+ */
+struct PeopleFrameDelta {
+	/// Header of the newer frame (stamp and frame ID)
+	std_msgs::Header header;
+	/// Names of people present only in the older frame
+	std::vector<std::string> removed_people;
+	/// People of the newer frame that are new or differ from the ones of the older frame
+	People updated_people;
+	/// Names of groups present only in the older frame
+	std::vector<std::string> removed_groups;
+	/// Groups of the newer frame that are new or differ from the ones of the older frame
+	Groups updated_groups;
+
+	/// Computes the delta that turns @ref prev into @ref curr
+	static PeopleFrameDelta fromFrames(const Frame& prev, const Frame& curr);
+
+	/**
+	 * @brief Patches the older @ref frame, so it has the header and contains the same people and groups
+	 * as the newer one
+	 *
+	 * Changed people and groups are replaced in place and new ones are appended, so the order may differ
+	 * from the one of the newer frame
+	 */
+	void apply(Frame& frame) const;
+
+	/// Returns true if no people and groups changed; the header is not considered, as stamps of frames differ
+	inline bool empty() const {
+		return removed_people.empty() && updated_people.empty() && removed_groups.empty() && updated_groups.empty();
+	}
+};
+
+} // namespace people_msgs_utils
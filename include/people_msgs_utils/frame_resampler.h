@@ -0,0 +1,89 @@
+#pragma once
+
+#include <people_msgs_utils/frame.h>
+
+#include <ros/time.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Keeps the last few stamped frames and resamples them to arbitrary times, e.g., to the rate of a controller
+ *
+ * For a time between two stored frames, states of people present in both frames are interpolated linearly
+ * (orientation along the shorter arc). Otherwise, people are extrapolated with their constant velocities
+ * from the nearest frame. The set of people and groups (and all other attributes) is taken from the later
+ * of the two frames or from the nearest one, respectively.
+ *
+ * Groups are not refitted: each one is moved rigidly (see Group::moveRigidly) with the least-squares rigid motion
+ * of its members between the original and the resampled positions.
+ *
+ * Frames must be stamped, e.g., created with the overload of createFromPeople taking people_msgs::People.
+ */
+class FrameResampler {
+public:
+	struct Parameters {
+		/// Number of frames kept (at least 2)
+		size_t history = 3;
+		/// Frames are not extrapolated further than this [s]
+		double max_extrapolation = 0.5;
+	};
+
+	/// Uses default parameters
+	FrameResampler();
+
+	explicit FrameResampler(const Parameters& params);
+
+	/**
+	 * @brief Stores a copy of the @ref frame, replacing the oldest one if the history is full
+	 *
+	 * @return false if the frame is not newer than the latest stored one (it is ignored then)
+	 */
+	bool add(const Frame& frame);
+
+	/**
+	 * @brief Computes the frame at the @ref stamp
+	 *
+	 * @param frame output; its memory is reused, the stamp of its header is set to @ref stamp
+	 * @return false if no frame is stored or the @ref stamp is too far from the stored ones to be extrapolated
+	 */
+	bool resample(const ros::Time& stamp, Frame& frame) const;
+
+	/// Removes all frames
+	void clear();
+
+	/// Returns the number of stored frames
+	inline size_t size() const {
+		return count_;
+	}
+
+	/// Returns the latest stored frame; must not be called when empty
+	inline const Frame& getLatest() const {
+		return getFrame(0);
+	}
+
+	/// Returns time elapsed since the stamp of the latest frame, i.e., its staleness; must not be called when empty
+	inline double getAge(const ros::Time& now) const {
+		return (now - getLatest().header.stamp).toSec();
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	/// Returns the @ref k-th latest stored frame (0 is the latest)
+	inline const Frame& getFrame(size_t k) const {
+		return frames_[(head_ + frames_.size() - k) % frames_.size()];
+	}
+
+	Parameters params_;
+	/// Ring buffer of frames, the latest one is at @ref head_
+	std::vector<Frame> frames_;
+	size_t head_;
+	size_t count_;
+};
+
+} // namespace people_msgs_utils
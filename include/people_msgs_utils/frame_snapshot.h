@@ -0,0 +1,45 @@
+#pragma once
+
+#include <people_msgs_utils/frame.h>
+
+#include <atomic>
+#include <memory>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Shares the latest converted frame between a single writer and many reader threads
+ *
+ * Follows the RCU pattern: the writer publishes a new immutable frame by swapping a pointer, whereas readers
+ * grab a shared pointer to the current frame. Readers never copy the frame; the frame they hold stays valid
+ * (and unchanged) until they release it, so their work on the frame does not delay the writer.
+ *
+ * @note Reads are neither lock-free nor wait-free. With C++17, atomic operations on std::shared_ptr are used,
+ * which libstdc++ implements with a pool of mutexes: @ref get and @ref publish lock the same mutex for the
+ * duration of a pointer copy or swap, so readers and the writer may briefly block each other
+ */
+class FrameSnapshot {
+public:
+	/// Initially, an empty frame is stored
+	FrameSnapshot();
+
+	/// Publishes @ref frame as the latest one; must be called by a single writer thread only
+	void publish(Frame&& frame);
+
+	/// Publishes an already shared @ref frame as the latest one; must be called by a single writer thread only
+	void publish(std::shared_ptr<const Frame> frame);
+
+	/// Returns the latest frame; safe to call from any number of threads concurrently
+	std::shared_ptr<const Frame> get() const;
+
+	/// Returns number of frames published so far; allows readers to cheaply check whether the frame changed
+	inline unsigned long int getVersion() const {
+		return version_.load(std::memory_order_acquire);
+	}
+
+protected:
+	std::shared_ptr<const Frame> frame_;
+	std::atomic<unsigned long int> version_;
+};
+
+} // namespace people_msgs_utils
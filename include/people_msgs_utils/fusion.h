@@ -0,0 +1,70 @@
+#pragma once
+
+#include <people_msgs_utils/frame.h>
+#include <people_msgs_utils/gating.h>
+#include <people_msgs_utils/spatial_index.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Fuses frames of multiple trackers observing the same scene (e.g., 2D lidar and RGB-D) into a frame
+ * without duplicates
+ *
+ * Sources are processed in order; people of each source are matched against the people fused from the previous
+ * sources. Candidates are found with a SpatialIndex, so the fusion runs in expected time linear in the number
+ * of people. A candidate is accepted if it lies within the Mahalanobis gate w.r.t. the sum of both planar pose
+ * covariances; each person chooses the nearest one (in the Mahalanobis sense) that has not been taken by another
+ * person of the same source.
+ *
+ * Matched people are fused in the information form: positions and velocities are weighted by the inverses of their
+ * covariances. The fused person keeps the ID of the first source it was seen in; people of later sources whose
+ * IDs are already taken are renamed to "<source index>/<ID>".
+ *
+ * Groups of all sources are merged through the mapping of IDs: people assigned to the same group in any source
+ * end up in the same fused group (see groupByRelations), along with the relations reported by the sources.
+ * Fused groups are named after their first members, see GroupCache for identities persistent across frames.
+ */
+class PeopleFusion {
+public:
+	struct Parameters {
+		/// People farther apart than this are never fused; also the cell size of the spatial hash
+		double max_distance = 1.0;
+		/// The maximum squared Mahalanobis distance of fused people, see chiSquareQuantile2D
+		double gate = chiSquareQuantile2D(0.99);
+	};
+
+	PeopleFusion();
+
+	explicit PeopleFusion(const Parameters& params);
+
+	/**
+	 * @brief Fuses frames from multiple @ref sources into @ref fused
+	 *
+	 * People of all sources must be expressed in the same coordinate frame (see Person::transform). The header
+	 * of the output is taken from the first source, with the latest stamp of all sources.
+	 *
+	 * @param fused output; replaced
+	 */
+	void fuse(const std::vector<const Frame*>& sources, Frame& fused);
+
+	/// For each source of the last @ref fuse call, the index of the fused person for each of its people
+	inline const std::vector<std::vector<size_t>>& getAssignments() const {
+		return assignments_;
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	Parameters params_;
+
+	SpatialIndex index_;
+	std::vector<size_t> candidates_;
+	std::vector<std::vector<size_t>> assignments_;
+};
+
+} // namespace people_msgs_utils
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <people_msgs_utils/people_arrays.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/// Query point and person within the gate
+struct GatingPair {
+	size_t query;
+	size_t person;
+	/// Squared Mahalanobis distance of the query point from the person
+	double distance_sq;
+};
+
+/**
+ * @brief Returns the quantile of the chi-square distribution with 2 degrees of freedom
+ *
+ * I.e., the squared Mahalanobis distance bounding the given @ref probability mass of a planar Gaussian
+ * (e.g., 5.99 for 0.95)
+ */
+inline double chiSquareQuantile2D(double probability) {
+	return -2.0 * std::log(1.0 - probability);
+}
+
+/**
+ * @brief Returns the squared Mahalanobis distance of the point from the person @ref index of @ref people
+ *
+ * Uses the cached inverse of the pose covariance (see PeopleArrays::computeCovarianceFactors)
+ */
+inline double computeMahalanobisDistanceSq(const PeopleArrays& people, size_t index, double x, double y) {
+	double dx = x - people.x[index];
+	double dy = y - people.y[index];
+	return people.cov_inv_xx[index] * dx * dx
+		+ 2.0 * people.cov_inv_xy[index] * dx * dy
+		+ people.cov_inv_yy[index] * dy * dy;
+}
+
+/**
+ * @brief Finds all pairs of query points and people with the squared Mahalanobis distance not exceeding @ref threshold
+ *
+ * Distances are measured w.r.t. pose covariances of people, using their cached inverses. For each query, distances
+ * to all people are computed by a branch-free loop vectorized by the compiler, and only then compared
+ * with the threshold. Typical queries are detections to associate, poses of the robot or points of its footprint.
+ *
+ * @param xs, ys coordinates of @ref num_queries query points
+ * @param threshold e.g., from @ref chiSquareQuantile2D
+ * @param pairs output (cleared first); sorted by queries and then by people
+ */
+void gateMahalanobis(
+	const PeopleArrays& people,
+	const double* xs,
+	const double* ys,
+	size_t num_queries,
+	double threshold,
+	std::vector<GatingPair>& pairs
+);
+
+/// @sa gateMahalanobis
+std::vector<GatingPair> gateMahalanobis(
+	const PeopleArrays& people,
+	const std::vector<double>& xs,
+	const std::vector<double>& ys,
+	double threshold
+);
+
+} // namespace people_msgs_utils
@@ -5,7 +5,9 @@
 
 #include <people_msgs_utils/person.h>
 
+#include <functional>
 #include <limits>
+#include <string_view>
 #include <tuple>
 
 namespace people_msgs_utils {
@@ -18,13 +20,30 @@ public:
 	/// Value assigned to variances that are not measured
 	static constexpr auto COVARIANCE_UNKNOWN = 9999999.9;
 
+	/// Ellipse approximating the O-space, i.e., the part of the spatial model fitted to positions of members
+	struct Ellipse {
+		double center_x;
+		double center_y;
+		double yaw;
+		/// Full lengths of the axes, see @ref getSpanX and @ref getSpanY
+		double span_x;
+		double span_y;
+	};
+
+	/**
+	 * @brief Constructor with all attributes given explicitly
+	 *
+	 * @param ellipse if given, used in the spatial model instead of fitting an ellipse to members (e.g., an ellipse
+	 * stored in a recording, see FrameRecording)
+	 */
 	Group(
 		const std::string& id,
 		unsigned long int age,
 		const std::vector<Person>& members,
 		const std::vector<std::string>& member_ids,
 		const std::vector<std::tuple<std::string, std::string, double>>& relations,
-		const geometry_msgs::Point& center_of_gravity
+		const geometry_msgs::Point& center_of_gravity,
+		const Ellipse* ellipse = nullptr
 	);
 
 	/// @brief Constructor used by an aggregator of raw people_msgs
@@ -35,6 +54,57 @@ public:
 		std::vector<std::string> tags
 	);
 
+	/// @brief Constructor used by an aggregator of non-owning people_msgs contents (e.g., serialized messages)
+	Group(
+		const std::string& id,
+		const std::vector<Person>& members,
+		const std::vector<std::string_view>& tagnames,
+		const std::vector<std::string_view>& tags
+	);
+
+	/**
+	 * @brief Reinitializes the instance as the constructor with all attributes given explicitly would do
+	 *
+	 * Reuses memory already allocated by the instance
+	 *
+	 * @param ellipse if given, used in the spatial model instead of fitting an ellipse to members
+	 */
+	void assign(
+		const std::string& id,
+		unsigned long int age,
+		const std::vector<Person>& members,
+		const std::vector<std::string>& member_ids,
+		const std::vector<std::tuple<std::string, std::string, double>>& relations,
+		const geometry_msgs::Point& center_of_gravity,
+		const Ellipse* ellipse = nullptr
+	);
+
+	/**
+	 * @brief Reinitializes the instance as the constructor used by an aggregator of raw people_msgs would do
+	 *
+	 * Reuses memory already allocated by the instance
+	 *
+	 * @param ellipse if given, used in the spatial model instead of fitting an ellipse to members (e.g., an ellipse
+	 * cached from the previous frame, see GroupCache)
+	 *
+	 * @tparam StringT std::string or std::string_view (explicitly instantiated in the source file)
+	 */
+	template <typename StringT>
+	void assign(
+		const std::string& id,
+		const std::vector<Person>& members,
+		const std::vector<StringT>& tagnames,
+		const std::vector<StringT>& tags,
+		const Ellipse* ellipse = nullptr
+	);
+
+	/**
+	 * @brief Keeps only member IDs for which @ref is_tracked returns true, along with their relations and instances
+	 *
+	 * Center of gravity is recomputed according to the remaining members, spatial model only if any member was removed
+	 */
+	void retainMembers(const std::function<bool(const std::string&)>& is_tracked);
+
 	/**
 	 * @brief Transforms members and center of gravity and recalculates spatial model according to given @ref transform
 	 *
@@ -45,10 +115,20 @@ public:
 	 */
 	void transform(const geometry_msgs::TransformStamped& transform);
 
+	/**
+	 * @brief Moves the group rigidly in the plane: rotation by @ref yaw around the origin followed by translation
+	 * by (@ref x, @ref y)
+	 *
+	 * Members (including planar blocks of their pose and velocity covariances), center of gravity and the spatial
+	 * model (including its covariance) are moved without refitting, which is much cheaper than @ref transform,
+	 * e.g., when groups are interpolated in time
+	 */
+	void moveRigidly(double x, double y, double yaw);
+
 	/**
 	 * Returns identifier of the group
 	 */
-	inline std::string getName() const {
+	inline const std::string& getName() const {
 		return group_id_;
 	}
 
@@ -62,11 +142,11 @@ public:
 	 * @details User should always check if getMembers() returns non-empty vector.
 	 * The instance can be ill-formed if members are not given to constructor.
 	 */
-	inline std::vector<Person> getMembers() const {
+	inline const std::vector<Person>& getMembers() const {
 		return members_;
 	}
 
-	inline std::vector<std::string> getMemberIDs() const {
+	inline const std::vector<std::string>& getMemberIDs() const {
 		return member_ids_;
 	}
 
@@ -75,7 +155,7 @@ public:
 
 	/// @brief Returns social relations within the group expressed as tuple
 	/// Tuple contents: track ID, track ID, relation estimation accuracy
-	inline std::vector<std::tuple<std::string, std::string, double>> getSocialRelations() const {
+	inline const std::vector<std::tuple<std::string, std::string, double>>& getSocialRelations() const {
 		return social_relations_;
 	}
 
@@ -153,6 +233,9 @@ public:
 	/// Returns pose estimation reliability of the group arising from the members reliabilities
 	double getReliability() const;
 
+	/// Returns the ellipse of the spatial model
+	Ellipse getEllipse() const;
+
 	/// Returns length of the spatial model expressed in the local coordinate system (major axis of the ellipse)
 	inline double getSpanX() const {
 		return span_.x;
@@ -170,13 +253,18 @@ protected:
 	 * @brief Returns true if tagnames and tags are valid, no matter if expected data were found inside
 	 *
 	 * This method parses only group-specific tags
+	 *
+	 * @tparam StringT std::string or std::string_view (explicitly instantiated in the source file)
 	 */
-	bool parseTags(const std::vector<std::string>& tagnames, const std::vector<std::string>& tags);
+	template <typename StringT>
+	bool parseTags(const std::vector<StringT>& tagnames, const std::vector<StringT>& tags);
 
 	/**
 	 * @brief Computes parameters of a spatial model of the group represented by an ellipse with covariance
+	 *
+	 * @param ellipse if given, the ellipse is not fitted to members, only the covariance is computed
 	 */
-	void computeSpatialModel();
+	void computeSpatialModel(const Ellipse* ellipse = nullptr);
 
 	std::string group_id_;
 	/// How long person's group has been tracked
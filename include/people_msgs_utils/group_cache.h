@@ -0,0 +1,159 @@
+#pragma once
+
+#include <people_msgs_utils/group.h>
+#include <people_msgs_utils/person.h>
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Keeps identities and spatial models of groups across frames
+ *
+ * Upstream group IDs tend to flicker. A group of a new frame continues the cached group of the same ID or, if there
+ * is none, the cached group with the largest overlap of members (Jaccard index of member sets).
+ *
+ * If the members of a continued group are the same, its ellipse is derived from the cached one instead of being
+ * fitted (see @ref findEllipse):
+ * - reused as is if no member moved by more than Parameters::position_tolerance since the previous frame,
+ * - moved rigidly if the members moved rigidly since the ellipse was fitted, up to the tolerance (e.g., a group
+ *   walking together).
+ *
+ * The cache keeps the positions of members at the time of fitting and the rigid motion of the group since then,
+ * so deformations of the formation cannot add up over frames: the ellipse is refitted once the members deviate
+ * from their moved positions at fitting by more than the tolerance.
+ *
+ * Covariances of the spatial model are always computed from current members. Use with the overload
+ * of createFromPeople taking the cache, which consults and updates it, so frames must be converted in order.
+ */
+class GroupCache {
+public:
+	/// Marks an invalid entry
+	static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+	/// How the ellipse of a group was obtained in the last frame
+	enum class EllipseSource {
+		FITTED,
+		REUSED,
+		MOVED
+	};
+
+	struct Parameters {
+		/// Members displaced by at most this distance (beyond a rigid motion of the group) keep the cached ellipse
+		double position_tolerance = 0.05;
+		/// The minimum Jaccard index of member sets for a group with a new ID to continue a cached group
+		double min_overlap = 0.5;
+		/// Number of frames a group may be missing before it is forgotten
+		size_t max_missed_frames = 10;
+	};
+
+	/// Persistent state of a group
+	struct Track {
+		/// Persistent identity: the ID of the group when it was first seen
+		std::string id;
+		/// ID of the group in the frame it was last seen
+		std::string name;
+		/// Number of frames since the group was first seen (0 in the first frame)
+		size_t age;
+		/// Number of consecutive frames the group has been seen in (0 if missing in the last frame)
+		size_t continuity;
+		/// Number of frames since the group was last seen
+		size_t missed;
+		EllipseSource ellipse_source;
+	};
+
+	GroupCache();
+
+	explicit GroupCache(const Parameters& params);
+
+	/**
+	 * @brief Derives the ellipse of a group of the new frame from the cache, if possible
+	 *
+	 * Const, so may be called concurrently for multiple groups
+	 *
+	 * @param name ID of the group
+	 * @param members members of the group in the new frame
+	 * @param ellipse output
+	 * @return false if the ellipse must be fitted
+	 */
+	bool findEllipse(const std::string& name, const std::vector<Person>& members, Group::Ellipse& ellipse) const;
+
+	/**
+	 * @brief Updates tracks with the groups of a new frame
+	 *
+	 * Groups that were not continued by any of @ref groups are marked as missing; the ones missing for too long
+	 * are forgotten
+	 */
+	void update(const Groups& groups);
+
+	/// Returns the track of the group with the given ID (in the last frame), nullptr if there is none
+	const Track* find(const std::string& name) const;
+
+	/// Forgets all groups
+	void clear();
+
+	/// Returns the number of tracked groups (including the missing ones)
+	inline size_t size() const {
+		return entries_.size();
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	/// Rigid motion of a group: rotation by @ref yaw about the origin followed by translation by (x, y)
+	struct RigidMotion {
+		double x = 0.0;
+		double y = 0.0;
+		double yaw = 0.0;
+	};
+
+	struct Entry {
+		Track track;
+		/// Members when the ellipse was fitted, sorted by names
+		std::vector<std::string> member_names;
+		std::vector<double> member_x;
+		std::vector<double> member_y;
+		/// Fitted ellipse
+		Group::Ellipse ellipse;
+		/// Motion of the group from the fitted members to the ones of the last frame
+		RigidMotion motion;
+	};
+
+	/**
+	 * @brief Returns the index of the entry continued by the group with the given ID and members or NONE
+	 *
+	 * @param claimed entries that cannot be continued (may be empty)
+	 */
+	size_t match(const std::string& name, const std::vector<Person>& members, const std::vector<bool>& claimed) const;
+
+	/**
+	 * @brief Derives the ellipse of @ref members from the one of @ref entry; returns FITTED if that is not possible
+	 *
+	 * @param motion output; motion of the group since the ellipse was fitted (if not FITTED)
+	 */
+	EllipseSource derive(
+		const Entry& entry,
+		const std::vector<Person>& members,
+		Group::Ellipse& ellipse,
+		RigidMotion& motion
+	) const;
+
+	/// Indexes entries by names of groups and members
+	void reindex();
+
+	Parameters params_;
+
+	std::vector<Entry> entries_;
+	/// Keys are views of names stored in @ref entries_
+	std::unordered_map<std::string_view, size_t> by_name_;
+	std::unordered_map<std::string_view, size_t> by_member_;
+};
+
+} // namespace people_msgs_utils
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <people_msgs_utils/frame.h>
+#include <people_msgs_utils/group.h>
+#include <people_msgs_utils/parallel.h>
+#include <people_msgs_utils/person.h>
+
+#include <people_msgs/Person.h>
+
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Disjoint-set forest (union-find) over elements 0, ..., count - 1
+ *
+ * Uses union by size and path compression, so a sequence of operations runs in nearly linear time
+ */
+class DisjointSets {
+public:
+	explicit DisjointSets(size_t count = 0);
+
+	/// Makes each of @ref count elements a separate set, reusing allocated memory
+	void reset(size_t count);
+
+	/// Returns the representative of the set containing @ref element
+	size_t find(size_t element);
+
+	/// Merges sets containing @ref a and @ref b; returns false if they were already in the same set
+	bool unite(size_t a, size_t b);
+
+	/// Returns the number of elements in the set containing @ref element
+	inline size_t getSize(size_t element) {
+		return sizes_[find(element)];
+	}
+
+	inline size_t size() const {
+		return parents_.size();
+	}
+
+protected:
+	std::vector<size_t> parents_;
+	std::vector<size_t> sizes_;
+};
+
+/**
+ * @brief Infers groups as connected components of people linked by social relations
+ *
+ * People are linked if they are assigned to the same group (Person::getGroupName) or if a relation between them
+ * has a strength of at least @ref threshold. Components with at least 2 people form groups with the spatial model
+ * computed as usual. A group is named after the group of its first assigned member (in the order of @ref people),
+ * or after the first member itself if none of the members is assigned to a group; such a name gets a suffix
+ * ("_1", "_2", ...) if it is also the name of another group. Relations between members are stored in the group.
+ *
+ * Runs in time linear in the number of people and relations (up to the inverse Ackermann function).
+ *
+ * @param people people to group; reassigned to the inferred groups (or to no group)
+ * @param relations relations as stored by Group: track ID, other track ID, strength; relations of unknown
+ * track IDs are ignored
+ * @param groups output; replaced with the inferred groups, in the order of their first members
+ */
+void groupByRelations(
+	People& people,
+	const std::vector<std::tuple<std::string, std::string, double>>& relations,
+	double threshold,
+	Groups& groups
+);
+
+/**
+ * @brief Overload of @ref groupByRelations with pairs of track IDs that are always linked
+ *
+ * @param links e.g., members of the same group reported by a tracker; links of unknown track IDs are ignored
+ * and links are not stored as relations of groups
+ */
+void groupByRelations(
+	People& people,
+	const std::vector<std::tuple<std::string, std::string, double>>& relations,
+	const std::vector<std::pair<std::string, std::string>>& links,
+	double threshold,
+	Groups& groups
+);
+
+/**
+ * @brief Alternative to @ref createFromPeople for trackers that do not publish group_id tags
+ *
+ * People are converted with @ref createPeople, and social relations and member lists (group_track_ids) are parsed
+ * directly from their tags to infer groups with @ref groupByRelations; people of the same member list are always
+ * linked. Groups given by group_id tags are not created (and fitted) beforehand, their members are linked only.
+ * The header of @ref frame is cleared.
+ *
+ * @param threshold the minimum strength of a relation linking people
+ */
+void createFromPeopleByRelations(
+	const std::vector<people_msgs::Person>& people,
+	Frame& frame,
+	double threshold = 0.5,
+	const ParallelFor& parallel_for = ParallelFor()
+);
+
+} // namespace people_msgs_utils
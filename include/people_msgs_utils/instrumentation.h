@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <string>
+#include <vector>
+
+/**
+ * Instrumentation of the conversion path is compiled in only if the library is built with
+ * PEOPLE_MSGS_UTILS_INSTRUMENTATION defined (see the CMake option of the same name).
+ * Otherwise, the recording macro expands to nothing, and the statistics stay empty.
+ */
+#ifdef PEOPLE_MSGS_UTILS_INSTRUMENTATION
+/// Records the enclosing scope
+#define PEOPLE_MSGS_UTILS_RECORD_SCOPE(stage, items) \
+	::people_msgs_utils::instrumentation::ScopedRecord people_msgs_utils_scoped_record(stage, items)
+/// Starts a record that is finished with @ref PEOPLE_MSGS_UTILS_RECORD_STOP (or at the end of the scope)
+#define PEOPLE_MSGS_UTILS_RECORD_START(name, stage) \
+	::people_msgs_utils::instrumentation::ScopedRecord name(stage, 0)
+#define PEOPLE_MSGS_UTILS_RECORD_STOP(name, items) name.stop(items)
+#else
+#define PEOPLE_MSGS_UTILS_RECORD_SCOPE(stage, items)
+#define PEOPLE_MSGS_UTILS_RECORD_START(name, stage)
+#define PEOPLE_MSGS_UTILS_RECORD_STOP(name, items)
+#endif
+
+namespace people_msgs_utils {
+namespace instrumentation {
+
+/// Instrumented parts of the library
+enum class Stage {
+	/// Stage 1 of createFromPeople: construction of Person instances with tag parsing
+	PARSE_PEOPLE = 0,
+	/// Stages 2 and 3 of createFromPeople: collecting group IDs and members
+	COLLECT_GROUPS,
+	/// Stages 4 and 5 of createFromPeople: construction and cleaning of groups
+	CREATE_GROUPS,
+	/// The whole createFromPeople call
+	CREATE_FROM_PEOPLE,
+	/// Group::computeSpatialModel
+	SPATIAL_MODEL,
+	/// Ellipse fitting within Group::computeSpatialModel
+	ELLIPSE_FITTING,
+	/// Person::transform
+	TRANSFORM_PERSON,
+	/// Group::transform
+	TRANSFORM_GROUP,
+	/// Number of stages
+	COUNT
+};
+
+/// Summary of the records of a single stage
+struct StageStatistics {
+	unsigned long int calls = 0;
+	/// Number of processed items (e.g., people or groups)
+	unsigned long int items = 0;
+	/// Number of calls that ended with an exception (e.g., caused by malformed tags)
+	unsigned long int errors = 0;
+	/// Wall times in seconds; percentiles are estimated from a log-scale histogram (~19% resolution)
+	double time_total = 0.0;
+	double time_p50 = 0.0;
+	double time_p99 = 0.0;
+	double time_max = 0.0;
+};
+
+/// Bucket of the latency histogram of a stage
+struct HistogramBucket {
+	/// Upper bound of the bucket's range in seconds
+	double upper_bound = 0.0;
+	unsigned long int count = 0;
+};
+
+/// Function called for each record; it may be called concurrently from multiple threads
+typedef void (*RecordCallback)(Stage stage, double seconds, size_t items, bool error);
+
+/// Returns true if the library was compiled with instrumentation
+bool isEnabled();
+
+/// Sets a function that is called for each record (nullptr disables the callback)
+void setCallback(RecordCallback callback);
+
+/// Adds a record of a stage; thread-safe
+void record(Stage stage, std::chrono::nanoseconds duration, size_t items, bool error);
+
+/**
+ * @brief Returns statistics of a @ref stage collected since the start or the last reset
+ *
+ * Resetting on each read turns the statistics into a rolling window defined by the reading period
+ */
+StageStatistics getStatistics(Stage stage, bool reset = false);
+
+/// Returns non-empty buckets of the latency histogram of a @ref stage, in ascending order
+std::vector<HistogramBucket> getHistogram(Stage stage);
+
+/// Clears statistics of all stages
+void reset();
+
+/// Returns name of the stage
+std::string toString(Stage stage);
+
+/// Exports statistics of all stages as CSV (with header)
+std::string exportCsv();
+
+/// Records wall time of the enclosing scope; marks an error if the scope is left due to an exception
+class ScopedRecord {
+public:
+	ScopedRecord(Stage stage, size_t items):
+		stage_(stage),
+		items_(items),
+		exceptions_(std::uncaught_exceptions()),
+		start_(std::chrono::steady_clock::now())
+	{}
+
+	~ScopedRecord() {
+		if (!stopped_) {
+			finish(std::uncaught_exceptions() > exceptions_);
+		}
+	}
+
+	/// Finishes the record before leaving the scope, updating the number of processed items
+	void stop(size_t items) {
+		items_ = items;
+		stopped_ = true;
+		finish(false);
+	}
+
+protected:
+	void finish(bool error) {
+		record(
+			stage_,
+			std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_),
+			items_,
+			error
+		);
+	}
+
+	Stage stage_;
+	size_t items_;
+	bool stopped_ = false;
+	int exceptions_;
+	std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace instrumentation
+} // namespace people_msgs_utils
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <people_msgs_utils/group.h>
+#include <people_msgs_utils/parallel.h>
+#include <people_msgs_utils/people_arrays.h>
+#include <people_msgs_utils/person.h>
+#include <people_msgs_utils/prediction.h>
+#include <people_msgs_utils/social_cost.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Dense x-y-t occupancy of people and groups
+ *
+ * Slice k corresponds to the step k of the Prediction it was rasterized from, i.e., to the time (k + 1) * time_step.
+ * A cell is occupied if its center lies within any footprint.
+ */
+struct SpaceTimeOccupancy {
+	GridWindow grid;
+	double time_step = 0.0;
+	size_t num_steps = 0;
+	/// 1 if occupied, 0 otherwise; the cell (i, j) of the slice k is at (k * size_y + j) * size_x + i
+	std::vector<uint8_t> cells;
+
+	inline size_t index(size_t step, size_t i, size_t j) const {
+		return (step * grid.size_y + j) * grid.size_x + i;
+	}
+
+	inline bool isOccupied(size_t step, size_t i, size_t j) const {
+		return cells[index(step, i, j)] != 0;
+	}
+};
+
+/**
+ * @brief Sparse x-y-t occupancy of people and groups, suitable for large grids with only a few people
+ *
+ * Has the same meaning as SpaceTimeOccupancy, but only indices of occupied cells are stored
+ */
+struct SparseSpaceTimeOccupancy {
+	GridWindow grid;
+	double time_step = 0.0;
+	size_t num_steps = 0;
+	/// Occupied cells of the slice k are stored in [slice_start[k], slice_start[k + 1]) of @ref cells
+	std::vector<size_t> slice_start;
+	/// Indices (j * size_x + i) of occupied cells, sorted in ascending order within each slice
+	std::vector<size_t> cells;
+
+	bool isOccupied(size_t step, size_t i, size_t j) const;
+};
+
+/**
+ * @brief Dense x-y-t cost volume of people and groups
+ *
+ * Has the same layout as SpaceTimeOccupancy. The cost of a cell is 1 if its center lies within any footprint.
+ * Outside, it decays as a Gaussian of the distance from the nearest footprint's boundary, measured along the ray
+ * from the footprint's center (exact for discs of people), and drops to 0 beyond the cutoff
+ * (see OccupancyRasterizer::Parameters); overlapping footprints take the maximum.
+ */
+struct SpaceTimeCost {
+	GridWindow grid;
+	double time_step = 0.0;
+	size_t num_steps = 0;
+	/// Costs in [0, 1]; the cell (i, j) of the slice k is at (k * size_y + j) * size_x + i
+	std::vector<float> cells;
+
+	inline size_t index(size_t step, size_t i, size_t j) const {
+		return (step * grid.size_y + j) * grid.size_x + i;
+	}
+
+	inline float getCost(size_t step, size_t i, size_t j) const {
+		return cells[index(step, i, j)];
+	}
+};
+
+/**
+ * @brief Rasterizes predicted discs of people and O-space ellipses of groups into x-y-t occupancy grids or cost volumes
+ *
+ * Each footprint is rasterized row by row: the range of occupied cells within a row is computed analytically,
+ * so only cells inside the footprints' bounding boxes are touched. Time slices are independent,
+ * so they are processed concurrently by the given executor.
+ *
+ * Memory allocated by outputs and internal buffers is reused by subsequent calls.
+ */
+class OccupancyRasterizer {
+public:
+	struct Parameters {
+		/// Radius of a person's disc
+		double person_radius = 0.35;
+		/// Distance added to radii of people and semi-axes of groups, e.g., the radius of the robot
+		double inflation = 0.0;
+		/// Multiple of the predicted position standard deviation (the larger one of x and y) added to radii of people
+		double uncertainty_scale = 0.0;
+		/// Whether O-spaces of groups are rasterized
+		bool use_groups = true;
+		/// Standard deviation of the Gaussian decay of costs outside footprints; zero makes costs binary
+		double cost_falloff = 0.3;
+		/// Distance from footprints (in multiples of @ref cost_falloff) beyond which costs are zero
+		double cost_cutoff = 3.0;
+	};
+
+	/// Uses default parameters, time slices are processed sequentially
+	OccupancyRasterizer();
+
+	explicit OccupancyRasterizer(const Parameters& params, const ParallelFor& parallel_for = ParallelFor());
+
+	/// Rasterizes all steps of the @ref prediction into the dense @ref occupancy
+	void rasterize(const Prediction& prediction, const GridWindow& grid, SpaceTimeOccupancy& occupancy);
+
+	/// Rasterizes all steps of the @ref prediction into the sparse @ref occupancy
+	void rasterize(const Prediction& prediction, const GridWindow& grid, SparseSpaceTimeOccupancy& occupancy);
+
+	/// Rasterizes all steps of the @ref prediction into the dense @ref cost volume
+	void rasterize(const Prediction& prediction, const GridWindow& grid, SpaceTimeCost& cost);
+
+	/**
+	 * @brief Predicts the given frame with the @ref predictor and rasterizes the prediction
+	 *
+	 * @tparam OccupancyT SpaceTimeOccupancy, SparseSpaceTimeOccupancy or SpaceTimeCost
+	 */
+	template <typename OccupancyT>
+	void rasterize(
+		const People& people,
+		const Groups& groups,
+		const ConstantVelocityPredictor& predictor,
+		const GridWindow& grid,
+		OccupancyT& occupancy
+	) {
+		people_arrays_.assign(people);
+		predictor.predict(people_arrays_, groups, prediction_);
+		rasterize(prediction_, grid, occupancy);
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+	/// Returns the prediction computed by the last call of @ref rasterize taking a frame
+	inline const Prediction& getPrediction() const {
+		return prediction_;
+	}
+
+protected:
+	/// Disc of a person (a == b) or O-space ellipse of a group, inflated
+	struct Footprint {
+		double center_x = 0.0;
+		double center_y = 0.0;
+		double cos_yaw = 1.0;
+		double sin_yaw = 0.0;
+		/// Semi-axes
+		double a = 0.0;
+		double b = 0.0;
+	};
+
+	/**
+	 * @brief Calls `span(j, i_min, i_max, footprint)` for each row of the @ref grid overlapped by footprints
+	 * of the @ref step
+	 *
+	 * Footprints are grown, so spans cover all cells within the @ref margin from the footprint (measured along
+	 * rays from its center). Spans of different footprints may overlap
+	 */
+	template <typename SpanCallback>
+	void forEachSpan(
+		const Prediction& prediction,
+		const GridWindow& grid,
+		size_t step,
+		double margin,
+		const SpanCallback& span
+	) const;
+
+	Parameters params_;
+	ParallelFor parallel_for_;
+
+	PeopleArrays people_arrays_;
+	Prediction prediction_;
+	/// Occupied cells of each slice of the sparse occupancy before they are concatenated
+	std::vector<std::vector<size_t>> slices_;
+};
+
+} // namespace people_msgs_utils
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <people_msgs_utils/group.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief O-space ellipse of a group in a canonical form that is cheap to evaluate
+ *
+ * The ellipse is defined by the pose of the group and its spans (see Group::getSpanX and Group::getSpanY),
+ * which are full lengths of the axes.
+ */
+struct OSpaceEllipse {
+	double center_x;
+	double center_y;
+	double cos_yaw;
+	double sin_yaw;
+	/// Inverses of semi-axes
+	double inv_a;
+	double inv_b;
+	/// Axis-aligned bounding box
+	double min_x;
+	double min_y;
+	double max_x;
+	double max_y;
+	/// False if the spatial model of the group is degenerate (e.g., could not be computed)
+	bool valid;
+
+	static OSpaceEllipse fromGroup(const Group& group);
+
+	/**
+	 * @brief Returns the squared normalized distance of the point from the center of the ellipse
+	 *
+	 * The normalized distance is 1 at the boundary of the ellipse and scales linearly along each ray from the center
+	 */
+	inline double getNormalizedDistanceSq(double x, double y) const {
+		double dx = x - center_x;
+		double dy = y - center_y;
+		double u = (dx * cos_yaw + dy * sin_yaw) * inv_a;
+		double v = (-dx * sin_yaw + dy * cos_yaw) * inv_b;
+		return u * u + v * v;
+	}
+
+	/// Returns true if the point lies inside the ellipse (the boundary excluded)
+	inline bool contains(double x, double y) const {
+		return valid && getNormalizedDistanceSq(x, y) < 1.0;
+	}
+};
+
+/**
+ * @brief Tests batches of points (e.g., poses of candidate trajectories) against O-spaces of all groups
+ *
+ * Ellipses are converted into the canonical form once per frame (@ref setGroups). Points are processed in blocks;
+ * an ellipse is evaluated for a block only if its bounding box overlaps the bounding box of the block, and then
+ * with a branch-free loop that is vectorized by the compiler.
+ *
+ * Queries are const and may be called concurrently from multiple threads.
+ */
+class OSpaceQuery {
+public:
+	/// Returned as the index of the nearest group if there is none
+	static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+	/// Replaces the ellipses with the ones of the given @ref groups; degenerate ones never contain any point
+	void setGroups(const Groups& groups);
+
+	/**
+	 * @brief Marks points that are inside of any O-space
+	 *
+	 * @param xs, ys coordinates of @ref num points
+	 * @param inside output array of @ref num elements: 1 if the point is inside of any O-space, 0 otherwise
+	 */
+	void contains(const double* xs, const double* ys, size_t num, uint8_t* inside) const;
+
+	/// Returns true if any of the points is inside of any O-space; stops at the first block with such a point
+	bool containsAny(const double* xs, const double* ys, size_t num) const;
+
+	/**
+	 * @brief Computes the normalized ellipse distance (see OSpaceEllipse) of each point to the nearest O-space
+	 *
+	 * @param distances output array of @ref num elements; infinity if no O-space is closer than @ref max_distance
+	 * @param nearest optional output array of @ref num elements with indices of the nearest groups (or @ref NONE)
+	 * @param max_distance normalized distance beyond which ellipses are not considered; finite values allow
+	 * skipping ellipses whose (scaled) bounding boxes do not overlap the processed points
+	 */
+	void getNormalizedDistances(
+		const double* xs,
+		const double* ys,
+		size_t num,
+		double* distances,
+		size_t* nearest = nullptr,
+		double max_distance = std::numeric_limits<double>::infinity()
+	) const;
+
+	inline const std::vector<OSpaceEllipse>& getEllipses() const {
+		return ellipses_;
+	}
+
+protected:
+	std::vector<OSpaceEllipse> ellipses_;
+};
+
+} // namespace people_msgs_utils
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <functional>
+#include <thread>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Executor that runs `task(i)` for every index in [0, count) and returns once all tasks are finished
+ *
+ * Tasks are independent of each other and may run concurrently. This allows plugging in a thread pool
+ * of the caller, e.g.:
+ * @code
+ * ParallelFor parallel_for = [&pool](size_t count, const std::function<void(size_t)>& task) {
+ *     pool.parallel_for(0, count, task);
+ * };
+ * @endcode
+ */
+typedef std::function<void(size_t, const std::function<void(size_t)>&)> ParallelFor;
+
+/**
+ * @brief Creates an executor that splits indices into contiguous chunks, each processed by a separate std::thread
+ *
+ * Threads are spawned per call, so a caller-provided thread pool is preferred when available.
+ * Exceptions thrown by tasks are rethrown in the calling thread.
+ */
+ParallelFor createThreadParallelFor(unsigned int num_threads = std::thread::hardware_concurrency());
+
+/**
+ * @brief Runs `task(i)` for every index in [0, count) with @ref parallel_for, or sequentially if it is empty
+ *
+ * The task is passed to the executor by reference, so no heap allocation is needed to wrap it into std::function
+ */
+template <typename Task>
+void forEachIndex(size_t count, const Task& task, const ParallelFor& parallel_for) {
+	if (!parallel_for) {
+		for (size_t i = 0; i < count; i++) {
+			task(i);
+		}
+		return;
+	}
+	parallel_for(count, std::cref(task));
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <people_msgs_utils/person.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Planar state of all people of a frame stored as a structure of arrays
+ *
+ * Extracted once per frame, so batch computations iterate over contiguous arrays (which the compiler can vectorize)
+ * instead of calling getters (some of which copy messages or compute the yaw) of each Person.
+ */
+struct PeopleArrays {
+	std::vector<double> x;
+	std::vector<double> y;
+	std::vector<double> yaw;
+	std::vector<double> vx;
+	std::vector<double> vy;
+	/// Pose covariance (x, y)
+	std::vector<double> cov_xx;
+	std::vector<double> cov_xy;
+	std::vector<double> cov_yy;
+	/// Velocity covariance (x, y)
+	std::vector<double> vel_cov_xx;
+	std::vector<double> vel_cov_xy;
+	std::vector<double> vel_cov_yy;
+	/// Lower-triangular Cholesky factor L of the pose covariance (x, y), i.e., covariance = L * L^T
+	std::vector<double> cov_chol_xx;
+	std::vector<double> cov_chol_yx;
+	std::vector<double> cov_chol_yy;
+	/// Inverse of the pose covariance (x, y)
+	std::vector<double> cov_inv_xx;
+	std::vector<double> cov_inv_xy;
+	std::vector<double> cov_inv_yy;
+
+	/// Variances are raised to at least this value, so factors and inverses exist even without covariance data
+	static constexpr double MIN_VARIANCE = 1e-6;
+
+	/// Replaces contents with the data of the given @ref people, reusing allocated memory
+	void assign(const People& people);
+
+	/**
+	 * @brief Computes Cholesky factors and inverses of pose covariances from cov_xx, cov_xy and cov_yy
+	 *
+	 * Called by @ref assign; must be called explicitly if the covariances are filled or modified otherwise.
+	 * Covariances that are not positive definite are regularized with MIN_VARIANCE.
+	 */
+	void computeCovarianceFactors();
+
+	inline size_t size() const {
+		return x.size();
+	}
+};
+
+} // namespace people_msgs_utils
@@ -6,8 +6,10 @@
 #include <tf2/utils.h>
 
 #include <array>
+#include <cmath>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <vector>
 
@@ -42,6 +44,20 @@ public:
 		const std::vector<std::string>& tags
 	);
 
+	/**
+	 * @brief Constructor from non-owning people_msgs/Person contents, e.g., views into a serialized message
+	 *
+	 * Tags are parsed directly from the views, without intermediate string copies
+	 */
+	Person(
+		std::string_view name,
+		const geometry_msgs::Point& position,
+		const geometry_msgs::Point& velocity,
+		const double& reliability,
+		const std::vector<std::string_view>& tagnames,
+		const std::vector<std::string_view>& tags
+	);
+
 	/**
 	 * @brief Constructor with all attributes given explicitly
 	 */
@@ -57,6 +73,23 @@ public:
 		const std::string& group_name
 	);
 
+	/**
+	 * @brief Reinitializes the instance from people_msgs/Person contents, as the constructor would do
+	 *
+	 * Reuses memory already allocated by the instance (e.g., for strings)
+	 *
+	 * @tparam StringT std::string or std::string_view (explicitly instantiated in the source file)
+	 */
+	template <typename StringT>
+	void assign(
+		std::string_view name,
+		const geometry_msgs::Point& position,
+		const geometry_msgs::Point& velocity,
+		const double& reliability,
+		const std::vector<StringT>& tagnames,
+		const std::vector<StringT>& tags
+	);
+
 	/**
 	 * @brief Transforms person pose and velocity according to given @ref transform
 	 *
@@ -67,7 +100,41 @@ public:
 	 */
 	void transform(const geometry_msgs::TransformStamped& transform);
 
-	inline std::string getName() const {
+	/**
+	 * @brief Overwrites planar position, orientation (yaw) and velocity, e.g., with interpolated or predicted ones
+	 *
+	 * Other attributes (including the vertical coordinate and covariances) are kept
+	 */
+	void setPlanarState(double x, double y, double yaw, double vx, double vy);
+
+	/// Rotates planar (x, y) blocks of the pose and velocity covariances by @ref yaw, e.g., along with the state
+	void rotateCovariances(double yaw);
+
+	/// Rotates the planar (x, y) block of the 6x6 covariance matrix by @ref yaw: R * cov * R^T
+	template <typename CovarianceT>
+	static void rotatePlanarCovariance(CovarianceT& cov, double yaw) {
+		double c = std::cos(yaw);
+		double s = std::sin(yaw);
+		double xx = cov[COV_XX_INDEX];
+		double xy = cov[COV_XY_INDEX];
+		double yy = cov[COV_YY_INDEX];
+		cov[COV_XX_INDEX] = c * c * xx - 2.0 * c * s * xy + s * s * yy;
+		cov[COV_YY_INDEX] = s * s * xx + 2.0 * c * s * xy + c * c * yy;
+		cov[COV_XY_INDEX] = c * s * (xx - yy) + (c * c - s * s) * xy;
+		cov[COV_YX_INDEX] = cov[COV_XY_INDEX];
+	}
+
+	/// Overwrites the ID of the person, e.g., to resolve conflicts of IDs from multiple trackers
+	inline void setName(const std::string& name) {
+		name_ = name;
+	}
+
+	/// Assigns the person to the group with the given ID; empty ID means no group
+	inline void setGroupName(const std::string& group_name) {
+		group_id_ = group_name;
+	}
+
+	inline const std::string& getName() const {
 		return name_;
 	}
 
@@ -200,7 +267,7 @@ public:
 	/**
 	 * Retrieves ID of the group that person is assigned to
 	 */
-	inline std::string getGroupName() const {
+	inline const std::string& getGroupName() const {
 		return group_id_;
 	}
 
@@ -209,8 +276,11 @@ protected:
 	 * @brief Returns true if tagnames and tags are valid, no matter if expected data were found inside
 	 *
 	 * This method parses only person-specific tags
+	 *
+	 * @tparam StringT std::string or std::string_view (explicitly instantiated in the source file)
 	 */
-	bool parseTags(const std::vector<std::string>& tagnames, const std::vector<std::string>& tags);
+	template <typename StringT>
+	bool parseTags(const std::vector<StringT>& tagnames, const std::vector<StringT>& tags);
 
 	/// Person ID (number) is treated as name
 	std::string name_;
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <geometry_msgs/Point.h>
+
+#include <string_view>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Non-owning counterpart of people_msgs/Person
+ *
+ * Strings are views into an externally owned buffer (e.g., serialized message bytes), hence an instance
+ * must not outlive that buffer
+ */
+struct PersonView {
+	std::string_view name;
+	geometry_msgs::Point position;
+	geometry_msgs::Point velocity;
+	double reliability;
+	std::vector<std::string_view> tagnames;
+	std::vector<std::string_view> tags;
+};
+
+} // namespace people_msgs_utils
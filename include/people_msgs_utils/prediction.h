@@ -0,0 +1,93 @@
+#pragma once
+
+#include <people_msgs_utils/group.h>
+#include <people_msgs_utils/ospace.h>
+#include <people_msgs_utils/people_arrays.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Predicted planar states of all people (and O-spaces of groups) of a frame at future timesteps
+ *
+ * States are stored in contiguous arrays of num_steps * num_people elements, ordered according to the @ref layout;
+ * use @ref index to access them. Step k corresponds to the time (k + 1) * time_step from the frame.
+ */
+struct Prediction {
+	enum class Layout {
+		/// All people of a step are stored together, i.e., at step * num_people + person
+		TIME_MAJOR = 0,
+		/// All steps of a person are stored together, i.e., at person * num_steps + step
+		PERSON_MAJOR
+	};
+
+	Layout layout = Layout::TIME_MAJOR;
+	double time_step = 0.0;
+	size_t num_steps = 0;
+	size_t num_people = 0;
+	size_t num_groups = 0;
+
+	std::vector<double> x;
+	std::vector<double> y;
+	/// Position covariance (x, y)
+	std::vector<double> cov_xx;
+	std::vector<double> cov_xy;
+	std::vector<double> cov_yy;
+	/// O-space ellipses of groups; always time-major, i.e., at step * num_groups + group
+	std::vector<OSpaceEllipse> group_ellipses;
+
+	inline size_t index(size_t step, size_t person) const {
+		return layout == Layout::TIME_MAJOR ? step * num_people + person : person * num_steps + step;
+	}
+
+	inline double getTime(size_t step) const {
+		return static_cast<double>(step + 1) * time_step;
+	}
+};
+
+/**
+ * @brief Propagates people of a frame with constant velocities over a time horizon
+ *
+ * Predicted position covariance at time t is: pose covariance + t^2 * velocity covariance
+ * + acceleration_noise * t^3 / 3 (random walk of the velocity) on the diagonal.
+ *
+ * Groups are moved rigidly with the mean velocity of their members, i.e., their O-space ellipses
+ * are translated while their shapes and orientations are kept.
+ *
+ * Each step is computed for blocks of people with a loop that is vectorized by the compiler (with -O3,
+ * e.g., in the Release build type). Outputs reuse the memory allocated by previous predictions.
+ */
+class ConstantVelocityPredictor {
+public:
+	struct Parameters {
+		/// Time between consecutive steps [s]
+		double time_step = 0.1;
+		/// Number of predicted steps
+		size_t steps = 10;
+		Prediction::Layout layout = Prediction::Layout::TIME_MAJOR;
+		/// Spectral density of the white-noise acceleration [m^2/s^3]; zero keeps the velocity deterministic
+		double acceleration_noise = 0.0;
+	};
+
+	/// Uses default parameters
+	ConstantVelocityPredictor();
+
+	explicit ConstantVelocityPredictor(const Parameters& params);
+
+	/// Predicts states of @ref people; @ref prediction will not contain any group ellipses
+	void predict(const PeopleArrays& people, Prediction& prediction) const;
+
+	/// Predicts states of @ref people and O-spaces of @ref groups
+	void predict(const PeopleArrays& people, const Groups& groups, Prediction& prediction) const;
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	Parameters params_;
+};
+
+} // namespace people_msgs_utils
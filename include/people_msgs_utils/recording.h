@@ -0,0 +1,260 @@
+#pragma once
+
+#include <people_msgs_utils/frame.h>
+
+#include <ros/time.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Read-only view of a frame stored in a FrameRecording
+ *
+ * Arrays point directly into the memory-mapped file and stay valid as long as the recording exists.
+ * IDs are stored as indices into the string table of the recording.
+ *
+ * Positions are delta-encoded (see FrameRecorder), so they are accessed through @ref getPositionX,
+ * @ref getPositionY or @ref decodePositions; other attributes are stored in single precision.
+ */
+struct RecordedFrameView {
+	/// Stored instead of an index (of a group, of a person in the keyframe) that does not exist
+	static constexpr uint32_t NONE = UINT32_MAX;
+
+	/// Bits of @ref flags
+	static constexpr uint8_t OCCLUDED = 1;
+	static constexpr uint8_t MATCHED = 2;
+
+	ros::Time stamp;
+	uint32_t seq = 0;
+	std::string_view frame_id;
+
+	size_t num_people = 0;
+	const uint32_t* name = nullptr;
+	const float* yaw = nullptr;
+	const float* vx = nullptr;
+	const float* vy = nullptr;
+	const float* cov_xx = nullptr;
+	const float* cov_xy = nullptr;
+	const float* cov_yy = nullptr;
+	const float* cov_yawyaw = nullptr;
+	const float* vel_cov_xx = nullptr;
+	const float* vel_cov_xy = nullptr;
+	const float* vel_cov_yy = nullptr;
+	const float* reliability = nullptr;
+	const uint8_t* flags = nullptr;
+	const uint32_t* detection_id = nullptr;
+	const uint64_t* track_age = nullptr;
+	/// Index of the group of each person or NONE
+	const uint32_t* group = nullptr;
+
+	size_t num_groups = 0;
+	const uint32_t* group_name = nullptr;
+	const uint64_t* group_age = nullptr;
+	const double* group_cog_x = nullptr;
+	const double* group_cog_y = nullptr;
+	/// Ellipses of the spatial models of groups
+	const double* group_x = nullptr;
+	const double* group_y = nullptr;
+	const double* group_yaw = nullptr;
+	const double* group_span_x = nullptr;
+	const double* group_span_y = nullptr;
+	/// Members of group g are group_members[group_member_start[g]], ..., group_members[group_member_start[g + 1] - 1]
+	const uint32_t* group_member_start = nullptr;
+	const uint32_t* group_members = nullptr;
+	/// Relations of group g are stored at group_relation_start[g], ..., group_relation_start[g + 1] - 1
+	const uint32_t* group_relation_start = nullptr;
+	/// IDs of related people
+	const uint32_t* relation_a = nullptr;
+	const uint32_t* relation_b = nullptr;
+	const float* relation_strength = nullptr;
+
+	double getPositionX(size_t person) const;
+	double getPositionY(size_t person) const;
+
+	/// Decodes positions of all people at once; outputs are resized
+	void decodePositions(std::vector<double>& x, std::vector<double>& y) const;
+
+	std::string_view getString(uint32_t id) const;
+
+	inline std::string_view getName(size_t person) const {
+		return getString(name[person]);
+	}
+
+	inline std::string_view getGroupName(size_t group) const {
+		return getString(group_name[group]);
+	}
+
+	/// Encoded positions, see FrameRecorder
+	double resolution = 0.0;
+	double anchor_x = 0.0;
+	double anchor_y = 0.0;
+	/// Index of the person in the keyframe each position is relative to, NONE if relative to the anchor
+	const uint32_t* reference = nullptr;
+	const void* position_x = nullptr;
+	const void* position_y = nullptr;
+	uint32_t position_bytes = 0;
+	double key_anchor_x = 0.0;
+	double key_anchor_y = 0.0;
+	const void* key_position_x = nullptr;
+	const void* key_position_y = nullptr;
+	uint32_t key_position_bytes = 0;
+	/// String table of the recording
+	const uint32_t* string_offsets = nullptr;
+	const char* string_chars = nullptr;
+};
+
+/**
+ * @brief Writes converted frames (people, groups, relations, spatial models, timestamps) into a compact binary file
+ * that FrameRecording replays without parsing or conversion
+ *
+ * Each frame is stored as a record of columns, IDs are interned in a string table and an index of records
+ * is appended when the recorder is closed.
+ *
+ * Positions are quantized to Parameters::position_resolution and delta-encoded: every
+ * Parameters::keyframe_interval-th frame is a keyframe storing positions relative to its mean position
+ * (the anchor); other frames store positions relative to the same person in their keyframe (or relative
+ * to their own anchor for people not present in the keyframe). Deltas are stored in 16 bits whenever all
+ * of them fit, so random access needs at most the frame and its keyframe.
+ *
+ * Other attributes are stored in single precision; only the planar part of covariances is kept.
+ * Ellipses of groups are stored as they are, so replayed groups are not refitted.
+ */
+class FrameRecorder {
+public:
+	struct Parameters {
+		size_t keyframe_interval = 32;
+		/// Quantization step of positions [m]
+		double position_resolution = 1e-3;
+	};
+
+	/**
+	 * @throw std::runtime_error if the file cannot be created
+	 */
+	FrameRecorder(const std::string& path, const Parameters& params);
+
+	explicit FrameRecorder(const std::string& path);
+
+	/// Closes the recording, see @ref close
+	~FrameRecorder();
+
+	FrameRecorder(const FrameRecorder&) = delete;
+	FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+	/**
+	 * @brief Appends the frame; stamps are expected not to decrease (see FrameRecording::findFrame)
+	 *
+	 * @throw std::invalid_argument if a position is not finite or is too far from the others to be quantized
+	 * (2^52 steps of Parameters::position_resolution)
+	 * @throw std::runtime_error if writing fails
+	 */
+	void record(const Frame& frame);
+
+	/**
+	 * @brief Writes the string table and the index; the file is not readable before
+	 *
+	 * Further calls have no effect
+	 */
+	void close();
+
+	/// Returns the number of recorded frames
+	inline size_t size() const {
+		return index_.size();
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	/// Returns the ID of the string in the string table
+	uint32_t intern(const std::string& str);
+
+	/// Location of a record in the file
+	struct IndexEntry {
+		uint64_t offset;
+		uint32_t stamp_sec;
+		uint32_t stamp_nsec;
+	};
+
+	Parameters params_;
+	std::ofstream file_;
+	uint64_t offset_;
+
+	std::vector<IndexEntry> index_;
+	std::vector<std::string> strings_;
+	std::unordered_map<std::string, uint32_t> string_ids_;
+
+	/// Number of the last keyframe, its quantized positions and indices of its people by IDs
+	uint64_t keyframe_;
+	double key_anchor_x_;
+	double key_anchor_y_;
+	std::vector<int64_t> key_x_;
+	std::vector<int64_t> key_y_;
+	std::unordered_map<uint32_t, uint32_t> key_people_;
+
+	std::vector<char> buffer_;
+	std::vector<uint32_t> names_;
+	std::vector<uint32_t> references_;
+	std::vector<int64_t> values_x_;
+	std::vector<int64_t> values_y_;
+	std::unordered_map<std::string_view, uint32_t> group_index_;
+	std::unordered_map<std::string_view, uint32_t> person_index_;
+};
+
+/**
+ * @brief Memory-maps a file written by FrameRecorder and provides random access to its frames by number or time
+ *
+ * Views of frames are created without parsing; @ref read converts a frame back to a Frame when needed.
+ */
+class FrameRecording {
+public:
+	/**
+	 * @throw std::runtime_error if the file cannot be mapped or is not a complete recording
+	 */
+	explicit FrameRecording(const std::string& path);
+
+	~FrameRecording();
+
+	FrameRecording(const FrameRecording&) = delete;
+	FrameRecording& operator=(const FrameRecording&) = delete;
+
+	/// Returns the number of frames
+	size_t size() const;
+
+	ros::Time getStamp(size_t frame) const;
+
+	/// Returns the first frame stamped at or after @ref stamp, @ref size if there is none
+	size_t findFrame(const ros::Time& stamp) const;
+
+	/**
+	 * @brief Returns a view of the frame
+	 *
+	 * Locations and indices stored in the frame and its keyframe are validated first, so the view
+	 * does not point outside of the file.
+	 *
+	 * @throw std::out_of_range if the frame does not exist
+	 * @throw std::runtime_error if the frame is corrupt
+	 */
+	RecordedFrameView getFrame(size_t frame) const;
+
+	/**
+	 * @brief Converts the frame into @ref output (replaced)
+	 *
+	 * @throw std::out_of_range if the frame does not exist
+	 * @throw std::runtime_error if the frame is corrupt
+	 */
+	void read(size_t frame, Frame& output) const;
+
+protected:
+	const char* memory_;
+	size_t size_;
+};
+
+} // namespace people_msgs_utils
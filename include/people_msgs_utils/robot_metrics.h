@@ -0,0 +1,82 @@
+#pragma once
+
+#include <people_msgs_utils/people_arrays.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/// Planar state of the robot expressed in the frame of people
+struct RobotState {
+	double x = 0.0;
+	double y = 0.0;
+	double yaw = 0.0;
+	/// Velocity expressed in the frame of people (not in the robot's local frame)
+	double vx = 0.0;
+	double vy = 0.0;
+};
+
+/**
+ * @brief Metrics of people relative to the robot, one element per person in each array
+ *
+ * Motion of both the robot and people is extrapolated with constant velocities
+ */
+struct RobotRelativeMetrics {
+	/// Distance between the robot and the person
+	std::vector<double> distance;
+	/// Direction towards the person in the robot's local frame, within [-pi, pi]
+	std::vector<double> bearing;
+	/// Velocity of the person relative to the robot, expressed in the frame of people
+	std::vector<double> relative_vx;
+	std::vector<double> relative_vy;
+	/// Distance at the time of the closest approach (current distance if they are moving apart)
+	std::vector<double> closest_approach_distance;
+	/// Time until the closest approach (zero if they are moving apart)
+	std::vector<double> closest_approach_time;
+	/// Time until the distance drops to the collision distance; zero if already closer, infinity if never
+	std::vector<double> time_to_collision;
+
+	inline size_t size() const {
+		return distance.size();
+	}
+};
+
+/// Metric used to rank people by how critical they are to the robot
+enum class CriticalityCriterion {
+	DISTANCE = 0,
+	CLOSEST_APPROACH_DISTANCE,
+	TIME_TO_COLLISION
+};
+
+/**
+ * @brief Computes metrics of all @ref people relative to the @ref robot in a single pass
+ *
+ * The main loop is branch-free, so it is vectorized by the compiler; bearings are computed in a separate loop
+ *
+ * @param collision_distance distance between the robot and a person that is considered a collision
+ * (e.g., sum of their radii)
+ * @param metrics output; arrays are resized to the number of people, reusing allocated memory
+ */
+void computeRobotRelativeMetrics(
+	const RobotState& robot,
+	const PeopleArrays& people,
+	double collision_distance,
+	RobotRelativeMetrics& metrics
+);
+
+/**
+ * @brief Selects (at most) @ref k people with the lowest values of the @ref criterion
+ *
+ * Only the selected part is sorted (partial sort), so selecting a few people out of a crowd is cheap
+ *
+ * @param indices output; indices of people sorted by increasing value of the criterion (ties by index)
+ */
+void selectMostCritical(
+	const RobotRelativeMetrics& metrics,
+	size_t k,
+	CriticalityCriterion criterion,
+	std::vector<size_t>& indices
+);
+
+} // namespace people_msgs_utils
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <people_msgs_utils/group.h>
+#include <people_msgs_utils/person.h>
+#include <people_msgs_utils/person_view.h>
+
+#include <ros/serialized_message.h>
+#include <ros/time.h>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Non-owning counterpart of people_msgs/People
+ *
+ * All strings are views into the buffer passed to @ref decodePeople
+ */
+struct PeopleView {
+	uint32_t seq;
+	ros::Time stamp;
+	std::string_view frame_id;
+	std::vector<PersonView> people;
+};
+
+/**
+ * @brief Walks the ROS1 serialized byte buffer of people_msgs/People and fills @ref view
+ *
+ * @param buffer beginning of the message payload (without the 4-byte length prefix of a ros::SerializedMessage)
+ * @param length number of bytes of the payload
+ * @param view output; capacities of its containers are reused if it was already filled by a previous call
+ *
+ * @return false if the buffer is truncated or malformed; @ref view is unspecified then
+ */
+bool decodePeople(const uint8_t* buffer, size_t length, PeopleView& view);
+
+/**
+ * @brief Creates People and Groups straight from the serialized people_msgs/People bytes
+ *
+ * Avoids deserializing into people_msgs::People and copying it again in @ref createFromPeople
+ *
+ * @return empty sets if the buffer could not be decoded
+ */
+std::pair<std::vector<Person>, std::vector<Group>> createFromSerializedPeople(const uint8_t* buffer, size_t length);
+
+/**
+ * @brief Overload that accepts a message obtained, e.g., from ros::serialization::serializeMessage
+ */
+std::pair<std::vector<Person>, std::vector<Group>> createFromSerializedPeople(const ros::SerializedMessage& msg);
+
+} // namespace people_msgs_utils
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <people_msgs_utils/frame.h>
+#include <people_msgs_utils/people_arrays.h>
+
+#include <ros/time.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Read-only view of a frame stored in shared memory by SharedFrameWriter
+ *
+ * Arrays point directly into the shared memory: people and groups are stored as structures of arrays and IDs
+ * are interned in a string pool, so no deserialization or conversion takes place. Groups reference their members
+ * by indices of people (CSR layout), people reference their groups by indices as well.
+ *
+ * The writer reuses the memory of a frame once it has published SharedFrameWriter::Parameters::slots newer frames.
+ * Data read from the view are consistent only if @ref isValid returns true after they were read.
+ */
+struct SharedFrameView {
+	/// Returned as the group index of people not assigned to any group
+	static constexpr uint32_t NO_GROUP = UINT32_MAX;
+
+	/// Number of the frame, increasing by one with each published frame (starting from 1)
+	uint64_t number = 0;
+	ros::Time stamp;
+	uint32_t seq = 0;
+	std::string_view frame_id;
+
+	size_t num_people = 0;
+	const double* x = nullptr;
+	const double* y = nullptr;
+	const double* yaw = nullptr;
+	const double* vx = nullptr;
+	const double* vy = nullptr;
+	const double* cov_xx = nullptr;
+	const double* cov_xy = nullptr;
+	const double* cov_yy = nullptr;
+	const double* reliability = nullptr;
+	/// Index of the group of each person or NO_GROUP
+	const uint32_t* group = nullptr;
+
+	size_t num_groups = 0;
+	/// Ellipses of the spatial models of groups
+	const double* group_x = nullptr;
+	const double* group_y = nullptr;
+	const double* group_yaw = nullptr;
+	const double* group_span_x = nullptr;
+	const double* group_span_y = nullptr;
+	/// Members of group g are group_members[group_member_start[g]], ..., group_members[group_member_start[g + 1] - 1]
+	const uint32_t* group_member_start = nullptr;
+	const uint32_t* group_members = nullptr;
+
+	/// Returns the ID of the person
+	std::string_view getName(size_t person) const;
+
+	/// Returns the ID of the group
+	std::string_view getGroupName(size_t group) const;
+
+	/// Returns true if the frame has not been overwritten by the writer (yet)
+	bool isValid() const;
+
+	/// String pool and locations of IDs in it
+	const char* strings = nullptr;
+	const uint32_t* name_offset = nullptr;
+	const uint32_t* name_length = nullptr;
+	const uint32_t* group_name_offset = nullptr;
+	const uint32_t* group_name_length = nullptr;
+	/// Sequence counter of the slot and its value when the view was created
+	const std::atomic<uint64_t>* slot_sequence = nullptr;
+	uint64_t expected_sequence = 0;
+};
+
+/**
+ * @brief Publishes converted frames into a POSIX shared-memory ring buffer, so multiple processes on the same host
+ * can use them without subscribing to the topic and converting messages themselves
+ *
+ * The segment consists of a header and Parameters::slots slots of fixed capacity. Each slot is guarded
+ * by a sequence counter (seqlock), so publishing never blocks on readers and readers never block the writer.
+ * There must be only one writer of a segment.
+ *
+ * The segment is created (or replaced) by the constructor and removed by the destructor; processes that
+ * have it mapped may keep using it.
+ */
+class SharedFrameWriter {
+public:
+	struct Parameters {
+		/// Number of frames kept in the ring buffer
+		size_t slots = 4;
+		/// Capacities of each slot
+		size_t max_people = 1024;
+		size_t max_groups = 256;
+		size_t max_string_bytes = 64 * 1024;
+	};
+
+	/**
+	 * @param name name of the shared-memory object, e.g., "/people"
+	 *
+	 * @throw std::runtime_error if the segment cannot be created
+	 */
+	SharedFrameWriter(const std::string& name, const Parameters& params);
+
+	explicit SharedFrameWriter(const std::string& name);
+
+	~SharedFrameWriter();
+
+	SharedFrameWriter(const SharedFrameWriter&) = delete;
+	SharedFrameWriter& operator=(const SharedFrameWriter&) = delete;
+
+	/**
+	 * @brief Stores the frame in the next slot and makes it the latest one
+	 *
+	 * @return false if the frame exceeds capacities of a slot (nothing is published then)
+	 */
+	bool publish(const Frame& frame);
+
+	/// Returns the number of published frames
+	inline uint64_t getPublishedCount() const {
+		return published_;
+	}
+
+	inline const std::string& getName() const {
+		return name_;
+	}
+
+protected:
+	std::string name_;
+	void* memory_;
+	size_t size_;
+	uint64_t published_;
+
+	PeopleArrays arrays_;
+	std::unordered_map<std::string_view, uint32_t> person_index_;
+	std::unordered_map<std::string_view, uint32_t> group_index_;
+};
+
+/**
+ * @brief Maps a segment of SharedFrameWriter read-only and provides views of its frames
+ *
+ * The reader may be created only after the writer has created the segment
+ */
+class SharedFrameReader {
+public:
+	/**
+	 * @param name name of the shared-memory object given to the writer
+	 *
+	 * @throw std::runtime_error if the segment does not exist or is not a valid segment of frames
+	 */
+	explicit SharedFrameReader(const std::string& name);
+
+	~SharedFrameReader();
+
+	SharedFrameReader(const SharedFrameReader&) = delete;
+	SharedFrameReader& operator=(const SharedFrameReader&) = delete;
+
+	/**
+	 * @brief Creates a view of the latest frame
+	 *
+	 * @return false if no frame has been published yet
+	 */
+	bool getLatest(SharedFrameView& view) const;
+
+	/// Returns the number of the latest frame (0 if none has been published)
+	uint64_t getLatestNumber() const;
+
+protected:
+	const void* memory_;
+	size_t size_;
+};
+
+} // namespace people_msgs_utils
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <people_msgs_utils/group.h>
+#include <people_msgs_utils/person.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Rectangular window of a grid, e.g., of a costmap
+ *
+ * Costs are evaluated at cell centers, i.e., at origin + (index + 0.5) * resolution (as in costmap_2d::mapToWorld)
+ */
+struct GridWindow {
+	double origin_x = 0.0;
+	double origin_y = 0.0;
+	double resolution = 0.05;
+	size_t size_x = 0;
+	size_t size_y = 0;
+};
+
+/**
+ * @brief Evaluates Gaussian social costs of people and groups over grids and point sets in batches
+ *
+ * Each person contributes an isotropic Gaussian (optionally widened with the person's pose covariance).
+ * Each group contributes a Gaussian shaped as its O-space ellipse: the standard deviations along the axes
+ * are proportional to semi-axes given by Group::getSpanX and Group::getSpanY.
+ *
+ * Gaussians are cut off at the given Mahalanobis distance, so only cells within their bounding boxes are visited.
+ * Inner loops are branch-free and use a vectorizable exponential, so they are turned into SIMD code
+ * by the compiler (with -O3, e.g., in the Release build type); throughput of grid evaluation is reported
+ * (in cells/second) by the benchmarks.
+ */
+class SocialCostModel {
+public:
+	/// Method of combining costs of multiple Gaussians
+	enum class Reduction {
+		SUM = 0,
+		MAX
+	};
+
+	struct Parameters {
+		/// Peak cost of a person (non-negative)
+		double person_amplitude = 1.0;
+		/// Standard deviation of a person's Gaussian
+		double person_sigma = 0.5;
+		/// Peak cost of a group (non-negative)
+		double group_amplitude = 1.0;
+		/// Ratio between a standard deviation and the corresponding semi-axis of a group's ellipse
+		double group_sigma_scale = 1.0;
+		/// Mahalanobis distance beyond which the cost of a Gaussian is zero (at most 36)
+		double cutoff = 3.0;
+		/// Whether pose covariances (x, y) of people and groups are added to the nominal shapes
+		bool use_covariance = false;
+		Reduction reduction = Reduction::SUM;
+	};
+
+	/// Uses default parameters
+	SocialCostModel();
+
+	explicit SocialCostModel(const Parameters& params);
+
+	/**
+	 * @brief Prepares Gaussians of the given people and groups for evaluation; replaces the previous ones
+	 *
+	 * People and groups are not referenced afterwards
+	 */
+	void setFrame(const People& people, const Groups& groups = Groups());
+
+	/**
+	 * @brief Evaluates costs at centers of cells of the @ref grid
+	 *
+	 * @param costs resized to size_x * size_y; row-major, i.e., the cost of cell (i, j) is at j * size_x + i
+	 */
+	void evaluateGrid(const GridWindow& grid, std::vector<double>& costs) const;
+
+	/**
+	 * @brief Evaluates costs at the given points
+	 *
+	 * @param xs, ys coordinates of @ref num points
+	 * @param costs output array of @ref num elements
+	 */
+	void evaluatePoints(const double* xs, const double* ys, size_t num, double* costs) const;
+
+	/// Evaluates cost at the given point; prefer the batch versions for multiple points
+	double evaluate(double x, double y) const;
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+	/// Number of Gaussians prepared by @ref setFrame (degenerate ones are skipped)
+	inline size_t getGaussiansCount() const {
+		return gaussians_.size();
+	}
+
+protected:
+	/// Gaussian in a form that is cheap to evaluate
+	struct Gaussian {
+		double center_x;
+		double center_y;
+		double amplitude;
+		/// Elements of the inverse covariance matrix: [a b; b c]
+		double a;
+		double b;
+		double c;
+		/// Axis-aligned bounding box of the cut-off region
+		double min_x;
+		double min_y;
+		double max_x;
+		double max_y;
+	};
+
+	/// Adds a Gaussian with the given covariance, unless the covariance is not positive definite
+	void addGaussian(double x, double y, double amplitude, double sxx, double sxy, double syy);
+
+	Parameters params_;
+	std::vector<Gaussian> gaussians_;
+};
+
+} // namespace people_msgs_utils
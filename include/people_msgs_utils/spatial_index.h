@@ -0,0 +1,102 @@
+#pragma once
+
+#include <people_msgs_utils/group.h>
+#include <people_msgs_utils/ospace.h>
+#include <people_msgs_utils/person.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Uniform grid over positions of people and O-spaces of groups for fast proximity queries
+ *
+ * Replaces linear scans over People and Groups, e.g., when evaluating costmap cells or path poses. Queries
+ * return indices into the containers given to @ref build, so these must not be modified while the index is used.
+ *
+ * Rebuilding is O(N) (a counting sort of items into grid cells) and reuses memory of the previous build,
+ * so the index is supposed to be rebuilt for each frame. Only x and y coordinates are considered.
+ *
+ * Queries are const and may be called concurrently from multiple threads.
+ */
+class SpatialIndex {
+public:
+	/**
+	 * @param cell_size edge length of a grid cell; radius of the typical query is a reasonable choice
+	 */
+	explicit SpatialIndex(double cell_size = 1.0);
+
+	/**
+	 * @brief Creates the index from the given people and groups, replacing the previous contents
+	 *
+	 * Groups are represented by ellipses defined by their poses and spans (see Group::getSpanX), groups
+	 * with degenerate spatial models are not indexed.
+	 */
+	void build(const People& people, const Groups& groups = Groups());
+
+	/// Stores indices of people located within @ref radius from the given point in @ref indices (cleared first)
+	void queryRadius(double x, double y, double radius, std::vector<size_t>& indices) const;
+
+	/// @sa queryRadius
+	std::vector<size_t> queryRadius(double x, double y, double radius) const;
+
+	/**
+	 * @brief Stores indices of (at most) @ref k people nearest to the given point in @ref indices (cleared first)
+	 *
+	 * Indices are sorted by increasing distance
+	 */
+	void queryNearest(double x, double y, size_t k, std::vector<size_t>& indices) const;
+
+	/// @sa queryNearest
+	std::vector<size_t> queryNearest(double x, double y, size_t k) const;
+
+	/// Stores indices of groups whose O-space ellipse contains the given point in @ref indices (cleared first)
+	void queryGroupsContaining(double x, double y, std::vector<size_t>& indices) const;
+
+	/// @sa queryGroupsContaining
+	std::vector<size_t> queryGroupsContaining(double x, double y) const;
+
+	inline double getCellSize() const {
+		return cell_size_;
+	}
+
+	inline size_t getPeopleCount() const {
+		return people_x_.size();
+	}
+
+	inline size_t getGroupsCount() const {
+		return ellipses_.size();
+	}
+
+protected:
+	/// Cell coordinate (not clamped to the grid) along the given axis
+	long long toCell(double coord, double origin) const;
+
+	/// Index of the cell in the flat array; coordinates must be within the grid
+	inline size_t toCellIndex(long long cx, long long cy) const {
+		return static_cast<size_t>(cy) * static_cast<size_t>(cells_x_) + static_cast<size_t>(cx);
+	}
+
+	double cell_size_;
+	/// Cell size used by the current build; larger than requested if the area spanned by items is huge
+	double cell_size_effective_;
+	double origin_x_;
+	double origin_y_;
+	long long cells_x_;
+	long long cells_y_;
+
+	/// Positions of people (structure of arrays)
+	std::vector<double> people_x_;
+	std::vector<double> people_y_;
+	/// People indices sorted by cells; people of cell i are stored in [people_cell_start_[i], people_cell_start_[i+1])
+	std::vector<size_t> people_cell_start_;
+	std::vector<size_t> people_cells_;
+
+	std::vector<OSpaceEllipse> ellipses_;
+	/// Group indices stored in each cell overlapped by a group's bounding box, same layout as for people
+	std::vector<size_t> groups_cell_start_;
+	std::vector<size_t> groups_cells_;
+};
+
+} // namespace people_msgs_utils
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <people_msgs_utils/person.h>
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace people_msgs_utils {
+
+/// Compact planar state of a tracked person observed at a time
+struct TrackState {
+	double stamp;
+	double x;
+	double y;
+	double yaw;
+};
+
+/// Smoothed motion estimates of a track
+struct TrackEstimate {
+	double vx;
+	double vy;
+	double ax;
+	double ay;
+	/// Rate of change of the orientation (yaw) [rad/s]
+	double heading_rate;
+};
+
+/**
+ * @brief Fixed-capacity history of tracked people with incrementally smoothed motion estimates
+ *
+ * Each track is stored in a slot identified by an index that stays valid until the track is evicted; names
+ * of people (track IDs) are interned, i.e., mapped to slots, once. States of all tracks are stored in a single
+ * preallocated array of ring buffers, so no memory is allocated per update (except for hash map nodes of new
+ * track IDs, which are reused after eviction once the capacity has been reached).
+ *
+ * Velocity is estimated from differences of consecutive positions and smoothed with an exponential moving average;
+ * acceleration and heading rate are smoothed in the same way, so each update is O(1). The velocity reported
+ * by the tracker only initializes the estimate of a new track.
+ *
+ * A track is reset when the tracker reports a lower track age than the stored one (the ID has been reused).
+ * Tracks are evicted when not seen for the given timeout or, when all slots are occupied, in the order
+ * of the last observation.
+ */
+class TrackHistory {
+public:
+	/// Returned as a slot index if there is no such track
+	static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+	struct Parameters {
+		/// Number of states kept per track
+		size_t capacity = 20;
+		/// Number of slots, i.e., the maximum number of tracks stored at once
+		size_t max_tracks = 128;
+		/// Tracks not seen for longer than this are evicted [s]
+		double timeout = 2.0;
+		/// Weight of the newest sample in the moving average of velocity and heading rate, within (0, 1]
+		double velocity_smoothing = 0.5;
+		/// Weight of the newest sample in the moving average of acceleration, within (0, 1]
+		double acceleration_smoothing = 0.3;
+	};
+
+	/// Uses default parameters
+	TrackHistory();
+
+	explicit TrackHistory(const Parameters& params);
+
+	/// Adds states of all @ref people observed at the @ref stamp, then evicts tracks that timed out
+	void update(const People& people, double stamp);
+
+	/**
+	 * @brief Adds the state of the @ref person observed at the @ref stamp
+	 *
+	 * Observations that are not newer than the last one of the track are ignored
+	 *
+	 * @return slot index of the track
+	 */
+	size_t update(const Person& person, double stamp);
+
+	/// Evicts tracks last seen before @ref stamp - timeout; returns the number of evicted tracks
+	size_t evict(double stamp);
+
+	/// Removes all tracks
+	void clear();
+
+	/// Returns slot index of the track with the given name (track ID) or @ref NONE
+	size_t find(const std::string& name) const;
+
+	/// Returns the number of stored tracks
+	inline size_t size() const {
+		return ids_.size();
+	}
+
+	inline const std::string& getName(size_t track) const {
+		return tracks_[track].name;
+	}
+
+	/// Returns the number of states stored for the track
+	inline size_t getStatesCount(size_t track) const {
+		return tracks_[track].count;
+	}
+
+	/// Returns the @ref k-th latest state of the track (0 is the latest), @ref k < getStatesCount(track)
+	inline const TrackState& getState(size_t track, size_t k) const {
+		const auto& t = tracks_[track];
+		size_t index = (t.head + params_.capacity - k) % params_.capacity;
+		return states_[track * params_.capacity + index];
+	}
+
+	inline const TrackEstimate& getEstimate(size_t track) const {
+		return tracks_[track].estimate;
+	}
+
+	inline double getLastSeen(size_t track) const {
+		return getState(track, 0).stamp;
+	}
+
+	inline const Parameters& getParameters() const {
+		return params_;
+	}
+
+protected:
+	struct Track {
+		std::string name;
+		unsigned long int track_age = 0;
+		/// Position of the latest state in the ring buffer
+		size_t head = 0;
+		size_t count = 0;
+		TrackEstimate estimate{};
+	};
+
+	/// Assigns a free slot to a new track, evicting the least recently seen one if necessary
+	size_t allocate(const std::string& name);
+
+	/// Releases the slot, keeping the map node (and the memory of the name) for reuse
+	void release(size_t track);
+
+	Parameters params_;
+	std::vector<Track> tracks_;
+	/// Ring buffers of all slots, the slot i occupies [i * capacity, (i + 1) * capacity)
+	std::vector<TrackState> states_;
+	std::vector<size_t> free_slots_;
+	/// Interned track IDs
+	std::unordered_map<std::string, size_t> ids_;
+	/// Map nodes of evicted tracks, reused by new ones
+	std::vector<std::unordered_map<std::string, size_t>::node_type> spare_nodes_;
+};
+
+} // namespace people_msgs_utils
@@ -1,13 +1,19 @@
 #pragma once
 
+#include <people_msgs_utils/frame.h>
 #include <people_msgs_utils/group.h>
+#include <people_msgs_utils/parallel.h>
 #include <people_msgs_utils/person.h>
+#include <people_msgs_utils/person_view.h>
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace people_msgs_utils {
 
+class GroupCache;
+
 /**
  * @brief Evaluates each person from the given vector, parses string tags and returns a set of People and Groups
  *
@@ -15,6 +21,90 @@ namespace people_msgs_utils {
  */
 std::pair<std::vector<Person>, std::vector<Group>> createFromPeople(const std::vector<people_msgs::Person>& people);
 
+/**
+ * @brief Overload of @ref createFromPeople that distributes parsing of people and construction of groups
+ * with @ref parallel_for
+ *
+ * The output is identical (including the order) to the one of the sequential version
+ *
+ * @param parallel_for executor, e.g., adapter of a caller's thread pool or @ref createThreadParallelFor
+ */
+std::pair<std::vector<Person>, std::vector<Group>> createFromPeople(
+	const std::vector<people_msgs::Person>& people,
+	const ParallelFor& parallel_for
+);
+
+/**
+ * @brief Overload of @ref createFromPeople operating on views into a serialized people_msgs/People buffer
+ *
+ * Strings are parsed directly from the views, so no intermediate people_msgs::Person copies are made
+ *
+ * @sa decodePeople
+ */
+std::pair<std::vector<Person>, std::vector<Group>> createFromPeople(const std::vector<PersonView>& people);
+
+/**
+ * @brief Overload of @ref createFromPeople that writes into @ref frame, reusing memory allocated by previous calls
+ *
+ * Once warmed up (on the calling thread) with frames of the same shape as the previous ones, the conversion
+ * makes no heap allocations in the library code, as long as IDs and tags fit into already allocated strings.
+ * Ellipse fitting of social_nav_utils is not covered by this guarantee.
+ *
+ * @param parallel_for optional executor, see the other overloads
+ */
+void createFromPeople(
+	const std::vector<people_msgs::Person>& people,
+	Frame& frame,
+	const ParallelFor& parallel_for = ParallelFor()
+);
+
+/**
+ * @brief Overload of @ref createFromPeople that also stores the header of the message, creating a stamped frame
+ *
+ * @sa FrameResampler
+ */
+void createFromPeople(
+	const people_msgs::People& msg,
+	Frame& frame,
+	const ParallelFor& parallel_for = ParallelFor()
+);
+
+/**
+ * @brief Overload of @ref createFromPeople that derives ellipses of groups from @ref cache when possible instead
+ * of fitting them, and updates @ref cache with the created groups
+ *
+ * Messages must be given in order of their stamps
+ */
+void createFromPeople(
+	const people_msgs::People& msg,
+	Frame& frame,
+	GroupCache& cache,
+	const ParallelFor& parallel_for = ParallelFor()
+);
+
+/**
+ * @brief Overload of @ref createFromPeople that writes views of people into @ref frame, reusing its memory
+ *
+ * Combined with @ref decodePeople reusing its PeopleView, allows converting serialized messages without
+ * heap allocations in the steady state
+ */
+void createFromPeople(
+	const std::vector<PersonView>& people,
+	Frame& frame,
+	const ParallelFor& parallel_for = ParallelFor()
+);
+
+/**
+ * @brief Stage of @ref createFromPeople that converts people only, without collecting and creating groups
+ *
+ * Group IDs and other tags of people are parsed as usual; @ref output is overwritten reusing its memory
+ */
+void createPeople(
+	const std::vector<people_msgs::Person>& people,
+	People& output,
+	const ParallelFor& parallel_for = ParallelFor()
+);
+
 /**
  * Function that is handy once groups were created only with member IDs, without actual Person class instances
  *
@@ -27,46 +117,84 @@ std::vector<Group> fillGroupsWithMembers(const std::vector<Group>& groups, const
 /**
  * @brief Helper function for parsing bool values
  */
-bool parseStringBool(const std::string& str);
+bool parseStringBool(std::string_view str);
 
 /**
- * @brief Parses string containing a set of T-type values
+ * @brief Helper function for parsing a floating-point value without creating an intermediate std::string
  *
- * @tparam T type of values (numeric)
+ * @throws std::invalid_argument if no conversion could be performed (consistent with std::stod)
  */
-template <typename T>
-std::vector<T> parseString(const std::string& str, const std::string& delimiter) {
-	std::vector<T> values;
-	std::string payload(str);
+double parseStringDouble(std::string_view str);
+
+/**
+ * @brief Helper function for parsing an unsigned integer value without creating an intermediate std::string
+ *
+ * @throws std::invalid_argument if no conversion could be performed (consistent with std::stoul)
+ */
+unsigned long parseStringUnsigned(std::string_view str);
 
+/**
+ * @brief Calls @ref fun with each token of @ref str separated by @ref delimiter; does not allocate
+ *
+ * Tokens consisting of whitespaces only (spaces, tabs and newlines) are skipped, wherever they occur.
+ *
+ * @tparam Fun callable accepting std::string_view
+ */
+template <typename Fun>
+void forEachToken(std::string_view str, std::string_view delimiter, Fun fun) {
 	if (str.empty() || delimiter.empty()) {
-		return values;
+		return;
 	}
 
-	// https://stackoverflow.com/a/14266139
-	size_t pos = 0;
-	std::string token;
-	while ((pos = payload.find(delimiter)) != std::string::npos) {
-		token = payload.substr(0, pos);
+	size_t start = 0;
+	while (true) {
+		size_t pos = str.find(delimiter, start);
+		auto token = str.substr(start, pos == std::string_view::npos ? std::string_view::npos : pos - start);
 
 		// check if token stores some valid chars and not whitespaces
-		if(token.find_first_not_of(' ') == std::string::npos) {
-			payload.erase(0, pos + delimiter.length());
-			continue;
+		if (token.find_first_not_of("\t\n ") != std::string_view::npos) {
+			fun(token);
 		}
 
-		// convert with the biggest possible precision, then convert to desired type
-		values.push_back(static_cast<T>(std::stod(token)));
-		payload.erase(0, pos + delimiter.length());
+		if (pos == std::string_view::npos) {
+			break;
+		}
+		start = pos + delimiter.length();
 	}
+}
 
-	bool token_with_whitespace_only = payload.find_first_not_of("\t\n ") == std::string::npos;
-	if (payload.empty() || token_with_whitespace_only) {
-		return values;
-	}
+/**
+ * @brief Parses string containing a set of T-type values
+ *
+ * @tparam T type of values (numeric)
+ */
+template <typename T>
+std::vector<T> parseString(std::string_view str, std::string_view delimiter) {
+	std::vector<T> values;
+	forEachToken(str, delimiter, [&values](std::string_view token) {
+		// convert with the biggest possible precision, then convert to desired type
+		values.push_back(static_cast<T>(parseStringDouble(token)));
+	});
+	return values;
+}
 
-	// token still stores some meaningful value
-	values.push_back(static_cast<T>(std::stod(payload)));
+/**
+ * @brief Parses string containing a set of T-type values into a preallocated array, without heap allocations
+ *
+ * @param values output array
+ * @param capacity size of the @ref values array; further values are counted, but not stored
+ * @return number of values found in @ref str
+ */
+template <typename T>
+size_t parseString(std::string_view str, std::string_view delimiter, T* values, size_t capacity) {
+	size_t count = 0;
+	forEachToken(str, delimiter, [&](std::string_view token) {
+		if (count < capacity) {
+			values[count] = static_cast<T>(parseStringDouble(token));
+		}
+		count++;
+	});
+	return count;
 }
 
 /**
@@ -77,6 +205,16 @@ std::vector<T> parseString(const std::string& str, const std::string& delimiter)
  * Defined in cpp to avoid multiple definitions
  */
 template<>
-std::vector<std::string> parseString<std::string>(const std::string& str, const std::string& delimiter);
+std::vector<std::string> parseString<std::string>(std::string_view str, std::string_view delimiter);
+
+/**
+ * @brief Splits string into a set of views (this is a template specialization)
+ *
+ * Returned views point into @ref str, so they are valid as long as the underlying buffer is
+ *
+ * @sa parseString template
+ */
+template<>
+std::vector<std::string_view> parseString<std::string_view>(std::string_view str, std::string_view delimiter);
 
 } // namespace people_msgs_utils
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+/**
+ * Building blocks of the batch kernels (social costs, O-space queries, etc.).
+ *
+ * Comparisons of floating-point values may trap, so compilers do not turn selects based on them into
+ * branch-free code and give up vectorizing the loops. These helpers express such selects with integer operations
+ * on bit patterns instead, so loops using them are vectorized (with -O3, e.g., in the Release build type).
+ */
+namespace people_msgs_utils {
+namespace vectorization {
+
+/// Bit pattern of a double (memcpy is optimized out)
+inline uint64_t toBits(double value) {
+	uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+inline double fromBits(uint64_t bits) {
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/// Returns all ones if @ref value is negative (including -0.0), zero otherwise
+inline uint64_t maskNegative(double value) {
+	return 0 - (toBits(value) >> 63);
+}
+
+/// Returns @ref value if @ref x >= @ref limit, zero otherwise
+inline double maskBelow(double value, double x, double limit) {
+	return fromBits(toBits(value) & ~maskNegative(x - limit));
+}
+
+/// Returns all ones if @ref a < @ref b, zero otherwise; both must be non-negative (bit patterns are then ordered)
+inline uint64_t maskLessNonNegative(double a, double b) {
+	return 0 - ((toBits(a) - toBits(b)) >> 63);
+}
+
+/// Returns @ref a where @ref mask is set, @ref b otherwise
+inline uint64_t select(uint64_t mask, uint64_t a, uint64_t b) {
+	return (a & mask) | (b & ~mask);
+}
+
+inline double select(uint64_t mask, double a, double b) {
+	return fromBits(select(mask, toBits(a), toBits(b)));
+}
+
+/// Returns the greater of non-negative values
+inline double maxNonNegative(double a, double b) {
+	return select(maskLessNonNegative(a, b), b, a);
+}
+
+/// Returns the lesser of non-negative values
+inline double minNonNegative(double a, double b) {
+	return select(maskLessNonNegative(a, b), a, b);
+}
+
+/**
+ * @brief Computes exp(x) for x in [-700, 0] without branches and library calls
+ *
+ * Range reduction x = n * ln(2) + r, |r| <= ln(2) / 2, followed by a Taylor polynomial of exp(r) and scaling
+ * by 2^n constructed directly in the exponent bits. Relative error is below 1e-14. Results for arguments
+ * out of the range are meaningless, so these must be masked by the caller.
+ */
+inline double expNonPositive(double x) {
+	constexpr double LOG2E = 1.4426950408889634;
+	constexpr double LN2_HI = 6.93147180369123816490e-01;
+	constexpr double LN2_LO = 1.90821492927058770002e-10;
+	// adding and subtracting 1.5 * 2^52 rounds to the nearest integer
+	constexpr double ROUND = 6755399441055744.0;
+	// 2^52 + 1023; the integer n + 1023 appears in the low bits of (n + SHIFT)
+	constexpr double SHIFT = 4503599627370496.0 + 1023.0;
+	constexpr uint64_t SHIFT_BITS = 0x4330000000000000ULL;
+
+	double n = (x * LOG2E + ROUND) - ROUND;
+	double r = (x - n * LN2_HI) - n * LN2_LO;
+	double p = 1.0 / 39916800.0;
+	p = p * r + 1.0 / 3628800.0;
+	p = p * r + 1.0 / 362880.0;
+	p = p * r + 1.0 / 40320.0;
+	p = p * r + 1.0 / 5040.0;
+	p = p * r + 1.0 / 720.0;
+	p = p * r + 1.0 / 120.0;
+	p = p * r + 1.0 / 24.0;
+	p = p * r + 1.0 / 6.0;
+	p = p * r + 0.5;
+	p = p * r + 1.0;
+	p = p * r + 1.0;
+
+	uint64_t scale_bits = (toBits(n + SHIFT) - SHIFT_BITS) << 52;
+	return p * fromBits(scale_bits);
+}
+
+} // namespace vectorization
+} // namespace people_msgs_utils
@@ -0,0 +1,141 @@
+#include <people_msgs_utils/conversion_pipeline.h>
+#include <people_msgs_utils/utils.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace people_msgs_utils {
+
+ConversionPipeline::ConversionPipeline(size_t capacity, OverflowPolicy policy, const ParallelFor& parallel_for):
+	queue_(std::max(capacity, static_cast<size_t>(1))),
+	queue_head_(0),
+	queue_size_(0),
+	policy_(policy),
+	parallel_for_(parallel_for),
+	busy_(false),
+	stop_(false)
+{
+	worker_ = std::thread(&ConversionPipeline::process, this);
+}
+
+ConversionPipeline::~ConversionPipeline() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stop_ = true;
+	}
+	cv_worker_.notify_all();
+	cv_producer_.notify_all();
+	worker_.join();
+}
+
+bool ConversionPipeline::push(const std::shared_ptr<const people_msgs::People>& msg) {
+	std::unique_lock<std::mutex> lock(mutex_);
+	stats_.pushed++;
+
+	bool dropped = false;
+	if (queue_size_ == queue_.size()) {
+		switch (policy_) {
+			case OverflowPolicy::DROP_OLDEST:
+				// superseded message is evicted
+				queue_[queue_head_] = Item();
+				queue_head_ = (queue_head_ + 1) % queue_.size();
+				queue_size_--;
+				stats_.dropped++;
+				dropped = true;
+				break;
+			case OverflowPolicy::DROP_NEWEST:
+				stats_.dropped++;
+				return false;
+			case OverflowPolicy::BLOCK:
+				cv_producer_.wait(lock, [this]() { return queue_size_ < queue_.size() || stop_; });
+				if (stop_) {
+					return false;
+				}
+				break;
+		}
+	}
+
+	queue_[(queue_head_ + queue_size_) % queue_.size()] = Item{msg, Clock::now()};
+	queue_size_++;
+	lock.unlock();
+	cv_worker_.notify_one();
+	return !dropped;
+}
+
+void ConversionPipeline::setCallback(const std::function<void(const std::shared_ptr<const Frame>&)>& callback) {
+	std::lock_guard<std::mutex> lock(mutex_);
+	callback_ = callback;
+}
+
+bool ConversionPipeline::waitUntilIdle(std::chrono::milliseconds timeout) {
+	std::unique_lock<std::mutex> lock(mutex_);
+	return cv_producer_.wait_for(lock, timeout, [this]() { return (queue_size_ == 0 && !busy_) || stop_; });
+}
+
+ConversionPipeline::Statistics ConversionPipeline::getStatistics() const {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return stats_;
+}
+
+void ConversionPipeline::process() {
+	while (true) {
+		Item item;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			cv_worker_.wait(lock, [this]() { return queue_size_ > 0 || stop_; });
+			if (stop_) {
+				return;
+			}
+			item = std::move(queue_[queue_head_]);
+			queue_head_ = (queue_head_ + 1) % queue_.size();
+			queue_size_--;
+			busy_ = true;
+		}
+		// there is a free slot now
+		cv_producer_.notify_all();
+
+		auto frame = std::make_shared<Frame>();
+		bool converted = true;
+		try {
+			if (item.msg) {
+				createFromPeople(*item.msg, *frame, parallel_for_);
+			}
+		} catch (const std::exception&) {
+			// malformed tags; the worker must survive
+			converted = false;
+		}
+
+		std::shared_ptr<const Frame> frame_ready(std::move(frame));
+		if (converted) {
+			snapshot_.publish(frame_ready);
+		}
+
+		std::function<void(const std::shared_ptr<const Frame>&)> callback;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			if (!converted) {
+				stats_.failed++;
+			} else {
+				double latency = std::chrono::duration<double>(Clock::now() - item.push_time).count();
+				stats_.converted++;
+				stats_.latency_last = latency;
+				stats_.latency_min = stats_.converted == 1 ? latency : std::min(stats_.latency_min, latency);
+				stats_.latency_max = std::max(stats_.latency_max, latency);
+				// incremental mean
+				stats_.latency_mean += (latency - stats_.latency_mean) / static_cast<double>(stats_.converted);
+				callback = callback_;
+			}
+		}
+		if (callback) {
+			callback(frame_ready);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			busy_ = false;
+		}
+		cv_producer_.notify_all();
+	}
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,251 @@
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/person.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <tuple>
+
+namespace people_msgs_utils {
+
+/// Value assigned to variances that are not measured (as in spencer_tracking_conversion)
+static constexpr double VARIANCE_UNKNOWN = 99999.0;
+
+CrowdGenerator::CrowdGenerator(const Parameters& params):
+	params_(params),
+	rng_(params.seed)
+{
+	params_.group_size_min = std::max(params_.group_size_min, static_cast<size_t>(2));
+	params_.group_size_max = std::max(params_.group_size_max, params_.group_size_min);
+
+	size_t num_grouped = static_cast<size_t>(
+		std::round(std::clamp(params_.group_ratio, 0.0, 1.0) * static_cast<double>(params_.num_people))
+	);
+	double half_size = params_.area_size / 2.0;
+
+	people_.resize(params_.num_people);
+	size_t i = 0;
+	// create groups first
+	while (num_grouped - i >= params_.group_size_min) {
+		size_t size_range = params_.group_size_max - params_.group_size_min + 1;
+		size_t size = params_.group_size_min + static_cast<size_t>(uniform() * static_cast<double>(size_range));
+		size = std::min(size, num_grouped - i);
+
+		GroupState group;
+		group.x = uniform(-half_size, half_size);
+		group.y = uniform(-half_size, half_size);
+		// groups move slower than individuals
+		double heading = uniform(-M_PI, M_PI);
+		double speed = uniform(0.0, params_.speed_max / 2.0);
+		group.vx = speed * std::cos(heading);
+		group.vy = speed * std::sin(heading);
+		group.age = static_cast<unsigned long int>(uniform(0.0, 100.0));
+		// members are placed evenly on a circle around the O-space center
+		double radius = uniform(0.5, 1.0) + 0.1 * static_cast<double>(size);
+		for (size_t m = 0; m < size; m++) {
+			double angle = 2.0 * M_PI * static_cast<double>(m) / static_cast<double>(size);
+			group.members.push_back(i + m);
+			group.offsets.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+		}
+		for (size_t m1 = 0; m1 < size; m1++) {
+			for (size_t m2 = m1 + 1; m2 < size; m2++) {
+				if (uniform() < params_.relation_density) {
+					group.relations.emplace_back(i + m1, i + m2, uniform(0.5, 1.0));
+				}
+			}
+		}
+		for (size_t m = 0; m < size; m++) {
+			auto& person = people_.at(i + m);
+			person.x = group.x + group.offsets.at(m).first;
+			person.y = group.y + group.offsets.at(m).second;
+			person.vx = group.vx;
+			person.vy = group.vy;
+			person.track_age = group.age + static_cast<unsigned long int>(uniform(0.0, 20.0));
+			person.group = static_cast<int>(groups_.size());
+		}
+		groups_.push_back(group);
+		i += size;
+	}
+	// the rest walks alone
+	for (; i < people_.size(); i++) {
+		auto& person = people_.at(i);
+		person.x = uniform(-half_size, half_size);
+		person.y = uniform(-half_size, half_size);
+		double heading = uniform(-M_PI, M_PI);
+		double speed = uniform(0.0, params_.speed_max);
+		person.vx = speed * std::cos(heading);
+		person.vy = speed * std::sin(heading);
+		person.track_age = static_cast<unsigned long int>(uniform(0.0, 100.0));
+		person.group = -1;
+	}
+}
+
+std::vector<people_msgs::Person> CrowdGenerator::generate() {
+	// group data are stored in tags of each member
+	struct GroupTags {
+		std::string track_ids;
+		std::string center_of_gravity;
+		std::string relations;
+	};
+	std::vector<GroupTags> group_tags;
+	for (const auto& group: groups_) {
+		GroupTags tags;
+		double cog_x = 0.0;
+		double cog_y = 0.0;
+		for (const auto& member: group.members) {
+			tags.track_ids += std::to_string(member) + " ";
+			cog_x += people_.at(member).x;
+			cog_y += people_.at(member).y;
+		}
+		cog_x /= static_cast<double>(group.members.size());
+		cog_y /= static_cast<double>(group.members.size());
+		tags.center_of_gravity = std::to_string(cog_x) + " " + std::to_string(cog_y) + " 0.0";
+		for (const auto& relation: group.relations) {
+			tags.relations += std::to_string(std::get<0>(relation)) + " "
+				+ std::to_string(std::get<1>(relation)) + " "
+				+ std::to_string(std::get<2>(relation)) + " ";
+		}
+		group_tags.push_back(tags);
+	}
+
+	std::vector<people_msgs::Person> people;
+	people.reserve(people_.size());
+	for (size_t i = 0; i < people_.size(); i++) {
+		const auto& state = people_.at(i);
+		bool occluded = uniform() < params_.occlusion_ratio;
+
+		people_msgs::Person person;
+		person.name = std::to_string(i);
+		person.position.x = state.x;
+		person.position.y = state.y;
+		person.velocity.x = state.vx;
+		person.velocity.y = state.vy;
+		person.reliability = occluded ? uniform(0.1, 0.5) : uniform(0.5, 1.0);
+
+		double heading = std::atan2(state.vy, state.vx);
+		person.tagnames.push_back("orientation");
+		person.tags.push_back(
+			"0.0 0.0 " + std::to_string(std::sin(heading / 2.0)) + " " + std::to_string(std::cos(heading / 2.0))
+		);
+		if (params_.covariance_tags) {
+			// occluded tracks are less certain
+			double variance = occluded ? uniform(0.2, 0.5) : uniform(0.01, 0.1);
+			person.tagnames.push_back("pose_covariance");
+			person.tags.push_back(createCovArray(variance, 0.0, variance, 0.03));
+			person.tagnames.push_back("twist_covariance");
+			person.tags.push_back(createCovArray(2.0 * variance, 0.0, 2.0 * variance, VARIANCE_UNKNOWN));
+		}
+		person.tagnames.insert(person.tagnames.end(), {"occluded", "matched", "detection_id", "track_age", "group_id"});
+		person.tags.insert(
+			person.tags.end(),
+			{
+				occluded ? "true" : "false",
+				occluded ? "false" : "true",
+				std::to_string(1000 + i),
+				std::to_string(state.track_age),
+				state.group >= 0 ? std::to_string(state.group) : std::string()
+			}
+		);
+		if (state.group >= 0) {
+			const auto& group = groups_.at(state.group);
+			const auto& tags = group_tags.at(state.group);
+			person.tagnames.insert(
+				person.tagnames.end(),
+				{"group_age", "group_track_ids", "group_center_of_gravity", "social_relations"}
+			);
+			person.tags.insert(
+				person.tags.end(),
+				{std::to_string(group.age), tags.track_ids, tags.center_of_gravity, tags.relations}
+			);
+		}
+
+		if (uniform() < params_.malformed_tag_ratio) {
+			if (uniform() < 0.5) {
+				// value that cannot be parsed
+				size_t index = static_cast<size_t>(uniform() * static_cast<double>(person.tags.size()));
+				person.tags.at(index) = "malformed";
+			} else {
+				// sizes of tagnames and tags do not match
+				person.tags.pop_back();
+			}
+		}
+		people.push_back(person);
+	}
+	return people;
+}
+
+void CrowdGenerator::step() {
+	const double dt = params_.dt;
+	for (auto& group: groups_) {
+		group.x += group.vx * dt;
+		group.y += group.vy * dt;
+		reflect(group.x, group.y, group.vx, group.vy);
+		group.age++;
+		for (size_t m = 0; m < group.members.size(); m++) {
+			auto& person = people_.at(group.members.at(m));
+			person.x = group.x + group.offsets.at(m).first;
+			person.y = group.y + group.offsets.at(m).second;
+			person.vx = group.vx;
+			person.vy = group.vy;
+		}
+	}
+	for (auto& person: people_) {
+		person.track_age++;
+		if (person.group >= 0) {
+			continue;
+		}
+		// random walk of the velocity
+		person.vx += uniform(-0.1, 0.1);
+		person.vy += uniform(-0.1, 0.1);
+		double speed = std::hypot(person.vx, person.vy);
+		if (speed > params_.speed_max) {
+			person.vx *= params_.speed_max / speed;
+			person.vy *= params_.speed_max / speed;
+		}
+		person.x += person.vx * dt;
+		person.y += person.vy * dt;
+		reflect(person.x, person.y, person.vx, person.vy);
+	}
+}
+
+double CrowdGenerator::uniform() {
+	// 32 random bits are enough for the purpose
+	return static_cast<double>(rng_()) / 4294967296.0;
+}
+
+double CrowdGenerator::uniform(double min, double max) {
+	return min + (max - min) * uniform();
+}
+
+void CrowdGenerator::reflect(double& x, double& y, double& vx, double& vy) const {
+	double half_size = params_.area_size / 2.0;
+	if (std::abs(x) > half_size) {
+		x = std::copysign(half_size, x);
+		vx = -vx;
+	}
+	if (std::abs(y) > half_size) {
+		y = std::copysign(half_size, y);
+		vy = -vy;
+	}
+}
+
+std::string CrowdGenerator::createCovArray(double xx, double xy, double yy, double yawyaw) const {
+	std::array<double, Person::COV_MAT_SIZE> cov;
+	cov.fill(0.0);
+	cov[Person::COV_XX_INDEX] = xx;
+	cov[Person::COV_XY_INDEX] = xy;
+	cov[Person::COV_YX_INDEX] = xy;
+	cov[Person::COV_YY_INDEX] = yy;
+	cov[Person::COV_ZZ_INDEX] = VARIANCE_UNKNOWN;
+	cov[Person::COV_ROLLROLL_INDEX] = VARIANCE_UNKNOWN;
+	cov[Person::COV_PITCHPITCH_INDEX] = VARIANCE_UNKNOWN;
+	cov[Person::COV_YAWYAW_INDEX] = yawyaw;
+
+	std::string str;
+	for (const auto& value: cov) {
+		str += std::to_string(value) + " ";
+	}
+	return str;
+}
+
+} // namespace people_msgs_utils
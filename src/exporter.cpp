@@ -0,0 +1,554 @@
+#include <people_msgs_utils/exporter.h>
+#include <people_msgs_utils/utils.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+namespace people_msgs_utils {
+
+enum class ColumnType {
+	TIMESTAMP,
+	DOUBLE,
+	STRING
+};
+
+/// Output column and its index in the buffers of its type (see FrameExporter::DoubleColumn, StringColumnIndex)
+struct Column {
+	const char* name;
+	ColumnType type;
+	size_t index;
+};
+
+static constexpr Column COLUMNS[] = {
+	{"stamp", ColumnType::TIMESTAMP, 0},
+	{"id", ColumnType::STRING, 0},
+	{"x", ColumnType::DOUBLE, 0},
+	{"y", ColumnType::DOUBLE, 1},
+	{"vx", ColumnType::DOUBLE, 2},
+	{"vy", ColumnType::DOUBLE, 3},
+	{"cov_xx", ColumnType::DOUBLE, 4},
+	{"cov_yy", ColumnType::DOUBLE, 5},
+	{"cov_yawyaw", ColumnType::DOUBLE, 6},
+	{"reliability", ColumnType::DOUBLE, 7},
+	{"group", ColumnType::STRING, 1},
+	{"relation", ColumnType::STRING, 2},
+	{"relation_strength", ColumnType::DOUBLE, 8}
+};
+
+/// Marks the beginning of each message of the Arrow IPC stream
+static constexpr uint32_t ARROW_CONTINUATION = 0xFFFFFFFF;
+/// Constants of the Arrow flatbuffers schema (Message.fbs, Schema.fbs)
+static constexpr uint16_t ARROW_METADATA_V5 = 4;
+static constexpr uint8_t ARROW_HEADER_SCHEMA = 1;
+static constexpr uint8_t ARROW_HEADER_RECORD_BATCH = 3;
+static constexpr uint8_t ARROW_TYPE_FLOATING_POINT = 3;
+static constexpr uint8_t ARROW_TYPE_UTF8 = 5;
+static constexpr uint8_t ARROW_TYPE_TIMESTAMP = 10;
+static constexpr uint16_t ARROW_PRECISION_DOUBLE = 2;
+static constexpr uint16_t ARROW_TIME_UNIT_NANOSECOND = 3;
+/// Buffers of record batches are padded to multiples of this
+static constexpr size_t ARROW_ALIGNMENT = 8;
+
+/**
+ * @brief Minimal FlatBuffers builder that writes front to back
+ *
+ * Objects referred to are written after the objects referring to them, so that all (unsigned) offsets point
+ * forward; offset fields are written as zeros and set once their targets exist
+ */
+class FlatBufferBuilder {
+public:
+	/// Scalar or offset field of a table
+	struct Field {
+		uint16_t id;
+		uint8_t size;
+		uint64_t value;
+	};
+
+	/// Structs of Arrow vectors (FieldNode and Buffer)
+	struct Int64Pair {
+		int64_t first;
+		int64_t second;
+	};
+
+	explicit FlatBufferBuilder(std::vector<uint8_t>& data): data_(data) {
+		// offset of the root table
+		data_.assign(sizeof(uint32_t), 0);
+	}
+
+	/**
+	 * @brief Writes a table (preceded by its vtable)
+	 *
+	 * @param positions output; positions of the fields in the order of @ref fields
+	 *
+	 * @return position of the table
+	 */
+	size_t addTable(std::initializer_list<Field> fields, std::vector<size_t>& positions) {
+		size_t num_slots = 0;
+		for (const auto& field: fields) {
+			num_slots = std::max<size_t>(num_slots, field.id + 1);
+		}
+		align(sizeof(uint16_t));
+		size_t vtable = data_.size();
+		size_t vtable_size = 2 * sizeof(uint16_t) + num_slots * sizeof(uint16_t);
+		data_.resize(vtable + vtable_size, 0);
+
+		align(sizeof(uint64_t));
+		size_t table = data_.size();
+		append<int32_t>(table - vtable, sizeof(int32_t));
+		positions.clear();
+		for (const auto& field: fields) {
+			align(field.size);
+			positions.push_back(data_.size());
+			set<uint16_t>(vtable + 2 * sizeof(uint16_t) + field.id * sizeof(uint16_t), data_.size() - table);
+			append<uint64_t>(field.value, field.size);
+		}
+		set<uint16_t>(vtable, vtable_size);
+		set<uint16_t>(vtable + sizeof(uint16_t), data_.size() - table);
+		return table;
+	}
+
+	size_t addString(std::string_view str) {
+		align(sizeof(uint32_t));
+		size_t position = data_.size();
+		append<uint32_t>(str.size(), sizeof(uint32_t));
+		data_.insert(data_.end(), str.cbegin(), str.cend());
+		data_.push_back(0);
+		return position;
+	}
+
+	/// Returns the position of the vector; its elements are set with @ref setOffset
+	size_t addOffsetVector(size_t size) {
+		align(sizeof(uint32_t));
+		size_t position = data_.size();
+		append<uint32_t>(size, sizeof(uint32_t));
+		data_.resize(data_.size() + size * sizeof(uint32_t), 0);
+		return position;
+	}
+
+	size_t addStructVector(const std::vector<Int64Pair>& elements) {
+		// elements are aligned, the length precedes them
+		align(sizeof(uint32_t));
+		if ((data_.size() + sizeof(uint32_t)) % sizeof(int64_t) != 0) {
+			append<uint32_t>(0, sizeof(uint32_t));
+		}
+		size_t position = data_.size();
+		append<uint32_t>(elements.size(), sizeof(uint32_t));
+		for (const auto& element: elements) {
+			append<int64_t>(element.first, sizeof(int64_t));
+			append<int64_t>(element.second, sizeof(int64_t));
+		}
+		return position;
+	}
+
+	/// Position of the @ref index-th element of the offset vector at @ref vector
+	static size_t getElementPosition(size_t vector, size_t index) {
+		return vector + sizeof(uint32_t) + index * sizeof(uint32_t);
+	}
+
+	void setOffset(size_t position, size_t target) {
+		set<uint32_t>(position, target - position);
+	}
+
+	void setRoot(size_t table) {
+		setOffset(0, table);
+	}
+
+	/// Pads the buffer, so the message body that follows is aligned
+	void finish() {
+		align(ARROW_ALIGNMENT);
+	}
+
+private:
+	void align(size_t alignment) {
+		data_.resize((data_.size() + alignment - 1) / alignment * alignment, 0);
+	}
+
+	/// Appends the lowest @ref size bytes of the value (little endian)
+	template <typename T>
+	void append(T value, size_t size) {
+		size_t position = data_.size();
+		data_.resize(position + size);
+		auto raw = static_cast<uint64_t>(value);
+		std::memcpy(&data_[position], &raw, size);
+	}
+
+	template <typename T>
+	void set(size_t position, T value) {
+		std::memcpy(&data_[position], &value, sizeof(T));
+	}
+
+	std::vector<uint8_t>& data_;
+};
+
+void FrameExporter::StringColumn::append(std::string_view str) {
+	chars.append(str.data(), str.size());
+	offsets.push_back(chars.size());
+	nulls.push_back(false);
+}
+
+void FrameExporter::StringColumn::appendNull() {
+	offsets.push_back(chars.size());
+	nulls.push_back(true);
+}
+
+void FrameExporter::StringColumn::clear() {
+	offsets.assign(1, 0);
+	chars.clear();
+	nulls.clear();
+}
+
+FrameExporter::FrameExporter(const std::string& path): FrameExporter(path, Parameters()) {}
+
+FrameExporter::FrameExporter(const std::string& path, const Parameters& params):
+	params_(params),
+	num_rows_(0),
+	num_row_groups_(0)
+{
+	if (params.row_group_size == 0) {
+		throw std::invalid_argument("Invalid parameters of the export '" + path + "'");
+	}
+	file_.open(path, std::ios::binary | std::ios::trunc);
+	if (!file_) {
+		throw std::runtime_error("Cannot create the export '" + path + "': " + std::strerror(errno));
+	}
+	if (params_.format == Format::ARROW) {
+		writeArrowSchema();
+		return;
+	}
+	line_.clear();
+	for (const auto& column: COLUMNS) {
+		line_ += column.name;
+		line_ += ',';
+	}
+	line_.back() = '\n';
+	write(line_.data(), line_.size());
+}
+
+FrameExporter::~FrameExporter() {
+	try {
+		close();
+	} catch (const std::exception&) {
+		// the output stays incomplete
+	}
+}
+
+void FrameExporter::append(const Frame& frame) {
+	const auto& people = frame.people;
+	person_index_.clear();
+	for (size_t i = 0; i < people.size(); i++) {
+		person_index_.emplace(people[i].getName(), i);
+	}
+	relation_strengths_.assign(people.size(), std::numeric_limits<double>::quiet_NaN());
+	relation_ids_.assign(people.size(), nullptr);
+	auto update = [this](const std::string& name, const std::string& other, double strength) {
+		auto it = person_index_.find(name);
+		if (it == person_index_.cend()) {
+			return;
+		}
+		// comparisons with NaN fail
+		if (!(strength <= relation_strengths_[it->second])) {
+			relation_strengths_[it->second] = strength;
+			relation_ids_[it->second] = &other;
+		}
+	};
+	for (const auto& group: frame.groups) {
+		for (const auto& relation: group.getSocialRelations()) {
+			update(std::get<0>(relation), std::get<1>(relation), std::get<2>(relation));
+			update(std::get<1>(relation), std::get<0>(relation), std::get<2>(relation));
+		}
+	}
+
+	int64_t stamp = static_cast<int64_t>(frame.header.stamp.sec) * 1000000000 + frame.header.stamp.nsec;
+	for (size_t i = 0; i < people.size(); i++) {
+		const auto& person = people[i];
+		stamps_.push_back(stamp);
+		strings_[ID].append(person.getName());
+		doubles_[X].push_back(person.getPositionX());
+		doubles_[Y].push_back(person.getPositionY());
+		doubles_[VX].push_back(person.getVelocityX());
+		doubles_[VY].push_back(person.getVelocityY());
+		doubles_[COV_XX].push_back(person.getCovariancePoseXX());
+		doubles_[COV_YY].push_back(person.getCovariancePoseYY());
+		doubles_[COV_YAWYAW].push_back(person.getCovariancePoseYawYaw());
+		doubles_[RELIABILITY].push_back(person.getReliability());
+		if (person.getGroupName().empty()) {
+			strings_[GROUP].appendNull();
+		} else {
+			strings_[GROUP].append(person.getGroupName());
+		}
+		if (relation_ids_[i] == nullptr) {
+			strings_[RELATION].appendNull();
+		} else {
+			strings_[RELATION].append(*relation_ids_[i]);
+		}
+		doubles_[RELATION_STRENGTH].push_back(relation_strengths_[i]);
+		num_rows_++;
+		if (stamps_.size() >= params_.row_group_size) {
+			flush();
+		}
+	}
+}
+
+bool FrameExporter::append(const uint8_t* buffer, size_t length) {
+	if (!decodePeople(buffer, length, view_)) {
+		return false;
+	}
+	createFromPeople(view_.people, frame_);
+	frame_.header.seq = view_.seq;
+	frame_.header.stamp = view_.stamp;
+	frame_.header.frame_id.assign(view_.frame_id.data(), view_.frame_id.size());
+	append(frame_);
+	return true;
+}
+
+void FrameExporter::flush() {
+	if (stamps_.empty() || !file_.is_open()) {
+		return;
+	}
+	if (params_.format == Format::ARROW) {
+		writeArrowRecordBatch();
+	} else {
+		writeCsvRows();
+	}
+	num_row_groups_++;
+
+	stamps_.clear();
+	for (auto& column: doubles_) {
+		column.clear();
+	}
+	for (auto& column: strings_) {
+		column.clear();
+	}
+}
+
+void FrameExporter::close() {
+	if (!file_.is_open()) {
+		return;
+	}
+	flush();
+	if (params_.format == Format::ARROW) {
+		// end of the stream
+		uint32_t eos[] = {ARROW_CONTINUATION, 0};
+		write(eos, sizeof(eos));
+	}
+	file_.close();
+	if (!file_) {
+		throw std::runtime_error("Cannot complete the export");
+	}
+}
+
+void FrameExporter::write(const void* data, size_t size) {
+	file_.write(static_cast<const char*>(data), size);
+	if (!file_) {
+		throw std::runtime_error("Cannot write into the export");
+	}
+}
+
+void FrameExporter::writeCsvRows() {
+	char number[64];
+	auto append_string = [this](std::string_view str) {
+		if (str.find_first_of(",\"\r\n") == std::string_view::npos) {
+			line_.append(str.data(), str.size());
+			return;
+		}
+		// quoted, with quotes doubled
+		line_ += '"';
+		for (char c: str) {
+			if (c == '"') {
+				line_ += '"';
+			}
+			line_ += c;
+		}
+		line_ += '"';
+	};
+
+	line_.clear();
+	for (size_t row = 0; row < stamps_.size(); row++) {
+		for (const auto& column: COLUMNS) {
+			switch (column.type) {
+				case ColumnType::TIMESTAMP: {
+					int64_t stamp = stamps_[row];
+					int length = std::snprintf(
+						number,
+						sizeof(number),
+						"%lld.%09lld",
+						static_cast<long long>(stamp / 1000000000),
+						static_cast<long long>(stamp % 1000000000)
+					);
+					line_.append(number, length);
+					break;
+				}
+				case ColumnType::DOUBLE: {
+					double value = doubles_[column.index][row];
+					// missing values are empty
+					if (!std::isnan(value)) {
+						int length = std::snprintf(number, sizeof(number), "%.*g", params_.precision, value);
+						line_.append(number, length);
+					}
+					break;
+				}
+				case ColumnType::STRING:
+					append_string(strings_[column.index].get(row));
+					break;
+			}
+			line_ += ',';
+		}
+		line_.back() = '\n';
+	}
+	write(line_.data(), line_.size());
+}
+
+void FrameExporter::writeArrowSchema() {
+	FlatBufferBuilder builder(metadata_);
+	std::vector<size_t> positions;
+	size_t message = builder.addTable(
+		{
+			{0, sizeof(uint16_t), ARROW_METADATA_V5},
+			{1, sizeof(uint8_t), ARROW_HEADER_SCHEMA},
+			{2, sizeof(uint32_t), 0},
+			{3, sizeof(int64_t), 0}
+		},
+		positions
+	);
+	builder.setRoot(message);
+	size_t header = positions[2];
+
+	// little endian, fields
+	size_t schema = builder.addTable({{0, sizeof(uint16_t), 0}, {1, sizeof(uint32_t), 0}}, positions);
+	builder.setOffset(header, schema);
+	size_t num_columns = std::size(COLUMNS);
+	size_t fields = builder.addOffsetVector(num_columns);
+	builder.setOffset(positions[1], fields);
+
+	for (size_t c = 0; c < num_columns; c++) {
+		const auto& column = COLUMNS[c];
+		uint8_t type_type = column.type == ColumnType::TIMESTAMP
+			? ARROW_TYPE_TIMESTAMP
+			: column.type == ColumnType::DOUBLE ? ARROW_TYPE_FLOATING_POINT : ARROW_TYPE_UTF8;
+		// name, nullable, type_type, type, children
+		size_t field = builder.addTable(
+			{
+				{0, sizeof(uint32_t), 0},
+				{1, sizeof(uint8_t), 1},
+				{2, sizeof(uint8_t), type_type},
+				{3, sizeof(uint32_t), 0},
+				{5, sizeof(uint32_t), 0}
+			},
+			positions
+		);
+		builder.setOffset(FlatBufferBuilder::getElementPosition(fields, c), field);
+		size_t name_position = positions[0];
+		size_t type_position = positions[3];
+		size_t children_position = positions[4];
+
+		builder.setOffset(name_position, builder.addString(column.name));
+		std::vector<size_t> type_positions;
+		size_t type = 0;
+		switch (column.type) {
+			case ColumnType::TIMESTAMP:
+				type = builder.addTable({{0, sizeof(uint16_t), ARROW_TIME_UNIT_NANOSECOND}}, type_positions);
+				break;
+			case ColumnType::DOUBLE:
+				type = builder.addTable({{0, sizeof(uint16_t), ARROW_PRECISION_DOUBLE}}, type_positions);
+				break;
+			case ColumnType::STRING:
+				type = builder.addTable({}, type_positions);
+				break;
+		}
+		builder.setOffset(type_position, type);
+		builder.setOffset(children_position, builder.addOffsetVector(0));
+	}
+	builder.finish();
+
+	uint32_t prefix[] = {ARROW_CONTINUATION, static_cast<uint32_t>(metadata_.size())};
+	write(prefix, sizeof(prefix));
+	write(metadata_.data(), metadata_.size());
+}
+
+void FrameExporter::writeArrowRecordBatch() {
+	size_t num_rows = stamps_.size();
+	std::vector<FlatBufferBuilder::Int64Pair> nodes;
+	std::vector<FlatBufferBuilder::Int64Pair> buffers;
+	// buffers of the body in order, without padding
+	std::vector<std::pair<const void*, size_t>> body;
+	int64_t body_length = 0;
+	auto add_buffer = [&](const void* data, size_t size) {
+		buffers.push_back({body_length, static_cast<int64_t>(size)});
+		body.emplace_back(data, size);
+		body_length += (size + ARROW_ALIGNMENT - 1) / ARROW_ALIGNMENT * ARROW_ALIGNMENT;
+	};
+	// validity bitmaps (least significant bit first) are omitted for columns without nulls
+	validity_.resize(std::size(COLUMNS));
+	for (size_t c = 0; c < std::size(COLUMNS); c++) {
+		const auto& column = COLUMNS[c];
+		auto& validity = validity_[c];
+		validity.assign((num_rows + 7) / 8, 0);
+		int64_t null_count = 0;
+		for (size_t row = 0; row < num_rows; row++) {
+			bool is_null = column.type == ColumnType::DOUBLE
+				? std::isnan(doubles_[column.index][row])
+				: column.type == ColumnType::STRING && strings_[column.index].nulls[row];
+			null_count += is_null;
+			validity[row / 8] |= static_cast<uint8_t>(!is_null) << (row % 8);
+		}
+		nodes.push_back({static_cast<int64_t>(num_rows), null_count});
+		add_buffer(validity.data(), null_count == 0 ? 0 : validity.size());
+		switch (column.type) {
+			case ColumnType::TIMESTAMP:
+				add_buffer(stamps_.data(), num_rows * sizeof(int64_t));
+				break;
+			case ColumnType::DOUBLE:
+				add_buffer(doubles_[column.index].data(), num_rows * sizeof(double));
+				break;
+			case ColumnType::STRING: {
+				const auto& strings = strings_[column.index];
+				add_buffer(strings.offsets.data(), strings.offsets.size() * sizeof(int32_t));
+				add_buffer(strings.chars.data(), strings.chars.size());
+				break;
+			}
+		}
+	}
+
+	FlatBufferBuilder builder(metadata_);
+	std::vector<size_t> positions;
+	size_t message = builder.addTable(
+		{
+			{0, sizeof(uint16_t), ARROW_METADATA_V5},
+			{1, sizeof(uint8_t), ARROW_HEADER_RECORD_BATCH},
+			{2, sizeof(uint32_t), 0},
+			{3, sizeof(int64_t), static_cast<uint64_t>(body_length)}
+		},
+		positions
+	);
+	builder.setRoot(message);
+	size_t header = positions[2];
+	// length, nodes, buffers
+	size_t batch = builder.addTable(
+		{{0, sizeof(int64_t), num_rows}, {1, sizeof(uint32_t), 0}, {2, sizeof(uint32_t), 0}},
+		positions
+	);
+	builder.setOffset(header, batch);
+	size_t nodes_position = positions[1];
+	size_t buffers_position = positions[2];
+	builder.setOffset(nodes_position, builder.addStructVector(nodes));
+	builder.setOffset(buffers_position, builder.addStructVector(buffers));
+	builder.finish();
+
+	uint32_t prefix[] = {ARROW_CONTINUATION, static_cast<uint32_t>(metadata_.size())};
+	write(prefix, sizeof(prefix));
+	write(metadata_.data(), metadata_.size());
+	static const char PADDING[ARROW_ALIGNMENT] = {};
+	for (const auto& buffer: body) {
+		write(buffer.first, buffer.second);
+		write(PADDING, (ARROW_ALIGNMENT - buffer.second % ARROW_ALIGNMENT) % ARROW_ALIGNMENT);
+	}
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,100 @@
+#include <people_msgs_utils/formation.h>
+#include <people_msgs_utils/grouping.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace people_msgs_utils {
+
+FFormationDetector::FFormationDetector(): FFormationDetector(Parameters()) {}
+
+FFormationDetector::FFormationDetector(const Parameters& params):
+	params_(params),
+	index_(params.max_distance)
+{}
+
+void FFormationDetector::detect(People& people, Groups& groups) {
+	// existing assignments would link people in groupByRelations
+	for (auto& person: people) {
+		person.setGroupName(std::string());
+	}
+
+	arrays_.assign(people);
+	states_.resize(people.size());
+	for (size_t i = 0; i < people.size(); i++) {
+		states_[i] = createState(arrays_.x[i], arrays_.y[i], arrays_.yaw[i], arrays_.vx[i], arrays_.vy[i]);
+	}
+
+	index_.build(people);
+	relations_.clear();
+	for (size_t i = 0; i < people.size(); i++) {
+		index_.queryRadius(states_[i].x, states_[i].y, params_.max_distance, neighbors_);
+		for (size_t j: neighbors_) {
+			// each pair once
+			if (j <= i) {
+				continue;
+			}
+			double strength = computeRelationStrength(states_[i], states_[j]);
+			if (strength > 0.0) {
+				relations_.emplace_back(people[i].getName(), people[j].getName(), strength);
+			}
+		}
+	}
+
+	groupByRelations(people, relations_, params_.threshold, groups);
+}
+
+double FFormationDetector::computeRelationStrength(const Person& a, const Person& b) const {
+	return computeRelationStrength(
+		createState(a.getPositionX(), a.getPositionY(), a.getOrientationYaw(), a.getVelocityX(), a.getVelocityY()),
+		createState(b.getPositionX(), b.getPositionY(), b.getOrientationYaw(), b.getVelocityX(), b.getVelocityY())
+	);
+}
+
+FFormationDetector::State FFormationDetector::createState(
+	double x,
+	double y,
+	double yaw,
+	double vx,
+	double vy
+) const {
+	State state;
+	state.x = x;
+	state.y = y;
+	state.vx = vx;
+	state.vy = vy;
+	state.speed = std::hypot(vx, vy);
+	state.ospace_x = x + params_.stride * std::cos(yaw);
+	state.ospace_y = y + params_.stride * std::sin(yaw);
+	return state;
+}
+
+double FFormationDetector::computeRelationStrength(const State& a, const State& b) const {
+	double dx = b.x - a.x;
+	double dy = b.y - a.y;
+	if (dx * dx + dy * dy > params_.max_distance * params_.max_distance) {
+		return 0.0;
+	}
+
+	bool moving_a = a.speed > params_.standing_speed;
+	bool moving_b = b.speed > params_.standing_speed;
+	if (moving_a != moving_b) {
+		return 0.0;
+	}
+
+	if (!moving_a) {
+		// people facing the same O-space
+		double ox = b.ospace_x - a.ospace_x;
+		double oy = b.ospace_y - a.ospace_y;
+		double sigma_sq = params_.ospace_tolerance * params_.ospace_tolerance;
+		return std::exp(-(ox * ox + oy * oy) / (2.0 * sigma_sq));
+	}
+
+	// people walking together: cosine of the angle between directions of motion and similarity of speeds
+	double heading_coherence = std::max(0.0, (a.vx * b.vx + a.vy * b.vy) / (a.speed * b.speed));
+	double dv = a.speed - b.speed;
+	double sigma_sq = params_.speed_tolerance * params_.speed_tolerance;
+	return heading_coherence * std::exp(-dv * dv / (2.0 * sigma_sq));
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,277 @@
+#include <people_msgs_utils/frame_diff.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace people_msgs_utils {
+
+/// Maps names of the items (people or groups) to their indices; names must outlive the index
+typedef std::unordered_map<std::string_view, size_t> NameIndex;
+
+/// Returned as an index if there is no such item
+static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+template <typename ContainerT>
+static void buildIndex(const ContainerT& items, NameIndex& index) {
+	index.clear();
+	index.reserve(items.size());
+	for (size_t i = 0; i < items.size(); i++) {
+		index.emplace(items[i].getName(), i);
+	}
+}
+
+static size_t findIndex(const NameIndex& index, std::string_view name) {
+	auto it = index.find(name);
+	return it == index.cend() ? NONE : it->second;
+}
+
+/// Compares values, treating NaNs (e.g., yaw of unknown orientations) as equal
+static bool isSame(double lhs, double rhs) {
+	return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs));
+}
+
+template <size_t N>
+static bool isSame(const std::array<double, N>& lhs, const std::array<double, N>& rhs) {
+	return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin(), [](double l, double r) { return isSame(l, r); });
+}
+
+static bool isSamePerson(const Person& lhs, const Person& rhs) {
+	auto lhs_orientation = lhs.getOrientation();
+	auto rhs_orientation = rhs.getOrientation();
+	return lhs.getName() == rhs.getName()
+		&& isSame(lhs.getPositionX(), rhs.getPositionX())
+		&& isSame(lhs.getPositionY(), rhs.getPositionY())
+		&& isSame(lhs.getPositionZ(), rhs.getPositionZ())
+		&& isSame(lhs_orientation.x, rhs_orientation.x)
+		&& isSame(lhs_orientation.y, rhs_orientation.y)
+		&& isSame(lhs_orientation.z, rhs_orientation.z)
+		&& isSame(lhs_orientation.w, rhs_orientation.w)
+		&& isSame(lhs.getVelocityX(), rhs.getVelocityX())
+		&& isSame(lhs.getVelocityY(), rhs.getVelocityY())
+		&& isSame(lhs.getVelocityZ(), rhs.getVelocityZ())
+		&& isSame(lhs.getVelocityTheta(), rhs.getVelocityTheta())
+		&& isSame(lhs.getCovariancePose(), rhs.getCovariancePose())
+		&& isSame(lhs.getCovarianceVelocity(), rhs.getCovarianceVelocity())
+		&& isSame(lhs.getReliability(), rhs.getReliability())
+		&& lhs.isOccluded() == rhs.isOccluded()
+		&& lhs.isMatched() == rhs.isMatched()
+		&& lhs.getDetectionID() == rhs.getDetectionID()
+		&& lhs.getTrackAge() == rhs.getTrackAge()
+		&& lhs.getGroupName() == rhs.getGroupName();
+}
+
+static bool isSameGroup(const Group& lhs, const Group& rhs) {
+	auto lhs_cog = lhs.getCenterOfGravity();
+	auto rhs_cog = rhs.getCenterOfGravity();
+	if (lhs.getName() != rhs.getName()
+		|| lhs.getAge() != rhs.getAge()
+		|| lhs.getMemberIDs() != rhs.getMemberIDs()
+		|| lhs.getSocialRelations() != rhs.getSocialRelations()
+		|| !isSame(lhs_cog.x, rhs_cog.x)
+		|| !isSame(lhs_cog.y, rhs_cog.y)
+		|| !isSame(lhs_cog.z, rhs_cog.z)
+		|| lhs.getMembers().size() != rhs.getMembers().size()
+	) {
+		return false;
+	}
+	for (size_t i = 0; i < lhs.getMembers().size(); i++) {
+		if (!isSamePerson(lhs.getMembers()[i], rhs.getMembers()[i])) {
+			return false;
+		}
+	}
+	// spatial model is computed from the members, but the members of the same group may also be given implicitly
+	return isSame(lhs.getPositionX(), rhs.getPositionX())
+		&& isSame(lhs.getPositionY(), rhs.getPositionY())
+		&& isSame(lhs.getOrientationYaw(), rhs.getOrientationYaw())
+		&& isSame(lhs.getSpanX(), rhs.getSpanX())
+		&& isSame(lhs.getSpanY(), rhs.getSpanY());
+}
+
+/// Returns index of the group the person is assigned to or NONE
+static size_t findGroup(const NameIndex& groups, const Person& person) {
+	return person.isAssignedToGroup() ? findIndex(groups, person.getGroupName()) : NONE;
+}
+
+void diffFrames(const Frame& prev, const Frame& curr, std::vector<FrameEvent>& events) {
+	events.clear();
+	NameIndex prev_people;
+	NameIndex curr_people;
+	NameIndex prev_groups;
+	NameIndex curr_groups;
+	buildIndex(prev.people, prev_people);
+	buildIndex(curr.people, curr_people);
+	buildIndex(prev.groups, prev_groups);
+	buildIndex(curr.groups, curr_groups);
+
+	auto add_event = [&](FrameEventType type, std::string_view person, std::string_view group, std::string_view other) {
+		events.push_back(FrameEvent{type, std::string(person), std::string(group), std::string(other)});
+	};
+
+	// tracks
+	for (const auto& person: curr.people) {
+		if (findIndex(prev_people, person.getName()) == NONE) {
+			add_event(FrameEventType::TRACK_APPEARED, person.getName(), "", "");
+		}
+	}
+	for (const auto& person: prev.people) {
+		if (findIndex(curr_people, person.getName()) == NONE) {
+			add_event(FrameEventType::TRACK_VANISHED, person.getName(), "", "");
+		}
+	}
+
+	// membership
+	for (const auto& person: curr.people) {
+		if (!person.isAssignedToGroup()) {
+			continue;
+		}
+		size_t i = findIndex(prev_people, person.getName());
+		if (i == NONE || !prev.people[i].isAssignedToGroup() || prev.people[i].getGroupName() != person.getGroupName()) {
+			add_event(FrameEventType::GROUP_JOINED, person.getName(), person.getGroupName(), "");
+		}
+	}
+	for (const auto& person: prev.people) {
+		if (!person.isAssignedToGroup()) {
+			continue;
+		}
+		size_t i = findIndex(curr_people, person.getName());
+		if (i == NONE || !curr.people[i].isAssignedToGroup() || curr.people[i].getGroupName() != person.getGroupName()) {
+			add_event(FrameEventType::GROUP_LEFT, person.getName(), person.getGroupName(), "");
+		}
+	}
+
+	// groups
+	for (const auto& group: curr.groups) {
+		if (findIndex(prev_groups, group.getName()) == NONE) {
+			add_event(FrameEventType::GROUP_FORMED, "", group.getName(), "");
+		}
+	}
+	for (const auto& group: prev.groups) {
+		if (findIndex(curr_groups, group.getName()) == NONE) {
+			add_event(FrameEventType::GROUP_DISSOLVED, "", group.getName(), "");
+		}
+	}
+
+	// distinct (older group, newer group) pairs of tracks present in both frames, in the order of newer people
+	std::vector<std::pair<size_t, size_t>> transitions;
+	std::unordered_set<uint64_t> transitions_seen;
+	std::vector<size_t> successors(prev.groups.size(), 0);
+	std::vector<size_t> predecessors(curr.groups.size(), 0);
+	for (const auto& person: curr.people) {
+		size_t curr_group = findGroup(curr_groups, person);
+		size_t i = findIndex(prev_people, person.getName());
+		if (curr_group == NONE || i == NONE) {
+			continue;
+		}
+		size_t prev_group = findGroup(prev_groups, prev.people[i]);
+		if (prev_group == NONE) {
+			continue;
+		}
+		uint64_t key = (static_cast<uint64_t>(prev_group) << 32) | static_cast<uint64_t>(curr_group);
+		if (transitions_seen.insert(key).second) {
+			transitions.emplace_back(prev_group, curr_group);
+			successors[prev_group]++;
+			predecessors[curr_group]++;
+		}
+	}
+	for (const auto& [prev_group, curr_group]: transitions) {
+		if (successors[prev_group] > 1) {
+			add_event(FrameEventType::GROUP_SPLIT, "", prev.groups[prev_group].getName(), curr.groups[curr_group].getName());
+		}
+	}
+	for (const auto& [prev_group, curr_group]: transitions) {
+		if (predecessors[curr_group] > 1) {
+			add_event(FrameEventType::GROUP_MERGED, "", curr.groups[curr_group].getName(), prev.groups[prev_group].getName());
+		}
+	}
+}
+
+std::vector<FrameEvent> diffFrames(const Frame& prev, const Frame& curr) {
+	std::vector<FrameEvent> events;
+	diffFrames(prev, curr, events);
+	return events;
+}
+
+PeopleFrameDelta PeopleFrameDelta::fromFrames(const Frame& prev, const Frame& curr) {
+	PeopleFrameDelta delta;
+	delta.header = curr.header;
+	NameIndex index;
+
+	buildIndex(curr.people, index);
+	for (const auto& person: prev.people) {
+		if (findIndex(index, person.getName()) == NONE) {
+			delta.removed_people.push_back(person.getName());
+		}
+	}
+	buildIndex(prev.people, index);
+	for (const auto& person: curr.people) {
+		size_t i = findIndex(index, person.getName());
+		if (i == NONE || !isSamePerson(prev.people[i], person)) {
+			delta.updated_people.push_back(person);
+		}
+	}
+
+	buildIndex(curr.groups, index);
+	for (const auto& group: prev.groups) {
+		if (findIndex(index, group.getName()) == NONE) {
+			delta.removed_groups.push_back(group.getName());
+		}
+	}
+	buildIndex(prev.groups, index);
+	for (const auto& group: curr.groups) {
+		size_t i = findIndex(index, group.getName());
+		if (i == NONE || !isSameGroup(prev.groups[i], group)) {
+			delta.updated_groups.push_back(group);
+		}
+	}
+	return delta;
+}
+
+/// Removes items with the given names, replaces items with names of the updated ones and appends the rest
+template <typename ContainerT>
+static void patch(ContainerT& items, const std::vector<std::string>& removed, const ContainerT& updated) {
+	std::unordered_set<std::string_view> removed_names(removed.cbegin(), removed.cend());
+	items.erase(
+		std::remove_if(
+			items.begin(),
+			items.end(),
+			[&](const typename ContainerT::value_type& item) {
+				return removed_names.count(item.getName()) > 0;
+			}
+		),
+		items.end()
+	);
+
+	// modifications would invalidate views of the names in the index, so these are collected first
+	NameIndex index;
+	buildIndex(items, index);
+	std::vector<std::pair<size_t, size_t>> replaced;
+	std::vector<size_t> appended;
+	for (size_t i = 0; i < updated.size(); i++) {
+		size_t j = findIndex(index, updated[i].getName());
+		if (j == NONE) {
+			appended.push_back(i);
+		} else {
+			replaced.emplace_back(j, i);
+		}
+	}
+	for (const auto& [j, i]: replaced) {
+		items[j] = updated[i];
+	}
+	for (size_t i: appended) {
+		items.push_back(updated[i]);
+	}
+}
+
+void PeopleFrameDelta::apply(Frame& frame) const {
+	frame.header = header;
+	patch(frame.people, removed_people, updated_people);
+	patch(frame.groups, removed_groups, updated_groups);
+}
+
+} // namespace people_msgs_utils
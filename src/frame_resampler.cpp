@@ -0,0 +1,178 @@
+#include <people_msgs_utils/frame_resampler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string_view>
+#include <unordered_map>
+
+namespace people_msgs_utils {
+
+/// Maps names of people to their indices; names must outlive the index
+typedef std::unordered_map<std::string_view, size_t> NameIndex;
+
+static void buildIndex(const People& people, NameIndex& index) {
+	index.clear();
+	index.reserve(people.size());
+	for (size_t i = 0; i < people.size(); i++) {
+		index.emplace(people[i].getName(), i);
+	}
+}
+
+/// Moves the person with its velocity for the time @ref dt (may be negative)
+static void extrapolate(Person& person, double dt) {
+	person.setPlanarState(
+		person.getPositionX() + person.getVelocityX() * dt,
+		person.getPositionY() + person.getVelocityY() * dt,
+		person.getOrientationYaw(),
+		person.getVelocityX(),
+		person.getVelocityY()
+	);
+}
+
+/**
+ * @brief Moves groups rigidly according to the motion of their members between the original positions
+ * (stored in the groups) and the resampled ones (stored in @ref people)
+ */
+static void moveGroups(const People& people, Groups& groups) {
+	NameIndex index;
+	buildIndex(people, index);
+	for (auto& group: groups) {
+		// centroids of original (source) and resampled (target) positions of members
+		double sx = 0.0;
+		double sy = 0.0;
+		double tx = 0.0;
+		double ty = 0.0;
+		size_t num = 0;
+		for (const auto& member: group.getMembers()) {
+			auto it = index.find(member.getName());
+			if (it == index.cend()) {
+				continue;
+			}
+			sx += member.getPositionX();
+			sy += member.getPositionY();
+			tx += people[it->second].getPositionX();
+			ty += people[it->second].getPositionY();
+			num++;
+		}
+		if (num == 0) {
+			continue;
+		}
+		sx /= num;
+		sy /= num;
+		tx /= num;
+		ty /= num;
+
+		// least-squares rotation between the centered point sets (2D Procrustes)
+		double dot = 0.0;
+		double cross = 0.0;
+		for (const auto& member: group.getMembers()) {
+			auto it = index.find(member.getName());
+			if (it == index.cend()) {
+				continue;
+			}
+			double ax = member.getPositionX() - sx;
+			double ay = member.getPositionY() - sy;
+			double bx = people[it->second].getPositionX() - tx;
+			double by = people[it->second].getPositionY() - ty;
+			dot += ax * bx + ay * by;
+			cross += ax * by - ay * bx;
+		}
+		double yaw = (num > 1 && (dot != 0.0 || cross != 0.0)) ? std::atan2(cross, dot) : 0.0;
+
+		// translation that maps the rotated source centroid onto the target one
+		double c = std::cos(yaw);
+		double s = std::sin(yaw);
+		group.moveRigidly(tx - (c * sx - s * sy), ty - (s * sx + c * sy), yaw);
+	}
+}
+
+FrameResampler::FrameResampler():
+	FrameResampler(Parameters())
+{}
+
+FrameResampler::FrameResampler(const Parameters& params):
+	params_(params),
+	head_(0),
+	count_(0)
+{
+	params_.history = std::max<size_t>(params_.history, 2);
+	params_.max_extrapolation = std::max(params_.max_extrapolation, 0.0);
+	frames_.resize(params_.history);
+}
+
+bool FrameResampler::add(const Frame& frame) {
+	if (count_ > 0 && !(frame.header.stamp > getLatest().header.stamp)) {
+		return false;
+	}
+	head_ = (head_ + 1) % frames_.size();
+	// assignment reuses memory of the replaced frame
+	frames_[head_] = frame;
+	count_ = std::min(count_ + 1, frames_.size());
+	return true;
+}
+
+bool FrameResampler::resample(const ros::Time& stamp, Frame& frame) const {
+	if (count_ == 0) {
+		return false;
+	}
+	double t = stamp.toSec();
+
+	// interpolation between two stored frames
+	for (size_t k = 0; k + 1 < count_; k++) {
+		const auto& newer = getFrame(k);
+		const auto& older = getFrame(k + 1);
+		double t0 = older.header.stamp.toSec();
+		double t1 = newer.header.stamp.toSec();
+		if (t < t0 || t > t1) {
+			continue;
+		}
+		double alpha = (t - t0) / (t1 - t0);
+		frame = newer;
+		frame.header.stamp = stamp;
+
+		NameIndex index;
+		buildIndex(older.people, index);
+		for (auto& person: frame.people) {
+			auto it = index.find(person.getName());
+			if (it == index.cend()) {
+				// appeared in the newer frame
+				extrapolate(person, t - t1);
+				continue;
+			}
+			const auto& prev = older.people[it->second];
+			auto lerp = [alpha](double a, double b) {
+				return a + alpha * (b - a);
+			};
+			double yaw_change = std::remainder(person.getOrientationYaw() - prev.getOrientationYaw(), 2.0 * M_PI);
+			person.setPlanarState(
+				lerp(prev.getPositionX(), person.getPositionX()),
+				lerp(prev.getPositionY(), person.getPositionY()),
+				prev.getOrientationYaw() + alpha * yaw_change,
+				lerp(prev.getVelocityX(), person.getVelocityX()),
+				lerp(prev.getVelocityY(), person.getVelocityY())
+			);
+		}
+		moveGroups(frame.people, frame.groups);
+		return true;
+	}
+
+	// extrapolation from the latest or the oldest frame
+	const auto& nearest = t > getLatest().header.stamp.toSec() ? getLatest() : getFrame(count_ - 1);
+	double dt = t - nearest.header.stamp.toSec();
+	if (std::abs(dt) > params_.max_extrapolation) {
+		return false;
+	}
+	frame = nearest;
+	frame.header.stamp = stamp;
+	for (auto& person: frame.people) {
+		extrapolate(person, dt);
+	}
+	moveGroups(frame.people, frame.groups);
+	return true;
+}
+
+void FrameResampler::clear() {
+	count_ = 0;
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,28 @@
+#include <people_msgs_utils/frame_snapshot.h>
+
+namespace people_msgs_utils {
+
+FrameSnapshot::FrameSnapshot():
+	frame_(std::make_shared<const Frame>()),
+	version_(0)
+{}
+
+void FrameSnapshot::publish(Frame&& frame) {
+	publish(std::make_shared<const Frame>(std::move(frame)));
+}
+
+void FrameSnapshot::publish(std::shared_ptr<const Frame> frame) {
+	if (!frame) {
+		// readers expect a valid frame
+		frame = std::make_shared<const Frame>();
+	}
+	// previous frame is released once the last reader drops it
+	std::atomic_store_explicit(&frame_, std::move(frame), std::memory_order_release);
+	version_.fetch_add(1, std::memory_order_release);
+}
+
+std::shared_ptr<const Frame> FrameSnapshot::get() const {
+	return std::atomic_load_explicit(&frame_, std::memory_order_acquire);
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,237 @@
+#include <people_msgs_utils/fusion.h>
+#include <people_msgs_utils/grouping.h>
+#include <people_msgs_utils/people_arrays.h>
+
+#include <algorithm>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace people_msgs_utils {
+
+/// Marks people without a fusion candidate
+static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+/// Symmetric 2x2 matrix
+struct Matrix2D {
+	double xx;
+	double xy;
+	double yy;
+};
+
+/// Inverts a covariance, regularized as in PeopleArrays::computeCovarianceFactors
+static Matrix2D invertCovariance(double xx, double xy, double yy) {
+	xx = std::max(xx, PeopleArrays::MIN_VARIANCE);
+	yy = std::max(yy, PeopleArrays::MIN_VARIANCE);
+	double det = std::max(xx * yy - xy * xy, PeopleArrays::MIN_VARIANCE * PeopleArrays::MIN_VARIANCE);
+	return Matrix2D{yy / det, -xy / det, xx / det};
+}
+
+/// Fuses the estimates of (a, b) in the information form; outputs the mean and the covariance
+static void fuseEstimates(
+	double ax,
+	double ay,
+	const Matrix2D& a_inv,
+	double bx,
+	double by,
+	const Matrix2D& b_inv,
+	double& x,
+	double& y,
+	Matrix2D& cov
+) {
+	Matrix2D info{a_inv.xx + b_inv.xx, a_inv.xy + b_inv.xy, a_inv.yy + b_inv.yy};
+	cov = invertCovariance(info.xx, info.xy, info.yy);
+	double ix = a_inv.xx * ax + a_inv.xy * ay + b_inv.xx * bx + b_inv.xy * by;
+	double iy = a_inv.xy * ax + a_inv.yy * ay + b_inv.xy * bx + b_inv.yy * by;
+	x = cov.xx * ix + cov.xy * iy;
+	y = cov.xy * ix + cov.yy * iy;
+}
+
+/// Stores the planar block of the covariance
+static void setPlanarCovariance(geometry_msgs::PoseWithCovariance& pose, const Matrix2D& cov) {
+	pose.covariance[Person::COV_XX_INDEX] = cov.xx;
+	pose.covariance[Person::COV_XY_INDEX] = cov.xy;
+	pose.covariance[Person::COV_YX_INDEX] = cov.xy;
+	pose.covariance[Person::COV_YY_INDEX] = cov.yy;
+}
+
+/// Returns the fused estimate of the person observed as @ref a and @ref b; other attributes are taken from @ref a
+static Person fusePeople(const Person& a, const Person& b) {
+	geometry_msgs::PoseWithCovariance pose;
+	pose.pose = a.getPose();
+	auto pose_cov = a.getCovariancePose();
+	std::copy(pose_cov.cbegin(), pose_cov.cend(), pose.covariance.begin());
+	// orientation of the more certain one
+	if (b.getCovariancePoseYawYaw() < a.getCovariancePoseYawYaw()) {
+		pose.pose.orientation = b.getOrientation();
+		pose.covariance[Person::COV_YAWYAW_INDEX] = b.getCovariancePoseYawYaw();
+	}
+	Matrix2D cov;
+	fuseEstimates(
+		a.getPositionX(),
+		a.getPositionY(),
+		invertCovariance(a.getCovariancePoseXX(), a.getCovariancePoseXY(), a.getCovariancePoseYY()),
+		b.getPositionX(),
+		b.getPositionY(),
+		invertCovariance(b.getCovariancePoseXX(), b.getCovariancePoseXY(), b.getCovariancePoseYY()),
+		pose.pose.position.x,
+		pose.pose.position.y,
+		cov
+	);
+	setPlanarCovariance(pose, cov);
+
+	geometry_msgs::PoseWithCovariance vel;
+	vel.pose = a.getVelocity();
+	auto vel_cov = a.getCovarianceVelocity();
+	std::copy(vel_cov.cbegin(), vel_cov.cend(), vel.covariance.begin());
+	fuseEstimates(
+		a.getVelocityX(),
+		a.getVelocityY(),
+		invertCovariance(a.getCovarianceVelocityXX(), a.getCovarianceVelocityXY(), a.getCovarianceVelocityYY()),
+		b.getVelocityX(),
+		b.getVelocityY(),
+		invertCovariance(b.getCovarianceVelocityXX(), b.getCovarianceVelocityXY(), b.getCovarianceVelocityYY()),
+		vel.pose.position.x,
+		vel.pose.position.y,
+		cov
+	);
+	setPlanarCovariance(vel, cov);
+
+	return Person(
+		a.getName(),
+		pose,
+		vel,
+		std::max(a.getReliability(), b.getReliability()),
+		a.isOccluded() && b.isOccluded(),
+		a.isMatched() || b.isMatched(),
+		a.getDetectionID(),
+		std::max(a.getTrackAge(), b.getTrackAge()),
+		std::string()
+	);
+}
+
+PeopleFusion::PeopleFusion(): PeopleFusion(Parameters()) {}
+
+PeopleFusion::PeopleFusion(const Parameters& params):
+	params_(params),
+	index_(params.max_distance)
+{}
+
+void PeopleFusion::fuse(const std::vector<const Frame*>& sources, Frame& fused) {
+	fused.people.clear();
+	fused.groups.clear();
+	assignments_.resize(sources.size());
+	if (sources.empty()) {
+		fused.header = std_msgs::Header();
+		return;
+	}
+
+	fused.header = sources.front()->header;
+	std::unordered_set<std::string> names;
+	std::vector<bool> claimed;
+	for (size_t s = 0; s < sources.size(); s++) {
+		const auto& people = sources[s]->people;
+		auto& assignment = assignments_[s];
+		assignment.resize(people.size());
+		fused.header.stamp = std::max(fused.header.stamp, sources[s]->header.stamp);
+
+		// only people of the previous sources are candidates, each of them can be fused with one person per source
+		size_t num_fused = fused.people.size();
+		index_.build(fused.people);
+		claimed.assign(num_fused, false);
+		for (size_t i = 0; i < people.size(); i++) {
+			const auto& person = people[i];
+			index_.queryRadius(person.getPositionX(), person.getPositionY(), params_.max_distance, candidates_);
+			size_t best = NONE;
+			double best_distance_sq = params_.gate;
+			for (size_t j: candidates_) {
+				if (claimed[j]) {
+					continue;
+				}
+				const auto& other = fused.people[j];
+				auto inv = invertCovariance(
+					person.getCovariancePoseXX() + other.getCovariancePoseXX(),
+					person.getCovariancePoseXY() + other.getCovariancePoseXY(),
+					person.getCovariancePoseYY() + other.getCovariancePoseYY()
+				);
+				double dx = person.getPositionX() - other.getPositionX();
+				double dy = person.getPositionY() - other.getPositionY();
+				double distance_sq = inv.xx * dx * dx + 2.0 * inv.xy * dx * dy + inv.yy * dy * dy;
+				// ties are resolved by indices, so the result does not depend on the order of candidates
+				if (distance_sq < best_distance_sq || (distance_sq == best_distance_sq && j < best)) {
+					best = j;
+					best_distance_sq = distance_sq;
+				}
+			}
+
+			if (best != NONE) {
+				claimed[best] = true;
+				fused.people[best] = fusePeople(fused.people[best], person);
+				assignment[i] = best;
+				continue;
+			}
+
+			assignment[i] = fused.people.size();
+			fused.people.push_back(person);
+			fused.people.back().setGroupName(std::string());
+			if (!names.insert(person.getName()).second) {
+				// the ID was already taken by another person
+				std::string name = std::to_string(s) + "/" + person.getName();
+				names.insert(name);
+				fused.people.back().setName(name);
+			}
+		}
+	}
+
+	// groups of sources translated into IDs of fused people; relations reported by multiple sources are kept once
+	std::vector<std::tuple<std::string, std::string, double>> relations;
+	std::vector<std::pair<std::string, std::string>> links;
+	std::unordered_set<std::string> relations_seen;
+	std::unordered_map<std::string_view, size_t> index;
+	std::string key;
+	for (size_t s = 0; s < sources.size(); s++) {
+		const auto& people = sources[s]->people;
+		index.clear();
+		for (size_t i = 0; i < people.size(); i++) {
+			index.emplace(people[i].getName(), i);
+		}
+		auto to_fused = [&](const std::string& name) -> const std::string* {
+			auto it = index.find(name);
+			if (it == index.cend()) {
+				return nullptr;
+			}
+			return &fused.people[assignments_[s][it->second]].getName();
+		};
+
+		for (const auto& group: sources[s]->groups) {
+			const std::string* previous = nullptr;
+			for (const auto& member: group.getMembers()) {
+				const auto* name = to_fused(member.getName());
+				if (name == nullptr) {
+					continue;
+				}
+				if (previous != nullptr) {
+					links.emplace_back(*previous, *name);
+				}
+				previous = name;
+			}
+			for (const auto& relation: group.getSocialRelations()) {
+				const auto* a = to_fused(std::get<0>(relation));
+				const auto* b = to_fused(std::get<1>(relation));
+				if (a == nullptr || b == nullptr) {
+					continue;
+				}
+				// unordered pair
+				key = *a < *b ? *a + '\n' + *b : *b + '\n' + *a;
+				if (relations_seen.insert(key).second) {
+					relations.emplace_back(*a, *b, std::get<2>(relation));
+				}
+			}
+		}
+	}
+	// only links form groups
+	groupByRelations(fused.people, relations, links, std::numeric_limits<double>::infinity(), fused.groups);
+}
+
+} // namespace people_msgs_utils
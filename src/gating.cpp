@@ -0,0 +1,64 @@
+#include <people_msgs_utils/gating.h>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace people_msgs_utils {
+
+/// Number of people processed at once in the vectorized loop
+static constexpr size_t BLOCK_SIZE = 256;
+
+void gateMahalanobis(
+	const PeopleArrays& people,
+	const double* xs,
+	const double* ys,
+	size_t num_queries,
+	double threshold,
+	std::vector<GatingPair>& pairs
+) {
+	pairs.clear();
+	size_t num = people.size();
+	const double* x = people.x.data();
+	const double* y = people.y.data();
+	const double* inv_xx = people.cov_inv_xx.data();
+	const double* inv_xy = people.cov_inv_xy.data();
+	const double* inv_yy = people.cov_inv_yy.data();
+
+	// distances are stored in a local buffer, which cannot alias the inputs, so the loop is vectorized
+	std::array<double, BLOCK_SIZE> distance_sq;
+	for (size_t q = 0; q < num_queries; q++) {
+		const double qx = xs[q];
+		const double qy = ys[q];
+		for (size_t begin = 0; begin < num; begin += BLOCK_SIZE) {
+			size_t size = std::min(BLOCK_SIZE, num - begin);
+			for (size_t k = 0; k < size; k++) {
+				size_t i = begin + k;
+				double dx = qx - x[i];
+				double dy = qy - y[i];
+				distance_sq[k] = inv_xx[i] * dx * dx + 2.0 * inv_xy[i] * dx * dy + inv_yy[i] * dy * dy;
+			}
+			for (size_t k = 0; k < size; k++) {
+				if (distance_sq[k] <= threshold) {
+					pairs.push_back(GatingPair{q, begin + k, distance_sq[k]});
+				}
+			}
+		}
+	}
+}
+
+std::vector<GatingPair> gateMahalanobis(
+	const PeopleArrays& people,
+	const std::vector<double>& xs,
+	const std::vector<double>& ys,
+	double threshold
+) {
+	if (xs.size() != ys.size()) {
+		throw std::invalid_argument("gateMahalanobis: sizes of coordinate arrays differ");
+	}
+	std::vector<GatingPair> pairs;
+	gateMahalanobis(people, xs.data(), ys.data(), xs.size(), threshold, pairs);
+	return pairs;
+}
+
+} // namespace people_msgs_utils
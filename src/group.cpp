@@ -1,5 +1,6 @@
 #include <people_msgs_utils/group.h>
 #include <people_msgs_utils/utils.h>
+#include <people_msgs_utils/instrumentation.h>
 
 #include <social_nav_utils/ellipse_fitting.h>
 
@@ -11,16 +12,10 @@ Group::Group(
 	const std::vector<Person>& members,
 	const std::vector<std::string>& member_ids,
 	const std::vector<std::tuple<std::string, std::string, double>>& relations,
-	const geometry_msgs::Point& center_of_gravity
-):
-	group_id_(id),
-	age_(age),
-	members_(members),
-	member_ids_(member_ids),
-	social_relations_(relations),
-	center_of_gravity_(center_of_gravity)
-{
-	computeSpatialModel();
+	const geometry_msgs::Point& center_of_gravity,
+	const Ellipse* ellipse
+) {
+	assign(id, age, members, member_ids, relations, center_of_gravity, ellipse);
 }
 
 Group::Group(
@@ -28,27 +23,66 @@ Group::Group(
 	const std::vector<Person>& members,
 	std::vector<std::string> tagnames,
 	std::vector<std::string> tags
-):
-	group_id_(id),
-	members_(members)
-{
+) {
+	assign(id, members, tagnames, tags);
+}
+
+Group::Group(
+	const std::string& id,
+	const std::vector<Person>& members,
+	const std::vector<std::string_view>& tagnames,
+	const std::vector<std::string_view>& tags
+) {
+	assign(id, members, tagnames, tags);
+}
+
+void Group::assign(
+	const std::string& id,
+	unsigned long int age,
+	const std::vector<Person>& members,
+	const std::vector<std::string>& member_ids,
+	const std::vector<std::tuple<std::string, std::string, double>>& relations,
+	const geometry_msgs::Point& center_of_gravity,
+	const Ellipse* ellipse
+) {
+	// copy-assignments reuse memory of the existing elements
+	group_id_ = id;
+	age_ = age;
+	members_ = members;
+	member_ids_ = member_ids;
+	social_relations_ = relations;
+	center_of_gravity_ = center_of_gravity;
+	computeSpatialModel(ellipse);
+}
+
+template <typename StringT>
+void Group::assign(
+	const std::string& id,
+	const std::vector<Person>& members,
+	const std::vector<StringT>& tagnames,
+	const std::vector<StringT>& tags,
+	const Ellipse* ellipse
+) {
+	group_id_ = id;
+	age_ = 0;
+	members_ = members;
+	center_of_gravity_ = geometry_msgs::Point();
 	parseTags(tagnames, tags);
-	computeSpatialModel();
+	computeSpatialModel(ellipse);
 }
 
 void Group::transform(const geometry_msgs::TransformStamped& transform) {
+	PEOPLE_MSGS_UTILS_RECORD_SCOPE(instrumentation::Stage::TRANSFORM_GROUP, members_.size());
 	// transform members and recalculate spatial model
 	for (auto& member: members_) {
 		member.transform(transform);
 	}
 
-	// transform center of gravity
+	// transform center of gravity (header of the input is not used by tf2::doTransform)
 	geometry_msgs::PointStamped cog_in;
-	cog_in.header.frame_id = transform.header.frame_id;
 	cog_in.point = center_of_gravity_;
 
 	geometry_msgs::PointStamped cog_out;
-	cog_out.header.frame_id = transform.child_frame_id;
 	tf2::doTransform(cog_in, cog_out, transform);
 
 	// overwrite center of gravity (not calculated in @ref computeSpatialModel)
@@ -58,6 +92,100 @@ void Group::transform(const geometry_msgs::TransformStamped& transform) {
 	computeSpatialModel();
 }
 
+void Group::moveRigidly(double x, double y, double yaw) {
+	double c = std::cos(yaw);
+	double s = std::sin(yaw);
+	auto rotate = [c, s](double& px, double& py) {
+		double rx = c * px - s * py;
+		py = s * px + c * py;
+		px = rx;
+	};
+
+	for (auto& member: members_) {
+		double px = member.getPositionX();
+		double py = member.getPositionY();
+		double vx = member.getVelocityX();
+		double vy = member.getVelocityY();
+		rotate(px, py);
+		rotate(vx, vy);
+		member.setPlanarState(px + x, py + y, member.getOrientationYaw() + yaw, vx, vy);
+		member.rotateCovariances(yaw);
+	}
+
+	rotate(center_of_gravity_.x, center_of_gravity_.y);
+	center_of_gravity_.x += x;
+	center_of_gravity_.y += y;
+
+	// spatial model
+	double model_yaw = getOrientationYaw() + yaw;
+	rotate(pose_.pose.position.x, pose_.pose.position.y);
+	pose_.pose.position.x += x;
+	pose_.pose.position.y += y;
+	tf2::Quaternion quat;
+	quat.setRPY(0, 0, model_yaw);
+	pose_.pose.orientation.x = quat.getX();
+	pose_.pose.orientation.y = quat.getY();
+	pose_.pose.orientation.z = quat.getZ();
+	pose_.pose.orientation.w = quat.getW();
+
+	Person::rotatePlanarCovariance(pose_.covariance, yaw);
+}
+
+void Group::retainMembers(const std::function<bool(const std::string&)>& is_tracked) {
+	// keep only member IDs that are tracked
+	member_ids_.erase(
+		std::remove_if(
+			member_ids_.begin(),
+			member_ids_.end(),
+			[&](const std::string& member_id) {
+				return !is_tracked(member_id);
+			}
+		),
+		member_ids_.end()
+	);
+	auto is_member_id = [this](const std::string& id) {
+		return std::find(member_ids_.cbegin(), member_ids_.cend(), id) != member_ids_.cend();
+	};
+	// erase relations with inexisting member IDs
+	social_relations_.erase(
+		std::remove_if(
+			social_relations_.begin(),
+			social_relations_.end(),
+			[&](const std::tuple<std::string, std::string, double>& rel) {
+				return !is_member_id(std::get<0>(rel)) || !is_member_id(std::get<1>(rel));
+			}
+		),
+		social_relations_.end()
+	);
+	// keep only valid members
+	size_t members_count = members_.size();
+	members_.erase(
+		std::remove_if(
+			members_.begin(),
+			members_.end(),
+			[&](const Person& member) {
+				return !is_member_id(member.getName());
+			}
+		),
+		members_.end()
+	);
+	// recompute center of gravity as with changed members it may be outdated
+	center_of_gravity_ = geometry_msgs::Point();
+	for (const auto& member: members_) {
+		center_of_gravity_.x += member.getPositionX();
+		center_of_gravity_.y += member.getPositionY();
+		center_of_gravity_.z += member.getPositionZ();
+	}
+	center_of_gravity_.x /= members_.size();
+	center_of_gravity_.y /= members_.size();
+	center_of_gravity_.z /= members_.size();
+
+	// the spatial model depends on members only
+	if (members_.size() != members_count) {
+		computeSpatialModel();
+	}
+}
+
 bool Group::hasMember(const std::string& person_id) const {
 	return std::find_if(
 		members_.begin(),
@@ -103,17 +231,24 @@ double Group::getReliability() const {
 	return reliability_total / static_cast<double>(members_.size());
 }
 
-bool Group::parseTags(const std::vector<std::string>& tagnames, const std::vector<std::string>& tags) {
+template <typename StringT>
+bool Group::parseTags(const std::vector<StringT>& tagnames, const std::vector<StringT>& tags) {
 	if ((tagnames.size() != tags.size()) || tagnames.empty()) {
 		// no additional data can be retrieved
+		member_ids_.clear();
+		social_relations_.clear();
 		return false;
 	}
 
+	// already existing elements of containers are overwritten to reuse their memory, the rest is erased at the end
+	size_t member_ids_count = 0;
+	size_t relations_count = 0;
+
 	// create iterators for tagnames and tags
-	const std::string DELIMITER = " ";
-	std::vector<std::string>::const_iterator tag_value_it = tags.begin();
+	const std::string_view DELIMITER = " ";
+	auto tag_value_it = tags.cbegin();
 	for (
-		std::vector<std::string>::const_iterator tag_it = tagnames.begin();
+		auto tag_it = tagnames.cbegin();
 		tag_it != tagnames.end();
 		tag_it++
 	) {
@@ -121,42 +256,96 @@ bool Group::parseTags(const std::vector<std::string>& tagnames, const std::vecto
 			// primary key for later association
 			group_id_ = *tag_value_it;
 		} else if (tag_it->find("group_age") != std::string::npos) {
-			age_ = static_cast<unsigned int>(std::stoul(*tag_value_it));
+			age_ = static_cast<unsigned int>(parseStringUnsigned(*tag_value_it));
 		} else if (tag_it->find("group_track_ids") != std::string::npos) {
-			member_ids_ = parseString<std::string>(*tag_value_it, DELIMITER);
+			member_ids_count = 0;
+			forEachToken(*tag_value_it, DELIMITER, [&](std::string_view token) {
+				if (member_ids_count < member_ids_.size()) {
+					member_ids_[member_ids_count].assign(token.data(), token.size());
+				} else {
+					member_ids_.emplace_back(token);
+				}
+				member_ids_count++;
+			});
 		} else if (tag_it->find("group_center_of_gravity") != std::string::npos) {
-			auto pos_v = parseString<double>(*tag_value_it, DELIMITER);
-			if (pos_v.size() == 3) {
+			std::array<double, 3> pos_v;
+			if (parseString<double>(*tag_value_it, DELIMITER, pos_v.data(), pos_v.size()) == 3) {
 				center_of_gravity_.x = pos_v.at(0);
 				center_of_gravity_.y = pos_v.at(1);
 				center_of_gravity_.z = pos_v.at(2);
 			}
 		} else if (tag_it->find("social_relations") != std::string::npos) {
-			auto relation_v = parseString<std::string>(*tag_value_it, DELIMITER);
+			size_t tokens = 0;
+			forEachToken(*tag_value_it, DELIMITER, [&tokens](std::string_view) { tokens++; });
 			// relations are expressed as triplets: ID, ID, strength
-			if (!relation_v.empty() && relation_v.size() % 3 == 0) {
-				for (
-					auto it = relation_v.cbegin();
-					it != relation_v.cend();
-					it = it + 3
-				) {
-					std::string track_id1 = *it;
-					std::string track_id2 = *(it+1);
-					double strength = std::stod(*(it+2));
-					social_relations_.push_back(std::make_tuple(track_id1, track_id2, strength));
-				}
+			if (tokens != 0 && tokens % 3 == 0) {
+				std::array<std::string_view, 3> triplet;
+				size_t index = 0;
+				forEachToken(*tag_value_it, DELIMITER, [&](std::string_view token) {
+					triplet[index++] = token;
+					if (index < 3) {
+						return;
+					}
+					index = 0;
+					double strength = parseStringDouble(triplet[2]);
+					if (relations_count < social_relations_.size()) {
+						auto& relation = social_relations_[relations_count];
+						std::get<0>(relation).assign(triplet[0].data(), triplet[0].size());
+						std::get<1>(relation).assign(triplet[1].data(), triplet[1].size());
+						std::get<2>(relation) = strength;
+					} else {
+						social_relations_.emplace_back(std::string(triplet[0]), std::string(triplet[1]), strength);
+					}
+					relations_count++;
+				});
 			}
 		}
 		tag_value_it++;
 	}
+	member_ids_.erase(member_ids_.begin() + member_ids_count, member_ids_.end());
+	social_relations_.erase(social_relations_.begin() + relations_count, social_relations_.end());
 	return true;
 }
 
-void Group::computeSpatialModel() {
-	if (getMembers().empty()) {
+// explicit instantiations of the tag parsing methods
+template void Group::assign<std::string>(
+	const std::string&,
+	const std::vector<Person>&,
+	const std::vector<std::string>&,
+	const std::vector<std::string>&,
+	const Ellipse*
+);
+template void Group::assign<std::string_view>(
+	const std::string&,
+	const std::vector<Person>&,
+	const std::vector<std::string_view>&,
+	const std::vector<std::string_view>&,
+	const Ellipse*
+);
+template bool Group::parseTags<std::string>(const std::vector<std::string>&, const std::vector<std::string>&);
+template bool Group::parseTags<std::string_view>(
+	const std::vector<std::string_view>&,
+	const std::vector<std::string_view>&
+);
+
+Group::Ellipse Group::getEllipse() const {
+	Ellipse ellipse;
+	ellipse.center_x = pose_.pose.position.x;
+	ellipse.center_y = pose_.pose.position.y;
+	ellipse.yaw = getOrientationYaw();
+	ellipse.span_x = span_.x;
+	ellipse.span_y = span_.y;
+	return ellipse;
+}
+
+void Group::computeSpatialModel(const Ellipse* ellipse) {
+	PEOPLE_MSGS_UTILS_RECORD_SCOPE(instrumentation::Stage::SPATIAL_MODEL, members_.size());
+	if (members_.empty()) {
 		// spatial model cannot be defined for a group without members
 		pose_.pose.position.x = center_of_gravity_.x;
 		pose_.pose.position.y = center_of_gravity_.y;
+		pose_.pose.position.z = 0.0;
+		pose_.pose.orientation = geometry_msgs::Quaternion();
 		pose_.pose.orientation.w = 1.0;
 		pose_.covariance.assign(COVARIANCE_UNKNOWN);
 		span_.x = 0.0;
@@ -165,21 +354,35 @@ void Group::computeSpatialModel() {
 	}
 
 	// Approximate O-space with an ellipse
-	// - start with collecting points (member positions)
-	std::vector<double> ospace_x;
-	std::vector<double> ospace_y;
-	for (const auto& person: getMembers()) {
-	  ospace_x.push_back(person.getPositionX());
-	  ospace_y.push_back(person.getPositionY());
+	Ellipse fitted;
+	if (ellipse == nullptr) {
+		// - start with collecting points (member positions); buffers are reused by subsequent calls in the thread
+		static thread_local std::vector<double> ospace_x;
+		static thread_local std::vector<double> ospace_y;
+		ospace_x.clear();
+		ospace_y.clear();
+		for (const auto& person: members_) {
+		  ospace_x.push_back(person.getPositionX());
+		  ospace_y.push_back(person.getPositionY());
+		}
+		PEOPLE_MSGS_UTILS_RECORD_START(record_fitting, instrumentation::Stage::ELLIPSE_FITTING);
+		social_nav_utils::EllipseFitting fitting(ospace_x, ospace_y);
+		PEOPLE_MSGS_UTILS_RECORD_STOP(record_fitting, ospace_x.size());
+
+		fitted.center_x = fitting.getCenterX();
+		fitted.center_y = fitting.getCenterY();
+		fitted.yaw = fitting.getOrientation();
+		fitted.span_x = 2.0 * fitting.getSemiAxisMajor();
+		fitted.span_y = 2.0 * fitting.getSemiAxisMinor();
+		ellipse = &fitted;
 	}
-	social_nav_utils::EllipseFitting ellipse(ospace_x, ospace_y);
 
 	// store
-	pose_.pose.position.x = ellipse.getCenterX();
-	pose_.pose.position.y = ellipse.getCenterY();
+	pose_.pose.position.x = ellipse->center_x;
+	pose_.pose.position.y = ellipse->center_y;
 	pose_.pose.position.z = 0.0;
 	tf2::Quaternion quat;
-	quat.setRPY(0.0, 0.0, ellipse.getOrientation());
+	quat.setRPY(0.0, 0.0, ellipse->yaw);
 	pose_.pose.orientation.x = quat.getX();
 	pose_.pose.orientation.y = quat.getY();
 	pose_.pose.orientation.z = quat.getZ();
@@ -190,20 +393,16 @@ void Group::computeSpatialModel() {
 	 * Prepare Gaussian representation of the O-space's shape.
 	 */
 	// find uncertainty of the O-space mean position estimation based on member variances
-	std::vector<double> variances_p_xx;
-	std::vector<double> variances_p_xy;
-	std::vector<double> variances_p_yx;
-	std::vector<double> variances_p_yy;
-	for (const auto& person: getMembers()) {
-	  variances_p_xx.push_back(person.getCovariancePoseXX());
-	  variances_p_xy.push_back(person.getCovariancePoseXY());
-	  variances_p_yx.push_back(person.getCovariancePoseYX());
-	  variances_p_yy.push_back(person.getCovariancePoseYY());
+	double variance_p_xx = members_.front().getCovariancePoseXX();
+	double variance_p_xy = members_.front().getCovariancePoseXY();
+	double variance_p_yx = members_.front().getCovariancePoseYX();
+	double variance_p_yy = members_.front().getCovariancePoseYY();
+	for (const auto& person: members_) {
+	  variance_p_xx = std::max(variance_p_xx, person.getCovariancePoseXX());
+	  variance_p_xy = std::max(variance_p_xy, person.getCovariancePoseXY());
+	  variance_p_yx = std::max(variance_p_yx, person.getCovariancePoseYX());
+	  variance_p_yy = std::max(variance_p_yy, person.getCovariancePoseYY());
 	}
-	double variance_p_xx = *std::max_element(variances_p_xx.begin(), variances_p_xx.end());
-	double variance_p_xy = *std::max_element(variances_p_xy.begin(), variances_p_xy.end());
-	double variance_p_yx = *std::max_element(variances_p_yx.begin(), variances_p_yx.end());
-	double variance_p_yy = *std::max_element(variances_p_yy.begin(), variances_p_yy.end());
 	double variance_p_xyyx = std::max(variance_p_xy, variance_p_yx);
 
 	// store
@@ -218,8 +417,8 @@ void Group::computeSpatialModel() {
 	pose_.covariance.at(Person::COV_YAWYAW_INDEX) = 1.0 / COVARIANCE_UNKNOWN;
 
 	// store the size of the ellipse
-	span_.x = 2.0 * ellipse.getSemiAxisMajor();
-	span_.y = 2.0 * ellipse.getSemiAxisMinor();
+	span_.x = ellipse->span_x;
+	span_.y = ellipse->span_y;
 }
 
 } // namespace people_msgs_utils
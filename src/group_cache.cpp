@@ -0,0 +1,284 @@
+#include <people_msgs_utils/group_cache.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace people_msgs_utils {
+
+/// Returns the index of @ref name in the sorted @ref names or GroupCache::NONE
+static size_t findSorted(const std::vector<std::string>& names, const std::string& name) {
+	auto it = std::lower_bound(names.cbegin(), names.cend(), name);
+	if (it == names.cend() || *it != name) {
+		return GroupCache::NONE;
+	}
+	return static_cast<size_t>(it - names.cbegin());
+}
+
+GroupCache::GroupCache(): GroupCache(Parameters()) {}
+
+GroupCache::GroupCache(const Parameters& params): params_(params) {}
+
+bool GroupCache::findEllipse(
+	const std::string& name,
+	const std::vector<Person>& members,
+	Group::Ellipse& ellipse
+) const {
+	size_t index = match(name, members, std::vector<bool>());
+	if (index == NONE) {
+		return false;
+	}
+	RigidMotion motion;
+	return derive(entries_[index], members, ellipse, motion) != EllipseSource::FITTED;
+}
+
+void GroupCache::update(const Groups& groups) {
+	// matching is done before entries are modified, as the indexes refer to their strings
+	size_t entries_count = entries_.size();
+	std::vector<bool> claimed(entries_count, false);
+	std::vector<size_t> matches(groups.size(), NONE);
+	for (size_t g = 0; g < groups.size(); g++) {
+		matches[g] = match(groups[g].getName(), groups[g].getMembers(), claimed);
+		if (matches[g] != NONE) {
+			claimed[matches[g]] = true;
+		}
+	}
+
+	auto store = [](Entry& entry, const Group& group) {
+		const auto& members = group.getMembers();
+		entry.member_names.resize(members.size());
+		entry.member_x.resize(members.size());
+		entry.member_y.resize(members.size());
+		for (size_t k = 0; k < members.size(); k++) {
+			entry.member_names[k] = members[k].getName();
+			entry.member_x[k] = members[k].getPositionX();
+			entry.member_y[k] = members[k].getPositionY();
+		}
+		// insertion sort by names; groups are small
+		for (size_t k = 1; k < members.size(); k++) {
+			for (size_t j = k; j > 0 && entry.member_names[j] < entry.member_names[j - 1]; j--) {
+				std::swap(entry.member_names[j], entry.member_names[j - 1]);
+				std::swap(entry.member_x[j], entry.member_x[j - 1]);
+				std::swap(entry.member_y[j], entry.member_y[j - 1]);
+			}
+		}
+		entry.ellipse = group.getEllipse();
+		entry.motion = RigidMotion();
+	};
+
+	for (size_t g = 0; g < groups.size(); g++) {
+		const auto& group = groups[g];
+		if (matches[g] == NONE) {
+			Entry entry;
+			entry.track.id = group.getName();
+			entry.track.name = group.getName();
+			entry.track.age = 0;
+			entry.track.continuity = 1;
+			entry.track.missed = 0;
+			entry.track.ellipse_source = EllipseSource::FITTED;
+			store(entry, group);
+			entries_.push_back(std::move(entry));
+			continue;
+		}
+
+		auto& entry = entries_[matches[g]];
+		Group::Ellipse ellipse;
+		RigidMotion motion;
+		auto source = derive(entry, group.getMembers(), ellipse, motion);
+		entry.track.name = group.getName();
+		entry.track.age++;
+		entry.track.continuity++;
+		entry.track.missed = 0;
+		entry.track.ellipse_source = source;
+		// positions at fitting stay the reference of derived ellipses, so that deformations do not add up
+		if (source == EllipseSource::FITTED) {
+			store(entry, group);
+		} else {
+			entry.motion = motion;
+		}
+	}
+
+	for (size_t i = 0; i < entries_count; i++) {
+		if (claimed[i]) {
+			continue;
+		}
+		auto& track = entries_[i].track;
+		track.age++;
+		track.continuity = 0;
+		track.missed++;
+	}
+	entries_.erase(
+		std::remove_if(
+			entries_.begin(),
+			entries_.end(),
+			[this](const Entry& entry) {
+				return entry.track.missed > params_.max_missed_frames;
+			}
+		),
+		entries_.end()
+	);
+
+	reindex();
+}
+
+const GroupCache::Track* GroupCache::find(const std::string& name) const {
+	auto it = by_name_.find(name);
+	if (it == by_name_.cend()) {
+		return nullptr;
+	}
+	return &entries_[it->second].track;
+}
+
+void GroupCache::clear() {
+	by_name_.clear();
+	by_member_.clear();
+	entries_.clear();
+}
+
+size_t GroupCache::match(
+	const std::string& name,
+	const std::vector<Person>& members,
+	const std::vector<bool>& claimed
+) const {
+	auto is_free = [&claimed](size_t index) {
+		return index < claimed.size() ? !claimed[index] : true;
+	};
+
+	auto it = by_name_.find(name);
+	if (it != by_name_.cend() && is_free(it->second)) {
+		return it->second;
+	}
+
+	// the ID has changed: the group with the largest overlap of members
+	size_t best = NONE;
+	double best_overlap = params_.min_overlap;
+	for (const auto& member: members) {
+		auto it_member = by_member_.find(member.getName());
+		if (it_member == by_member_.cend() || !is_free(it_member->second) || it_member->second == best) {
+			continue;
+		}
+		const auto& entry = entries_[it_member->second];
+		size_t common = 0;
+		for (const auto& other: members) {
+			if (findSorted(entry.member_names, other.getName()) != NONE) {
+				common++;
+			}
+		}
+		double overlap = static_cast<double>(common)
+			/ static_cast<double>(members.size() + entry.member_names.size() - common);
+		if (overlap >= best_overlap) {
+			best = it_member->second;
+			best_overlap = overlap;
+		}
+	}
+	return best;
+}
+
+/// Returns the ellipse moved by the rigid motion (rotation by yaw with cosine @ref c and sine @ref s, translation)
+static Group::Ellipse moveEllipse(const Group::Ellipse& ellipse, double c, double s, double x, double y, double yaw) {
+	Group::Ellipse moved = ellipse;
+	moved.center_x = c * ellipse.center_x - s * ellipse.center_y + x;
+	moved.center_y = s * ellipse.center_x + c * ellipse.center_y + y;
+	moved.yaw = ellipse.yaw + yaw;
+	return moved;
+}
+
+GroupCache::EllipseSource GroupCache::derive(
+	const Entry& entry,
+	const std::vector<Person>& members,
+	Group::Ellipse& ellipse,
+	RigidMotion& motion
+) const {
+	size_t num = members.size();
+	if (num == 0 || num != entry.member_names.size()) {
+		return EllipseSource::FITTED;
+	}
+
+	// members must be the same; fitted positions moved as in the last frame are compared with the current ones
+	double tolerance_sq = params_.position_tolerance * params_.position_tolerance;
+	double c = std::cos(entry.motion.yaw);
+	double s = std::sin(entry.motion.yaw);
+	double displacement_sq_max = 0.0;
+	for (const auto& member: members) {
+		size_t k = findSorted(entry.member_names, member.getName());
+		if (k == NONE) {
+			return EllipseSource::FITTED;
+		}
+		double dx = c * entry.member_x[k] - s * entry.member_y[k] + entry.motion.x - member.getPositionX();
+		double dy = s * entry.member_x[k] + c * entry.member_y[k] + entry.motion.y - member.getPositionY();
+		displacement_sq_max = std::max(displacement_sq_max, dx * dx + dy * dy);
+	}
+	if (displacement_sq_max <= tolerance_sq) {
+		motion = entry.motion;
+		ellipse = moveEllipse(entry.ellipse, c, s, motion.x, motion.y, motion.yaw);
+		return EllipseSource::REUSED;
+	}
+
+	// centroids of the fitted (source) and current (target) positions
+	double sx = 0.0;
+	double sy = 0.0;
+	double tx = 0.0;
+	double ty = 0.0;
+	for (const auto& member: members) {
+		size_t k = findSorted(entry.member_names, member.getName());
+		sx += entry.member_x[k];
+		sy += entry.member_y[k];
+		tx += member.getPositionX();
+		ty += member.getPositionY();
+	}
+	sx /= num;
+	sy /= num;
+	tx /= num;
+	ty /= num;
+
+	// least-squares rotation between the centered point sets (2D Procrustes)
+	double dot = 0.0;
+	double cross = 0.0;
+	for (const auto& member: members) {
+		size_t k = findSorted(entry.member_names, member.getName());
+		double ax = entry.member_x[k] - sx;
+		double ay = entry.member_y[k] - sy;
+		double bx = member.getPositionX() - tx;
+		double by = member.getPositionY() - ty;
+		dot += ax * bx + ay * by;
+		cross += ax * by - ay * bx;
+	}
+	double yaw = (dot != 0.0 || cross != 0.0) ? std::atan2(cross, dot) : 0.0;
+	c = std::cos(yaw);
+	s = std::sin(yaw);
+	double x = tx - (c * sx - s * sy);
+	double y = ty - (s * sx + c * sy);
+
+	// the motion since fitting must be rigid up to the tolerance
+	for (const auto& member: members) {
+		size_t k = findSorted(entry.member_names, member.getName());
+		double dx = c * entry.member_x[k] - s * entry.member_y[k] + x - member.getPositionX();
+		double dy = s * entry.member_x[k] + c * entry.member_y[k] + y - member.getPositionY();
+		if (dx * dx + dy * dy > tolerance_sq) {
+			return EllipseSource::FITTED;
+		}
+	}
+
+	motion = RigidMotion{x, y, yaw};
+	ellipse = moveEllipse(entry.ellipse, c, s, x, y, yaw);
+	return EllipseSource::MOVED;
+}
+
+void GroupCache::reindex() {
+	by_name_.clear();
+	by_member_.clear();
+	// names shared by multiple entries refer to the most recently seen one
+	auto insert = [this](std::unordered_map<std::string_view, size_t>& map, const std::string& key, size_t index) {
+		auto [it, inserted] = map.emplace(key, index);
+		if (!inserted && entries_[it->second].track.missed > entries_[index].track.missed) {
+			it->second = index;
+		}
+	};
+	for (size_t i = 0; i < entries_.size(); i++) {
+		insert(by_name_, entries_[i].track.name, i);
+		for (const auto& member: entries_[i].member_names) {
+			insert(by_member_, member, i);
+		}
+	}
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,289 @@
+#include <people_msgs_utils/grouping.h>
+#include <people_msgs_utils/utils.h>
+
+#include <array>
+#include <limits>
+#include <numeric>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace people_msgs_utils {
+
+/// Marks elements without an assigned component
+static constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+DisjointSets::DisjointSets(size_t count) {
+	reset(count);
+}
+
+void DisjointSets::reset(size_t count) {
+	parents_.resize(count);
+	std::iota(parents_.begin(), parents_.end(), 0);
+	sizes_.assign(count, 1);
+}
+
+size_t DisjointSets::find(size_t element) {
+	size_t root = element;
+	while (parents_[root] != root) {
+		root = parents_[root];
+	}
+	// path compression
+	while (parents_[element] != root) {
+		size_t parent = parents_[element];
+		parents_[element] = root;
+		element = parent;
+	}
+	return root;
+}
+
+bool DisjointSets::unite(size_t a, size_t b) {
+	a = find(a);
+	b = find(b);
+	if (a == b) {
+		return false;
+	}
+	// union by size
+	if (sizes_[a] < sizes_[b]) {
+		std::swap(a, b);
+	}
+	parents_[b] = a;
+	sizes_[a] += sizes_[b];
+	return true;
+}
+
+void groupByRelations(
+	People& people,
+	const std::vector<std::tuple<std::string, std::string, double>>& relations,
+	const std::vector<std::pair<std::string, std::string>>& links,
+	double threshold,
+	Groups& groups
+) {
+	size_t num = people.size();
+	std::unordered_map<std::string_view, size_t> index;
+	index.reserve(num);
+	for (size_t i = 0; i < num; i++) {
+		index.emplace(people[i].getName(), i);
+	}
+	auto find_person = [&index](std::string_view name) {
+		auto it = index.find(name);
+		return it == index.cend() ? NONE : it->second;
+	};
+
+	DisjointSets sets(num);
+	// people assigned to the same group
+	{
+		std::unordered_map<std::string_view, size_t> group_members;
+		for (size_t i = 0; i < num; i++) {
+			if (!people[i].isAssignedToGroup()) {
+				continue;
+			}
+			auto [it, inserted] = group_members.emplace(people[i].getGroupName(), i);
+			if (!inserted) {
+				sets.unite(it->second, i);
+			}
+		}
+	}
+	for (const auto& [a, b]: links) {
+		size_t ia = find_person(a);
+		size_t ib = find_person(b);
+		if (ia != NONE && ib != NONE) {
+			sets.unite(ia, ib);
+		}
+	}
+	for (const auto& relation: relations) {
+		size_t ia = find_person(std::get<0>(relation));
+		size_t ib = find_person(std::get<1>(relation));
+		if (ia != NONE && ib != NONE && std::get<2>(relation) >= threshold) {
+			sets.unite(ia, ib);
+		}
+	}
+
+	// components with at least 2 people, numbered in the order of their first members
+	std::vector<size_t> component_of_root(num, NONE);
+	std::vector<size_t> component(num, NONE);
+	size_t components = 0;
+	for (size_t i = 0; i < num; i++) {
+		if (sets.getSize(i) < 2) {
+			continue;
+		}
+		size_t root = sets.find(i);
+		if (component_of_root[root] == NONE) {
+			component_of_root[root] = components++;
+		}
+		component[i] = component_of_root[root];
+	}
+
+	// members of components stored contiguously (counting sort), in the order of people
+	std::vector<size_t> member_start(components + 1, 0);
+	for (size_t i = 0; i < num; i++) {
+		if (component[i] != NONE) {
+			member_start[component[i] + 1]++;
+		}
+	}
+	std::partial_sum(member_start.begin(), member_start.end(), member_start.begin());
+	std::vector<size_t> members(member_start.back());
+	{
+		std::vector<size_t> next(member_start.cbegin(), member_start.cend() - 1);
+		for (size_t i = 0; i < num; i++) {
+			if (component[i] != NONE) {
+				members[next[component[i]]++] = i;
+			}
+		}
+	}
+
+	// relations within components, stored in the same way
+	std::vector<size_t> relation_start(components + 1, 0);
+	std::vector<size_t> relation_component(relations.size(), NONE);
+	for (size_t r = 0; r < relations.size(); r++) {
+		size_t ia = find_person(std::get<0>(relations[r]));
+		size_t ib = find_person(std::get<1>(relations[r]));
+		if (ia != NONE && ib != NONE && component[ia] != NONE && component[ia] == component[ib]) {
+			relation_component[r] = component[ia];
+			relation_start[component[ia] + 1]++;
+		}
+	}
+	std::partial_sum(relation_start.begin(), relation_start.end(), relation_start.begin());
+	std::vector<size_t> component_relations(relation_start.back());
+	{
+		std::vector<size_t> next(relation_start.cbegin(), relation_start.cend() - 1);
+		for (size_t r = 0; r < relations.size(); r++) {
+			if (relation_component[r] != NONE) {
+				component_relations[next[relation_component[r]]++] = r;
+			}
+		}
+	}
+
+	// names of groups: the group of the first assigned member (unique, as people of a group share a component)
+	std::vector<std::string> group_names(components);
+	std::unordered_set<std::string> names_taken;
+	for (size_t c = 0; c < components; c++) {
+		for (size_t k = member_start[c]; k < member_start[c + 1]; k++) {
+			if (people[members[k]].isAssignedToGroup()) {
+				group_names[c] = people[members[k]].getGroupName();
+				names_taken.insert(group_names[c]);
+				break;
+			}
+		}
+	}
+	// otherwise the first member, made unique if the ID is also a name of another group
+	for (size_t c = 0; c < components; c++) {
+		if (!group_names[c].empty()) {
+			continue;
+		}
+		const auto& id = people[members[member_start[c]]].getName();
+		group_names[c] = id;
+		for (size_t suffix = 1; !names_taken.insert(group_names[c]).second; suffix++) {
+			group_names[c] = id + "_" + std::to_string(suffix);
+		}
+	}
+	// names were copied, as group names of people are overwritten here
+	for (size_t i = 0; i < num; i++) {
+		people[i].setGroupName(component[i] == NONE ? std::string() : group_names[component[i]]);
+	}
+
+	groups.clear();
+	groups.reserve(components);
+	for (size_t c = 0; c < components; c++) {
+		std::vector<Person> group_members;
+		std::vector<std::string> member_ids;
+		geometry_msgs::Point cog;
+		for (size_t k = member_start[c]; k < member_start[c + 1]; k++) {
+			const auto& person = people[members[k]];
+			group_members.push_back(person);
+			member_ids.push_back(person.getName());
+			cog.x += person.getPositionX();
+			cog.y += person.getPositionY();
+			cog.z += person.getPositionZ();
+		}
+		cog.x /= group_members.size();
+		cog.y /= group_members.size();
+		cog.z /= group_members.size();
+
+		std::vector<std::tuple<std::string, std::string, double>> group_relations;
+		for (size_t k = relation_start[c]; k < relation_start[c + 1]; k++) {
+			group_relations.push_back(relations[component_relations[k]]);
+		}
+		groups.emplace_back(group_names[c], 0, group_members, member_ids, group_relations, cog);
+	}
+}
+
+void groupByRelations(
+	People& people,
+	const std::vector<std::tuple<std::string, std::string, double>>& relations,
+	double threshold,
+	Groups& groups
+) {
+	groupByRelations(people, relations, std::vector<std::pair<std::string, std::string>>(), threshold, groups);
+}
+
+/// Calls @ref fun with each relation of a social_relations tag (triplets: ID, ID, strength), as Group does
+template <typename Fun>
+static void forEachRelation(std::string_view tag, Fun fun) {
+	const std::string_view DELIMITER = " ";
+	size_t tokens = 0;
+	forEachToken(tag, DELIMITER, [&tokens](std::string_view) { tokens++; });
+	if (tokens == 0 || tokens % 3 != 0) {
+		return;
+	}
+	std::array<std::string_view, 3> triplet;
+	size_t index = 0;
+	forEachToken(tag, DELIMITER, [&](std::string_view token) {
+		triplet[index++] = token;
+		if (index == 3) {
+			index = 0;
+			fun(triplet[0], triplet[1], parseStringDouble(triplet[2]));
+		}
+	});
+}
+
+void createFromPeopleByRelations(
+	const std::vector<people_msgs::Person>& people,
+	Frame& frame,
+	double threshold,
+	const ParallelFor& parallel_for
+) {
+	// groups are formed from relations only, so the group_id-based ones are not created at all
+	frame.header = std_msgs::Header();
+	createPeople(people, frame.people, parallel_for);
+
+	// relations and member lists are parsed from tags as for regular groups; duplicates (e.g., the same relations
+	// published with each member) are skipped
+	std::vector<std::tuple<std::string, std::string, double>> relations;
+	std::vector<std::pair<std::string, std::string>> links;
+	std::unordered_set<std::string> relations_seen;
+	std::string key;
+	std::string_view member_prev;
+	for (const auto& person: people) {
+		// Group ignores tags of people with inconsistent tags
+		if (person.tagnames.size() != person.tags.size()) {
+			continue;
+		}
+		for (size_t t = 0; t < person.tagnames.size(); t++) {
+			const auto& tagname = person.tagnames[t];
+			const auto& tag = person.tags[t];
+			if (tagname.find("group_track_ids") != std::string::npos) {
+				member_prev = std::string_view();
+				forEachToken(tag, " ", [&](std::string_view member) {
+					if (!member_prev.empty()) {
+						links.emplace_back(std::string(member_prev), std::string(member));
+					}
+					member_prev = member;
+				});
+			} else if (tagname.find("social_relations") != std::string::npos) {
+				forEachRelation(tag, [&](std::string_view a, std::string_view b, double strength) {
+					// unordered pair
+					key.assign(a < b ? a : b);
+					key += '\n';
+					key.append(a < b ? b : a);
+					if (relations_seen.insert(key).second) {
+						relations.emplace_back(std::string(a), std::string(b), strength);
+					}
+				});
+			}
+		}
+	}
+	groupByRelations(frame.people, relations, links, threshold, frame.groups);
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,183 @@
+#include <people_msgs_utils/instrumentation.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace people_msgs_utils {
+namespace instrumentation {
+
+/// Number of sub-buckets per octave of the histogram
+static constexpr unsigned int HISTOGRAM_SUBBUCKETS_LOG2 = 2;
+/// Covers durations up to 2^64 ns
+static constexpr unsigned int HISTOGRAM_SIZE = 64 << HISTOGRAM_SUBBUCKETS_LOG2;
+
+/// Lock-free accumulator of records of a single stage
+struct StageRecords {
+	std::atomic<unsigned long int> calls{0};
+	std::atomic<unsigned long int> items{0};
+	std::atomic<unsigned long int> errors{0};
+	std::atomic<uint64_t> time_total_ns{0};
+	std::atomic<uint64_t> time_max_ns{0};
+	std::array<std::atomic<unsigned long int>, HISTOGRAM_SIZE> histogram{};
+};
+
+static std::array<StageRecords, static_cast<size_t>(Stage::COUNT)> records;
+static std::atomic<RecordCallback> callback{nullptr};
+
+/// Log-scale bucket: octave given by the most significant bit, refined by the next bits
+static size_t toBucket(uint64_t ns) {
+	if (ns < (1u << HISTOGRAM_SUBBUCKETS_LOG2)) {
+		return static_cast<size_t>(ns);
+	}
+	unsigned int msb = 63 - static_cast<unsigned int>(__builtin_clzll(ns));
+	uint64_t sub = (ns >> (msb - HISTOGRAM_SUBBUCKETS_LOG2)) & ((1u << HISTOGRAM_SUBBUCKETS_LOG2) - 1);
+	return std::min(
+		static_cast<size_t>(((msb - HISTOGRAM_SUBBUCKETS_LOG2 + 1) << HISTOGRAM_SUBBUCKETS_LOG2) + sub),
+		static_cast<size_t>(HISTOGRAM_SIZE - 1)
+	);
+}
+
+/// Upper bound of the bucket's range
+static double fromBucket(size_t bucket) {
+	if (bucket < (1u << HISTOGRAM_SUBBUCKETS_LOG2)) {
+		return static_cast<double>(bucket + 1);
+	}
+	unsigned int msb = static_cast<unsigned int>(bucket >> HISTOGRAM_SUBBUCKETS_LOG2) + HISTOGRAM_SUBBUCKETS_LOG2 - 1;
+	uint64_t sub = bucket & ((1u << HISTOGRAM_SUBBUCKETS_LOG2) - 1);
+	double base = static_cast<double>(uint64_t(1) << msb);
+	return base + (sub + 1) * base / (1u << HISTOGRAM_SUBBUCKETS_LOG2);
+}
+
+bool isEnabled() {
+#ifdef PEOPLE_MSGS_UTILS_INSTRUMENTATION
+	return true;
+#else
+	return false;
+#endif
+}
+
+void setCallback(RecordCallback fun) {
+	callback.store(fun);
+}
+
+void record(Stage stage, std::chrono::nanoseconds duration, size_t items, bool error) {
+	auto& stage_records = records.at(static_cast<size_t>(stage));
+	uint64_t ns = static_cast<uint64_t>(std::max(duration.count(), static_cast<decltype(duration.count())>(0)));
+
+	stage_records.calls.fetch_add(1, std::memory_order_relaxed);
+	stage_records.items.fetch_add(items, std::memory_order_relaxed);
+	if (error) {
+		stage_records.errors.fetch_add(1, std::memory_order_relaxed);
+	}
+	stage_records.time_total_ns.fetch_add(ns, std::memory_order_relaxed);
+	uint64_t max_prev = stage_records.time_max_ns.load(std::memory_order_relaxed);
+	while (ns > max_prev && !stage_records.time_max_ns.compare_exchange_weak(max_prev, ns)) {}
+	stage_records.histogram.at(toBucket(ns)).fetch_add(1, std::memory_order_relaxed);
+
+	auto fun = callback.load();
+	if (fun != nullptr) {
+		fun(stage, static_cast<double>(ns) * 1e-09, items, error);
+	}
+}
+
+StageStatistics getStatistics(Stage stage, bool reset) {
+	auto& stage_records = records.at(static_cast<size_t>(stage));
+
+	StageStatistics stats;
+	// reset is not atomic as a whole - records made meanwhile may be partially lost
+	auto load = [reset](auto& value) {
+		return reset ? value.exchange(0, std::memory_order_relaxed) : value.load(std::memory_order_relaxed);
+	};
+	stats.calls = load(stage_records.calls);
+	stats.items = load(stage_records.items);
+	stats.errors = load(stage_records.errors);
+	stats.time_total = static_cast<double>(load(stage_records.time_total_ns)) * 1e-09;
+	stats.time_max = static_cast<double>(load(stage_records.time_max_ns)) * 1e-09;
+
+	std::array<unsigned long int, HISTOGRAM_SIZE> histogram;
+	unsigned long int histogram_total = 0;
+	for (size_t i = 0; i < HISTOGRAM_SIZE; i++) {
+		histogram[i] = load(stage_records.histogram[i]);
+		histogram_total += histogram[i];
+	}
+	auto percentile = [&](double p) {
+		auto threshold = static_cast<unsigned long int>(std::ceil(p * static_cast<double>(histogram_total)));
+		unsigned long int cumulative = 0;
+		for (size_t i = 0; i < HISTOGRAM_SIZE; i++) {
+			cumulative += histogram[i];
+			if (cumulative >= threshold && cumulative > 0) {
+				return std::min(fromBucket(i) * 1e-09, stats.time_max);
+			}
+		}
+		return 0.0;
+	};
+	stats.time_p50 = percentile(0.50);
+	stats.time_p99 = percentile(0.99);
+	return stats;
+}
+
+std::vector<HistogramBucket> getHistogram(Stage stage) {
+	const auto& stage_records = records.at(static_cast<size_t>(stage));
+	std::vector<HistogramBucket> histogram;
+	for (size_t i = 0; i < HISTOGRAM_SIZE; i++) {
+		auto count = stage_records.histogram[i].load(std::memory_order_relaxed);
+		if (count > 0) {
+			HistogramBucket bucket;
+			bucket.upper_bound = fromBucket(i) * 1e-09;
+			bucket.count = count;
+			histogram.push_back(bucket);
+		}
+	}
+	return histogram;
+}
+
+void reset() {
+	for (size_t i = 0; i < static_cast<size_t>(Stage::COUNT); i++) {
+		getStatistics(static_cast<Stage>(i), true);
+	}
+}
+
+std::string toString(Stage stage) {
+	switch (stage) {
+		case Stage::PARSE_PEOPLE:
+			return "parse_people";
+		case Stage::COLLECT_GROUPS:
+			return "collect_groups";
+		case Stage::CREATE_GROUPS:
+			return "create_groups";
+		case Stage::CREATE_FROM_PEOPLE:
+			return "create_from_people";
+		case Stage::SPATIAL_MODEL:
+			return "spatial_model";
+		case Stage::ELLIPSE_FITTING:
+			return "ellipse_fitting";
+		case Stage::TRANSFORM_PERSON:
+			return "transform_person";
+		case Stage::TRANSFORM_GROUP:
+			return "transform_group";
+		default:
+			return "unknown";
+	}
+}
+
+std::string exportCsv() {
+	std::stringstream ss;
+	ss << "stage,calls,items,errors,time_total,time_p50,time_p99,time_max" << std::endl;
+	for (size_t i = 0; i < static_cast<size_t>(Stage::COUNT); i++) {
+		auto stage = static_cast<Stage>(i);
+		auto stats = getStatistics(stage);
+		ss << toString(stage) << ","
+			<< stats.calls << ","
+			<< stats.items << ","
+			<< stats.errors << ","
+			<< stats.time_total << ","
+			<< stats.time_p50 << ","
+			<< stats.time_p99 << ","
+			<< stats.time_max << std::endl;
+	}
+	return ss.str();
+}
+
+} // namespace instrumentation
+} // namespace people_msgs_utils
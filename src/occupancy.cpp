@@ -0,0 +1,289 @@
+#include <people_msgs_utils/occupancy.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace people_msgs_utils {
+
+/**
+ * @brief Computes the range of cells whose centers lie within [lo, hi] along one axis of the grid
+ *
+ * @param first coordinate of the center of the first cell
+ * @return false if no cell is within the range
+ */
+static bool getCellRange(
+	double lo,
+	double hi,
+	double first,
+	double resolution,
+	size_t size,
+	size_t& index_min,
+	size_t& index_max
+) {
+	if (!(lo <= hi) || size == 0) {
+		return false;
+	}
+	double min = std::ceil((lo - first) / resolution);
+	double max = std::floor((hi - first) / resolution);
+	if (max < 0.0 || min > static_cast<double>(size - 1) || min > max) {
+		return false;
+	}
+	index_min = static_cast<size_t>(std::max(min, 0.0));
+	index_max = static_cast<size_t>(std::min(max, static_cast<double>(size - 1)));
+	return true;
+}
+
+bool SparseSpaceTimeOccupancy::isOccupied(size_t step, size_t i, size_t j) const {
+	return std::binary_search(
+		cells.cbegin() + slice_start[step],
+		cells.cbegin() + slice_start[step + 1],
+		j * grid.size_x + i
+	);
+}
+
+OccupancyRasterizer::OccupancyRasterizer():
+	OccupancyRasterizer(Parameters())
+{}
+
+OccupancyRasterizer::OccupancyRasterizer(const Parameters& params, const ParallelFor& parallel_for):
+	params_(params),
+	parallel_for_(parallel_for)
+{
+	params_.inflation = std::max(params_.inflation, 0.0);
+	params_.uncertainty_scale = std::max(params_.uncertainty_scale, 0.0);
+	params_.cost_falloff = std::max(params_.cost_falloff, 0.0);
+	params_.cost_cutoff = std::max(params_.cost_cutoff, 0.0);
+}
+
+template <typename SpanCallback>
+void OccupancyRasterizer::forEachSpan(
+	const Prediction& prediction,
+	const GridWindow& grid,
+	size_t step,
+	double margin,
+	const SpanCallback& span
+) const {
+	const double res = grid.resolution;
+	const double x_first = grid.origin_x + 0.5 * res;
+	const double y_first = grid.origin_y + 0.5 * res;
+
+	// discs of people
+	for (size_t person = 0; person < prediction.num_people; person++) {
+		size_t index = prediction.index(step, person);
+		double cx = prediction.x[index];
+		double cy = prediction.y[index];
+		double variance = std::max(prediction.cov_xx[index], prediction.cov_yy[index]);
+		Footprint footprint;
+		footprint.center_x = cx;
+		footprint.center_y = cy;
+		footprint.a = params_.person_radius + params_.inflation
+			+ params_.uncertainty_scale * std::sqrt(std::max(variance, 0.0));
+		footprint.b = footprint.a;
+		double radius = footprint.a + margin;
+
+		size_t j_min;
+		size_t j_max;
+		if (!std::isfinite(cx) || !std::isfinite(radius) || footprint.a <= 0.0
+			|| !getCellRange(cy - radius, cy + radius, y_first, res, grid.size_y, j_min, j_max)
+		) {
+			continue;
+		}
+		for (size_t j = j_min; j <= j_max; j++) {
+			double dy = y_first + static_cast<double>(j) * res - cy;
+			double half_width_sq = radius * radius - dy * dy;
+			size_t i_min;
+			size_t i_max;
+			if (half_width_sq < 0.0) {
+				continue;
+			}
+			double half_width = std::sqrt(half_width_sq);
+			if (getCellRange(cx - half_width, cx + half_width, x_first, res, grid.size_x, i_min, i_max)) {
+				span(j, i_min, i_max, footprint);
+			}
+		}
+	}
+
+	if (!params_.use_groups) {
+		return;
+	}
+
+	// O-space ellipses of groups
+	for (size_t group = 0; group < prediction.num_groups; group++) {
+		const auto& ellipse = prediction.group_ellipses[step * prediction.num_groups + group];
+		if (!ellipse.valid) {
+			continue;
+		}
+		Footprint footprint;
+		footprint.center_x = ellipse.center_x;
+		footprint.center_y = ellipse.center_y;
+		footprint.cos_yaw = ellipse.cos_yaw;
+		footprint.sin_yaw = ellipse.sin_yaw;
+		footprint.a = 1.0 / ellipse.inv_a + params_.inflation;
+		footprint.b = 1.0 / ellipse.inv_b + params_.inflation;
+		// points within the margin along rays from the center lie in the ellipse scaled by this
+		double scale = 1.0 + margin / std::min(footprint.a, footprint.b);
+		double a = scale * footprint.a;
+		double b = scale * footprint.b;
+		double c = ellipse.cos_yaw;
+		double s = ellipse.sin_yaw;
+		double extent_y = std::hypot(a * s, b * c);
+
+		size_t j_min;
+		size_t j_max;
+		if (!getCellRange(
+			ellipse.center_y - extent_y,
+			ellipse.center_y + extent_y,
+			y_first,
+			res,
+			grid.size_y,
+			j_min,
+			j_max
+		)) {
+			continue;
+		}
+		// normalized squared distance in terms of dx for a fixed dy: qa * dx^2 + 2 * qb * dx + qc
+		double inv_a_sq = 1.0 / (a * a);
+		double inv_b_sq = 1.0 / (b * b);
+		double qa = c * c * inv_a_sq + s * s * inv_b_sq;
+		for (size_t j = j_min; j <= j_max; j++) {
+			double dy = y_first + static_cast<double>(j) * res - ellipse.center_y;
+			double qb = dy * c * s * (inv_a_sq - inv_b_sq);
+			double qc = dy * dy * (s * s * inv_a_sq + c * c * inv_b_sq) - 1.0;
+			double discriminant = qb * qb - qa * qc;
+			size_t i_min;
+			size_t i_max;
+			if (discriminant <= 0.0) {
+				continue;
+			}
+			double root = std::sqrt(discriminant);
+			double dx_min = (-qb - root) / qa;
+			double dx_max = (-qb + root) / qa;
+			if (getCellRange(
+				ellipse.center_x + dx_min,
+				ellipse.center_x + dx_max,
+				x_first,
+				res,
+				grid.size_x,
+				i_min,
+				i_max
+			)) {
+				span(j, i_min, i_max, footprint);
+			}
+		}
+	}
+}
+
+void OccupancyRasterizer::rasterize(
+	const Prediction& prediction,
+	const GridWindow& grid,
+	SpaceTimeOccupancy& occupancy
+) {
+	size_t slice_size = grid.size_x * grid.size_y;
+	occupancy.grid = grid;
+	occupancy.time_step = prediction.time_step;
+	occupancy.num_steps = prediction.num_steps;
+	occupancy.cells.resize(prediction.num_steps * slice_size);
+	if (slice_size == 0 || grid.resolution <= 0.0) {
+		std::fill(occupancy.cells.begin(), occupancy.cells.end(), 0);
+		return;
+	}
+
+	// slices are cleared by the tasks, so clearing of the (possibly large) volume is parallelized too
+	auto rasterize_slice = [&](size_t step) {
+		uint8_t* slice = occupancy.cells.data() + step * slice_size;
+		std::fill(slice, slice + slice_size, 0);
+		forEachSpan(prediction, grid, step, 0.0, [&](size_t j, size_t i_min, size_t i_max, const Footprint&) {
+			uint8_t* row = slice + j * grid.size_x;
+			std::fill(row + i_min, row + i_max + 1, 1);
+		});
+	};
+	forEachIndex(prediction.num_steps, rasterize_slice, parallel_for_);
+}
+
+void OccupancyRasterizer::rasterize(
+	const Prediction& prediction,
+	const GridWindow& grid,
+	SparseSpaceTimeOccupancy& occupancy
+) {
+	occupancy.grid = grid;
+	occupancy.time_step = prediction.time_step;
+	occupancy.num_steps = prediction.num_steps;
+	occupancy.slice_start.assign(prediction.num_steps + 1, 0);
+	occupancy.cells.clear();
+	if (grid.size_x * grid.size_y == 0 || grid.resolution <= 0.0) {
+		return;
+	}
+
+	// each slice is collected separately, so slices can be processed concurrently
+	if (slices_.size() < prediction.num_steps) {
+		slices_.resize(prediction.num_steps);
+	}
+	auto rasterize_slice = [&](size_t step) {
+		auto& slice = slices_[step];
+		slice.clear();
+		forEachSpan(prediction, grid, step, 0.0, [&](size_t j, size_t i_min, size_t i_max, const Footprint&) {
+			for (size_t i = i_min; i <= i_max; i++) {
+				slice.push_back(j * grid.size_x + i);
+			}
+		});
+		// spans of overlapping footprints
+		std::sort(slice.begin(), slice.end());
+		slice.erase(std::unique(slice.begin(), slice.end()), slice.end());
+	};
+	forEachIndex(prediction.num_steps, rasterize_slice, parallel_for_);
+
+	for (size_t step = 0; step < prediction.num_steps; step++) {
+		occupancy.slice_start[step] = occupancy.cells.size();
+		occupancy.cells.insert(occupancy.cells.end(), slices_[step].cbegin(), slices_[step].cend());
+	}
+	occupancy.slice_start[prediction.num_steps] = occupancy.cells.size();
+}
+
+void OccupancyRasterizer::rasterize(
+	const Prediction& prediction,
+	const GridWindow& grid,
+	SpaceTimeCost& cost
+) {
+	size_t slice_size = grid.size_x * grid.size_y;
+	cost.grid = grid;
+	cost.time_step = prediction.time_step;
+	cost.num_steps = prediction.num_steps;
+	cost.cells.resize(prediction.num_steps * slice_size);
+	if (slice_size == 0 || grid.resolution <= 0.0) {
+		std::fill(cost.cells.begin(), cost.cells.end(), 0.0f);
+		return;
+	}
+
+	const double res = grid.resolution;
+	const double x_first = grid.origin_x + 0.5 * res;
+	const double y_first = grid.origin_y + 0.5 * res;
+	const double margin = params_.cost_falloff * params_.cost_cutoff;
+	const double inv_falloff_sq = margin > 0.0 ? 1.0 / (params_.cost_falloff * params_.cost_falloff) : 0.0;
+	auto rasterize_slice = [&](size_t step) {
+		float* slice = cost.cells.data() + step * slice_size;
+		std::fill(slice, slice + slice_size, 0.0f);
+		forEachSpan(prediction, grid, step, margin, [&](size_t j, size_t i_min, size_t i_max, const Footprint& fp) {
+			float* row = slice + j * grid.size_x;
+			double dy = y_first + static_cast<double>(j) * res - fp.center_y;
+			double inv_a = 1.0 / fp.a;
+			double inv_b = 1.0 / fp.b;
+			for (size_t i = i_min; i <= i_max; i++) {
+				double dx = x_first + static_cast<double>(i) * res - fp.center_x;
+				double u = (dx * fp.cos_yaw + dy * fp.sin_yaw) * inv_a;
+				double v = (-dx * fp.sin_yaw + dy * fp.cos_yaw) * inv_b;
+				// normalized distance from the center, 1 on the boundary
+				double rho = std::sqrt(u * u + v * v);
+				double value = 1.0;
+				// without the margin, spans cover footprints only (cells on their boundaries are decided by spans)
+				if (rho > 1.0 && margin > 0.0) {
+					double distance = std::sqrt(dx * dx + dy * dy) * (1.0 - 1.0 / rho);
+					value = distance <= margin ? std::exp(-0.5 * distance * distance * inv_falloff_sq) : 0.0;
+				}
+				row[i] = std::max(row[i], static_cast<float>(value));
+			}
+		});
+	};
+	forEachIndex(prediction.num_steps, rasterize_slice, parallel_for_);
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,163 @@
+#include <people_msgs_utils/ospace.h>
+#include <people_msgs_utils/vectorization.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace people_msgs_utils {
+
+/// Number of points processed at once; bounding boxes of blocks are used for rejection of distant ellipses
+static constexpr size_t BLOCK_SIZE = 256;
+
+/// Axis-aligned bounding box of points
+struct BoundingBox {
+	double min_x;
+	double min_y;
+	double max_x;
+	double max_y;
+};
+
+static BoundingBox computeBoundingBox(const double* xs, const double* ys, size_t num) {
+	auto [min_x, max_x] = std::minmax_element(xs, xs + num);
+	auto [min_y, max_y] = std::minmax_element(ys, ys + num);
+	return BoundingBox{*min_x, *min_y, *max_x, *max_y};
+}
+
+/// Checks whether the bounding box of the ellipse scaled by @ref scale around its center overlaps @ref box
+static bool overlaps(const OSpaceEllipse& ellipse, const BoundingBox& box, double scale = 1.0) {
+	double extent_x = (ellipse.max_x - ellipse.center_x) * scale;
+	double extent_y = (ellipse.max_y - ellipse.center_y) * scale;
+	return !(
+		ellipse.center_x + extent_x < box.min_x
+		|| ellipse.center_x - extent_x > box.max_x
+		|| ellipse.center_y + extent_y < box.min_y
+		|| ellipse.center_y - extent_y > box.max_y
+	);
+}
+
+/// Sets flags of points inside of the ellipse; branch-free, so the loop is vectorized
+static void markInside(const OSpaceEllipse& e, const double* xs, const double* ys, size_t num, uint8_t* inside) {
+	for (size_t k = 0; k < num; k++) {
+		double d2 = e.getNormalizedDistanceSq(xs[k], ys[k]);
+		inside[k] |= static_cast<uint8_t>(vectorization::toBits(d2 - 1.0) >> 63);
+	}
+}
+
+/// Updates the smallest squared distances and corresponding indices; branch-free, so the loop is vectorized
+static void updateNearest(
+	const OSpaceEllipse& e,
+	uint64_t index,
+	const double* xs,
+	const double* ys,
+	size_t num,
+	double* distances_sq,
+	uint64_t* nearest
+) {
+	for (size_t k = 0; k < num; k++) {
+		double d2 = e.getNormalizedDistanceSq(xs[k], ys[k]);
+		uint64_t closer = vectorization::maskLessNonNegative(d2, distances_sq[k]);
+		distances_sq[k] = vectorization::select(closer, d2, distances_sq[k]);
+		nearest[k] = vectorization::select(closer, index, nearest[k]);
+	}
+}
+
+OSpaceEllipse OSpaceEllipse::fromGroup(const Group& group) {
+	OSpaceEllipse ellipse;
+	double a = group.getSpanX() / 2.0;
+	double b = group.getSpanY() / 2.0;
+	double yaw = group.getOrientationYaw();
+	ellipse.center_x = group.getPositionX();
+	ellipse.center_y = group.getPositionY();
+	ellipse.valid = a > 0.0 && b > 0.0
+		&& std::isfinite(a) && std::isfinite(b) && std::isfinite(yaw)
+		&& std::isfinite(ellipse.center_x) && std::isfinite(ellipse.center_y);
+	ellipse.cos_yaw = std::cos(yaw);
+	ellipse.sin_yaw = std::sin(yaw);
+	ellipse.inv_a = ellipse.valid ? 1.0 / a : 0.0;
+	ellipse.inv_b = ellipse.valid ? 1.0 / b : 0.0;
+	// half-extents of the bounding box of a rotated ellipse
+	double extent_x = ellipse.valid ? std::hypot(a * ellipse.cos_yaw, b * ellipse.sin_yaw) : 0.0;
+	double extent_y = ellipse.valid ? std::hypot(a * ellipse.sin_yaw, b * ellipse.cos_yaw) : 0.0;
+	ellipse.min_x = ellipse.center_x - extent_x;
+	ellipse.max_x = ellipse.center_x + extent_x;
+	ellipse.min_y = ellipse.center_y - extent_y;
+	ellipse.max_y = ellipse.center_y + extent_y;
+	return ellipse;
+}
+
+void OSpaceQuery::setGroups(const Groups& groups) {
+	ellipses_.clear();
+	for (const auto& group: groups) {
+		ellipses_.push_back(OSpaceEllipse::fromGroup(group));
+	}
+}
+
+void OSpaceQuery::contains(const double* xs, const double* ys, size_t num, uint8_t* inside) const {
+	std::fill(inside, inside + num, 0);
+	for (size_t begin = 0; begin < num; begin += BLOCK_SIZE) {
+		size_t size = std::min(BLOCK_SIZE, num - begin);
+		auto box = computeBoundingBox(xs + begin, ys + begin, size);
+		for (const auto& ellipse: ellipses_) {
+			if (!ellipse.valid || !overlaps(ellipse, box)) {
+				continue;
+			}
+			markInside(ellipse, xs + begin, ys + begin, size, inside + begin);
+		}
+	}
+}
+
+bool OSpaceQuery::containsAny(const double* xs, const double* ys, size_t num) const {
+	std::array<uint8_t, BLOCK_SIZE> inside;
+	for (size_t begin = 0; begin < num; begin += BLOCK_SIZE) {
+		size_t size = std::min(BLOCK_SIZE, num - begin);
+		auto box = computeBoundingBox(xs + begin, ys + begin, size);
+		std::fill(inside.begin(), inside.end(), 0);
+		for (const auto& ellipse: ellipses_) {
+			if (!ellipse.valid || !overlaps(ellipse, box)) {
+				continue;
+			}
+			markInside(ellipse, xs + begin, ys + begin, size, inside.data());
+		}
+		if (std::any_of(inside.cbegin(), inside.cbegin() + size, [](uint8_t flag) { return flag != 0; })) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void OSpaceQuery::getNormalizedDistances(
+	const double* xs,
+	const double* ys,
+	size_t num,
+	double* distances,
+	size_t* nearest,
+	double max_distance
+) const {
+	bool bounded = std::isfinite(max_distance);
+	double distance_sq_max = max_distance * max_distance;
+	std::array<double, BLOCK_SIZE> distances_sq;
+	std::array<uint64_t, BLOCK_SIZE> nearest_block;
+	for (size_t begin = 0; begin < num; begin += BLOCK_SIZE) {
+		size_t size = std::min(BLOCK_SIZE, num - begin);
+		auto box = computeBoundingBox(xs + begin, ys + begin, size);
+		std::fill(distances_sq.begin(), distances_sq.end(), distance_sq_max);
+		std::fill(nearest_block.begin(), nearest_block.end(), static_cast<uint64_t>(NONE));
+		for (size_t i = 0; i < ellipses_.size(); i++) {
+			const auto& ellipse = ellipses_[i];
+			if (!ellipse.valid || (bounded && !overlaps(ellipse, box, max_distance))) {
+				continue;
+			}
+			updateNearest(ellipse, i, xs + begin, ys + begin, size, distances_sq.data(), nearest_block.data());
+		}
+		for (size_t k = 0; k < size; k++) {
+			bool found = nearest_block[k] != static_cast<uint64_t>(NONE);
+			distances[begin + k] = found ? std::sqrt(distances_sq[k]) : std::numeric_limits<double>::infinity();
+			if (nearest != nullptr) {
+				nearest[begin + k] = found ? static_cast<size_t>(nearest_block[k]) : NONE;
+			}
+		}
+	}
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,54 @@
+#include <people_msgs_utils/parallel.h>
+
+#include <algorithm>
+#include <exception>
+#include <vector>
+
+namespace people_msgs_utils {
+
+ParallelFor createThreadParallelFor(unsigned int num_threads) {
+	// hardware_concurrency may return 0 if the value is not computable
+	num_threads = std::max(num_threads, 1u);
+
+	return [num_threads](size_t count, const std::function<void(size_t)>& task) {
+		size_t num_chunks = std::min(static_cast<size_t>(num_threads), count);
+		if (num_chunks <= 1) {
+			for (size_t i = 0; i < count; i++) {
+				task(i);
+			}
+			return;
+		}
+
+		std::vector<std::exception_ptr> exceptions(num_chunks);
+		std::vector<std::thread> workers;
+		workers.reserve(num_chunks - 1);
+		auto process_chunk = [&](size_t chunk) {
+			// contiguous chunks of (almost) equal size
+			size_t begin = chunk * count / num_chunks;
+			size_t end = (chunk + 1) * count / num_chunks;
+			try {
+				for (size_t i = begin; i < end; i++) {
+					task(i);
+				}
+			} catch (...) {
+				exceptions.at(chunk) = std::current_exception();
+			}
+		};
+		// the calling thread processes the first chunk itself
+		for (size_t chunk = 1; chunk < num_chunks; chunk++) {
+			workers.emplace_back(process_chunk, chunk);
+		}
+		process_chunk(0);
+		for (auto& worker: workers) {
+			worker.join();
+		}
+
+		for (const auto& exception: exceptions) {
+			if (exception) {
+				std::rethrow_exception(exception);
+			}
+		}
+	};
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,53 @@
+#include <people_msgs_utils/people_arrays.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace people_msgs_utils {
+
+void PeopleArrays::assign(const People& people) {
+	size_t num = people.size();
+	for (auto* array: {&x, &y, &yaw, &vx, &vy, &cov_xx, &cov_xy, &cov_yy, &vel_cov_xx, &vel_cov_xy, &vel_cov_yy}) {
+		array->resize(num);
+	}
+	for (size_t i = 0; i < num; i++) {
+		const auto& person = people[i];
+		x[i] = person.getPositionX();
+		y[i] = person.getPositionY();
+		yaw[i] = person.getOrientationYaw();
+		vx[i] = person.getVelocityX();
+		vy[i] = person.getVelocityY();
+		cov_xx[i] = person.getCovariancePoseXX();
+		cov_xy[i] = person.getCovariancePoseXY();
+		cov_yy[i] = person.getCovariancePoseYY();
+		vel_cov_xx[i] = person.getCovarianceVelocityXX();
+		vel_cov_xy[i] = person.getCovarianceVelocityXY();
+		vel_cov_yy[i] = person.getCovarianceVelocityYY();
+	}
+	computeCovarianceFactors();
+}
+
+void PeopleArrays::computeCovarianceFactors() {
+	size_t num = cov_xx.size();
+	for (auto* array: {&cov_chol_xx, &cov_chol_yx, &cov_chol_yy, &cov_inv_xx, &cov_inv_xy, &cov_inv_yy}) {
+		array->resize(num);
+	}
+	for (size_t i = 0; i < num; i++) {
+		double l11 = std::sqrt(std::max(cov_xx[i], MIN_VARIANCE));
+		double l21 = cov_xy[i] / l11;
+		double l22 = std::sqrt(std::max(cov_yy[i] - l21 * l21, MIN_VARIANCE));
+		cov_chol_xx[i] = l11;
+		cov_chol_yx[i] = l21;
+		cov_chol_yy[i] = l22;
+
+		// inverse = L^-T * L^-1, where L^-1 = [a 0; b c]
+		double a = 1.0 / l11;
+		double c = 1.0 / l22;
+		double b = -l21 * a * c;
+		cov_inv_xx[i] = a * a + b * b;
+		cov_inv_xy[i] = b * c;
+		cov_inv_yy[i] = c * c;
+	}
+}
+
+} // namespace people_msgs_utils
@@ -1,5 +1,6 @@
 #include <people_msgs_utils/person.h>
 #include <people_msgs_utils/utils.h>
+#include <people_msgs_utils/instrumentation.h>
 
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #include <tf2/convert.h>
@@ -17,30 +18,19 @@ Person::Person(
 	const double& reliability,
 	const std::vector<std::string>& tagnames,
 	const std::vector<std::string>& tags
-):
-	name_(name),
-	reliability_(reliability),
-	occluded_(true),
-	matched_(false),
-	detection_id_(0),
-	track_age_(0)
-{
-	pose_.pose.position = position;
-	// initial guess on orientation, may be adjusted using 'tags'
-	tf2::Quaternion quat;
-	quat.setRPY(0, 0, std::atan2(velocity.y, velocity.x));
-	pose_.pose.orientation.x = quat.getX();
-	pose_.pose.orientation.y = quat.getY();
-	pose_.pose.orientation.z = quat.getZ();
-	pose_.pose.orientation.w = quat.getW();
-
-	vel_.pose.position = velocity;
-	// initial guess on theta velocity
-	vel_.pose.orientation.w = 1.0;
+) {
+	assign(name, position, velocity, reliability, tagnames, tags);
+}
 
-	// Basic data was saved in initializer list.
-	// Now, check if tags contain some fancy data
-	parseTags(tagnames, tags);
+Person::Person(
+	std::string_view name,
+	const geometry_msgs::Point& position,
+	const geometry_msgs::Point& velocity,
+	const double& reliability,
+	const std::vector<std::string_view>& tagnames,
+	const std::vector<std::string_view>& tags
+) {
+	assign(name, position, velocity, reliability, tagnames, tags);
 }
 
 Person::Person(
@@ -66,22 +56,19 @@ Person::Person(
 {}
 
 void Person::transform(const geometry_msgs::TransformStamped& transform) {
-	// transform pose with covariance
+	PEOPLE_MSGS_UTILS_RECORD_SCOPE(instrumentation::Stage::TRANSFORM_PERSON, 1);
+	// transform pose with covariance (header of the input is not used by tf2::doTransform)
 	geometry_msgs::PoseWithCovarianceStamped pose_in;
-	pose_in.header.frame_id = transform.header.frame_id;
 	pose_in.pose = pose_;
 
 	geometry_msgs::PoseWithCovarianceStamped pose_out;
-	pose_out.header.frame_id = transform.child_frame_id;
 	tf2::doTransform(pose_in, pose_out, transform);
 
 	// transform velocity with covariance
 	geometry_msgs::PoseWithCovarianceStamped vel_in;
-	vel_in.header.frame_id = transform.header.frame_id;
 	vel_in.pose = vel_;
 
 	geometry_msgs::PoseWithCovarianceStamped vel_out;
-	vel_out.header.frame_id = transform.child_frame_id;
 	tf2::Transform transform_tf;
 	tf2::fromMsg(transform.transform, transform_tf);
 	vel_out.pose.covariance = tf2::transformCovariance(vel_in.pose.covariance, transform_tf);
@@ -111,36 +98,96 @@ void Person::transform(const geometry_msgs::TransformStamped& transform) {
 	vel_ = vel_out.pose;
 }
 
-bool Person::parseTags(const std::vector<std::string>& tagnames, const std::vector<std::string>& tags) {
+void Person::setPlanarState(double x, double y, double yaw, double vx, double vy) {
+	pose_.pose.position.x = x;
+	pose_.pose.position.y = y;
+	tf2::Quaternion quat;
+	quat.setRPY(0, 0, yaw);
+	pose_.pose.orientation.x = quat.getX();
+	pose_.pose.orientation.y = quat.getY();
+	pose_.pose.orientation.z = quat.getZ();
+	pose_.pose.orientation.w = quat.getW();
+	vel_.pose.position.x = vx;
+	vel_.pose.position.y = vy;
+}
+
+void Person::rotateCovariances(double yaw) {
+	rotatePlanarCovariance(pose_.covariance, yaw);
+	rotatePlanarCovariance(vel_.covariance, yaw);
+}
+
+template <typename StringT>
+void Person::assign(
+	std::string_view name,
+	const geometry_msgs::Point& position,
+	const geometry_msgs::Point& velocity,
+	const double& reliability,
+	const std::vector<StringT>& tagnames,
+	const std::vector<StringT>& tags
+) {
+	// strings are assigned (not constructed) to reuse their buffers
+	name_.assign(name.data(), name.size());
+	reliability_ = reliability;
+	occluded_ = true;
+	matched_ = false;
+	detection_id_ = 0;
+	track_age_ = 0;
+	group_id_.clear();
+
+	pose_.pose.position = position;
+	// initial guess on orientation, may be adjusted using 'tags'
+	tf2::Quaternion quat;
+	quat.setRPY(0, 0, std::atan2(velocity.y, velocity.x));
+	pose_.pose.orientation.x = quat.getX();
+	pose_.pose.orientation.y = quat.getY();
+	pose_.pose.orientation.z = quat.getZ();
+	pose_.pose.orientation.w = quat.getW();
+	pose_.covariance.assign(0.0);
+
+	vel_.pose.position = velocity;
+	// initial guess on theta velocity
+	vel_.pose.orientation = geometry_msgs::Quaternion();
+	vel_.pose.orientation.w = 1.0;
+	vel_.covariance.assign(0.0);
+
+	// Basic data was saved.
+	// Now, check if tags contain some fancy data
+	parseTags(tagnames, tags);
+}
+
+template <typename StringT>
+bool Person::parseTags(const std::vector<StringT>& tagnames, const std::vector<StringT>& tags) {
 	if ((tagnames.size() != tags.size()) || tagnames.empty()) {
 		// no additional data can be retrieved
 		return false;
 	}
 
 	// create iterators for tagnames and tags
-	const std::string DELIMITER = " ";
-	std::vector<std::string>::const_iterator tag_value_it = tags.begin();
+	const std::string_view DELIMITER = " ";
+	auto tag_value_it = tags.cbegin();
 	for (
-		std::vector<std::string>::const_iterator tag_it = tagnames.begin();
+		auto tag_it = tagnames.cbegin();
 		tag_it != tagnames.end();
 		tag_it++
 	) {
 		if (tag_it->find("orientation") != std::string::npos) {
-			auto orient_components = parseString<double>(*tag_value_it, DELIMITER);
-			if (orient_components.size() == 4) {
+			std::array<double, 4> orient_components;
+			auto count = parseString<double>(*tag_value_it, DELIMITER, orient_components.data(), orient_components.size());
+			if (count == 4) {
 				pose_.pose.orientation.x = orient_components.at(0);
 				pose_.pose.orientation.y = orient_components.at(1);
 				pose_.pose.orientation.z = orient_components.at(2);
 				pose_.pose.orientation.w = orient_components.at(3);
 			}
 		} else if (tag_it->find("pose_covariance") != std::string::npos) {
-			auto cov = parseString<double>(*tag_value_it, DELIMITER);
-			if (cov.size() == 36) {
+			// parsed directly into the storage (which is overwritten only if the count is valid)
+			std::array<double, COV_MAT_SIZE> cov;
+			if (parseString<double>(*tag_value_it, DELIMITER, cov.data(), cov.size()) == COV_MAT_SIZE) {
 				std::copy(cov.begin(), cov.end(), pose_.covariance.begin());
 			}
 		} else if (tag_it->find("twist_covariance") != std::string::npos) {
-			auto cov = parseString<double>(*tag_value_it, DELIMITER);
-			if (cov.size() == 36) {
+			std::array<double, COV_MAT_SIZE> cov;
+			if (parseString<double>(*tag_value_it, DELIMITER, cov.data(), cov.size()) == COV_MAT_SIZE) {
 				std::copy(cov.begin(), cov.end(), vel_.covariance.begin());
 			}
 		} else if (tag_it->find("occluded") != std::string::npos) {
@@ -148,9 +195,9 @@ bool Person::parseTags(const std::vector<std::string>& tagnames, const std::vect
 		} else if (tag_it->find("matched") != std::string::npos) {
 			matched_ = parseStringBool(*tag_value_it);
 		} else if (tag_it->find("detection_id") != std::string::npos) {
-			detection_id_ = static_cast<unsigned int>(std::stoul(*tag_value_it));
+			detection_id_ = static_cast<unsigned int>(parseStringUnsigned(*tag_value_it));
 		} else if (tag_it->find("track_age") != std::string::npos) {
-			track_age_ = static_cast<unsigned int>(std::stoul(*tag_value_it));
+			track_age_ = static_cast<unsigned int>(parseStringUnsigned(*tag_value_it));
 		} else if (tag_it->find("group_id") != std::string::npos) {
 			// primary key for later association
 			group_id_ = *tag_value_it;
@@ -160,4 +207,27 @@ bool Person::parseTags(const std::vector<std::string>& tagnames, const std::vect
 	return true;
 }
 
+// explicit instantiations of the tag parsing methods
+template void Person::assign<std::string>(
+	std::string_view,
+	const geometry_msgs::Point&,
+	const geometry_msgs::Point&,
+	const double&,
+	const std::vector<std::string>&,
+	const std::vector<std::string>&
+);
+template void Person::assign<std::string_view>(
+	std::string_view,
+	const geometry_msgs::Point&,
+	const geometry_msgs::Point&,
+	const double&,
+	const std::vector<std::string_view>&,
+	const std::vector<std::string_view>&
+);
+template bool Person::parseTags<std::string>(const std::vector<std::string>&, const std::vector<std::string>&);
+template bool Person::parseTags<std::string_view>(
+	const std::vector<std::string_view>&,
+	const std::vector<std::string_view>&
+);
+
 } // namespace people_msgs_utils
@@ -0,0 +1,129 @@
+#include <people_msgs_utils/prediction.h>
+
+#include <algorithm>
+#include <array>
+
+namespace people_msgs_utils {
+
+/// Number of people processed at once in the vectorized loop
+static constexpr size_t BLOCK_SIZE = 256;
+
+/// Stores @ref size values of a block of people at the given step according to the layout of the @ref prediction
+static void store(
+	const Prediction& prediction,
+	size_t step,
+	size_t begin,
+	size_t size,
+	const double* values,
+	std::vector<double>& output
+) {
+	if (prediction.layout == Prediction::Layout::TIME_MAJOR) {
+		std::copy(values, values + size, output.begin() + prediction.index(step, begin));
+		return;
+	}
+	for (size_t k = 0; k < size; k++) {
+		output[prediction.index(step, begin + k)] = values[k];
+	}
+}
+
+ConstantVelocityPredictor::ConstantVelocityPredictor():
+	ConstantVelocityPredictor(Parameters())
+{}
+
+ConstantVelocityPredictor::ConstantVelocityPredictor(const Parameters& params):
+	params_(params)
+{
+	params_.acceleration_noise = std::max(params_.acceleration_noise, 0.0);
+}
+
+void ConstantVelocityPredictor::predict(const PeopleArrays& people, Prediction& prediction) const {
+	predict(people, Groups(), prediction);
+}
+
+void ConstantVelocityPredictor::predict(
+	const PeopleArrays& people,
+	const Groups& groups,
+	Prediction& prediction
+) const {
+	size_t num = people.size();
+	size_t steps = params_.steps;
+	prediction.layout = params_.layout;
+	prediction.time_step = params_.time_step;
+	prediction.num_steps = steps;
+	prediction.num_people = num;
+	prediction.num_groups = groups.size();
+	for (auto* array: {&prediction.x, &prediction.y, &prediction.cov_xx, &prediction.cov_xy, &prediction.cov_yy}) {
+		array->resize(steps * num);
+	}
+
+	// results are stored in local buffers first, which cannot alias the inputs, so no runtime alias checks
+	// (which the compiler gives up on for so many arrays) are needed for vectorization
+	std::array<double, BLOCK_SIZE> x;
+	std::array<double, BLOCK_SIZE> y;
+	std::array<double, BLOCK_SIZE> cov_xx;
+	std::array<double, BLOCK_SIZE> cov_xy;
+	std::array<double, BLOCK_SIZE> cov_yy;
+	for (size_t begin = 0; begin < num; begin += BLOCK_SIZE) {
+		size_t size = std::min(BLOCK_SIZE, num - begin);
+		const double* px = people.x.data() + begin;
+		const double* py = people.y.data() + begin;
+		const double* vx = people.vx.data() + begin;
+		const double* vy = people.vy.data() + begin;
+		const double* pose_xx = people.cov_xx.data() + begin;
+		const double* pose_xy = people.cov_xy.data() + begin;
+		const double* pose_yy = people.cov_yy.data() + begin;
+		const double* vel_xx = people.vel_cov_xx.data() + begin;
+		const double* vel_xy = people.vel_cov_xy.data() + begin;
+		const double* vel_yy = people.vel_cov_yy.data() + begin;
+
+		for (size_t step = 0; step < steps; step++) {
+			double t = prediction.getTime(step);
+			double t_sq = t * t;
+			double noise = params_.acceleration_noise * t_sq * t / 3.0;
+			for (size_t k = 0; k < size; k++) {
+				x[k] = px[k] + vx[k] * t;
+				y[k] = py[k] + vy[k] * t;
+				cov_xx[k] = pose_xx[k] + vel_xx[k] * t_sq + noise;
+				cov_xy[k] = pose_xy[k] + vel_xy[k] * t_sq;
+				cov_yy[k] = pose_yy[k] + vel_yy[k] * t_sq + noise;
+			}
+			store(prediction, step, begin, size, x.data(), prediction.x);
+			store(prediction, step, begin, size, y.data(), prediction.y);
+			store(prediction, step, begin, size, cov_xx.data(), prediction.cov_xx);
+			store(prediction, step, begin, size, cov_xy.data(), prediction.cov_xy);
+			store(prediction, step, begin, size, cov_yy.data(), prediction.cov_yy);
+		}
+	}
+
+	// groups move rigidly with the mean velocity of their members
+	prediction.group_ellipses.resize(steps * groups.size());
+	for (size_t g = 0; g < groups.size(); g++) {
+		const auto& members = groups[g].getMembers();
+		double group_vx = 0.0;
+		double group_vy = 0.0;
+		for (const auto& member: members) {
+			group_vx += member.getVelocityX();
+			group_vy += member.getVelocityY();
+		}
+		if (!members.empty()) {
+			group_vx /= members.size();
+			group_vy /= members.size();
+		}
+
+		auto ellipse = OSpaceEllipse::fromGroup(groups[g]);
+		for (size_t step = 0; step < steps; step++) {
+			double dx = group_vx * prediction.getTime(step);
+			double dy = group_vy * prediction.getTime(step);
+			auto& predicted = prediction.group_ellipses[step * groups.size() + g];
+			predicted = ellipse;
+			predicted.center_x += dx;
+			predicted.center_y += dy;
+			predicted.min_x += dx;
+			predicted.max_x += dx;
+			predicted.min_y += dy;
+			predicted.max_y += dy;
+		}
+	}
+}
+
+} // namespace people_msgs_utils
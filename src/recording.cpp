@@ -0,0 +1,776 @@
+#include <people_msgs_utils/recording.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+namespace people_msgs_utils {
+
+/// "PMUREC01" in little endian
+static constexpr uint64_t RECORDING_MAGIC = 0x3130434552554d50ULL;
+static constexpr uint32_t RECORDING_VERSION = 1;
+/// Columns start at multiples of this
+static constexpr size_t ALIGNMENT = 8;
+/// Largest magnitude of quantized positions (2^52), so they are exact and their differences do not overflow
+static constexpr double MAX_QUANTIZED = 4503599627370496.0;
+
+/// Beginning of the file; the magic is written when the recording is closed
+struct FileHeader {
+	uint64_t magic;
+	uint32_t version;
+	uint32_t keyframe_interval;
+	double position_resolution;
+	uint64_t num_frames;
+	uint64_t index_offset;
+	uint64_t num_strings;
+	uint64_t strings_offset;
+};
+
+/// Beginning of each record, followed by the columns
+struct RecordHeader {
+	uint32_t stamp_sec;
+	uint32_t stamp_nsec;
+	uint32_t seq;
+	uint32_t frame_id;
+	uint32_t num_people;
+	uint32_t num_groups;
+	uint32_t num_members;
+	uint32_t num_relations;
+	uint32_t position_bytes;
+	uint32_t reserved;
+	uint64_t keyframe;
+	double anchor_x;
+	double anchor_y;
+};
+
+/// Entry of the index at the end of the file
+struct IndexRecord {
+	uint64_t offset;
+	uint32_t stamp_sec;
+	uint32_t stamp_nsec;
+};
+
+/// Byte offsets of the columns within a record, determined by the counts in its header
+struct RecordLayout {
+	size_t track_age;
+	size_t name;
+	size_t reference;
+	size_t group;
+	size_t detection_id;
+	size_t yaw;
+	size_t vx;
+	size_t vy;
+	size_t cov_xx;
+	size_t cov_xy;
+	size_t cov_yy;
+	size_t cov_yawyaw;
+	size_t vel_cov_xx;
+	size_t vel_cov_xy;
+	size_t vel_cov_yy;
+	size_t reliability;
+	size_t flags;
+	size_t position_x;
+	size_t position_y;
+	size_t group_age;
+	size_t group_cog_x;
+	size_t group_cog_y;
+	size_t group_x;
+	size_t group_y;
+	size_t group_yaw;
+	size_t group_span_x;
+	size_t group_span_y;
+	size_t group_name;
+	size_t group_member_start;
+	size_t group_relation_start;
+	size_t group_members;
+	size_t relation_a;
+	size_t relation_b;
+	size_t relation_strength;
+	/// Size of the record
+	size_t size;
+};
+
+static size_t alignUp(size_t offset) {
+	return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+static RecordLayout computeLayout(const RecordHeader& header) {
+	RecordLayout layout;
+	size_t offset = alignUp(sizeof(RecordHeader));
+	auto append = [&offset](size_t bytes) {
+		size_t start = offset;
+		offset = alignUp(offset + bytes);
+		return start;
+	};
+	size_t people = header.num_people;
+	size_t groups = header.num_groups;
+	layout.track_age = append(people * sizeof(uint64_t));
+	for (auto* column: {&layout.name, &layout.reference, &layout.group, &layout.detection_id}) {
+		*column = append(people * sizeof(uint32_t));
+	}
+	for (auto* column: {
+		&layout.yaw, &layout.vx, &layout.vy, &layout.cov_xx, &layout.cov_xy, &layout.cov_yy, &layout.cov_yawyaw,
+		&layout.vel_cov_xx, &layout.vel_cov_xy, &layout.vel_cov_yy, &layout.reliability
+	}) {
+		*column = append(people * sizeof(float));
+	}
+	layout.flags = append(people * sizeof(uint8_t));
+	layout.position_x = append(people * header.position_bytes);
+	layout.position_y = append(people * header.position_bytes);
+
+	layout.group_age = append(groups * sizeof(uint64_t));
+	for (auto* column: {
+		&layout.group_cog_x, &layout.group_cog_y,
+		&layout.group_x, &layout.group_y, &layout.group_yaw, &layout.group_span_x, &layout.group_span_y
+	}) {
+		*column = append(groups * sizeof(double));
+	}
+	layout.group_name = append(groups * sizeof(uint32_t));
+	layout.group_member_start = append((groups + 1) * sizeof(uint32_t));
+	layout.group_relation_start = append((groups + 1) * sizeof(uint32_t));
+	layout.group_members = append(header.num_members * sizeof(uint32_t));
+	layout.relation_a = append(header.num_relations * sizeof(uint32_t));
+	layout.relation_b = append(header.num_relations * sizeof(uint32_t));
+	layout.relation_strength = append(header.num_relations * sizeof(float));
+	layout.size = offset;
+	return layout;
+}
+
+template <typename T>
+static T* getColumn(char* record, size_t offset) {
+	return reinterpret_cast<T*>(record + offset);
+}
+
+template <typename T>
+static const T* getColumn(const char* record, size_t offset) {
+	return reinterpret_cast<const T*>(record + offset);
+}
+
+/**
+ * @brief Locates the record at @ref offset and computes its @ref layout
+ *
+ * @return nullptr if the record (or its columns) does not lie between the header and the string table of the file
+ */
+static const RecordHeader* findRecord(
+	const char* memory,
+	const FileHeader& file_header,
+	uint64_t offset,
+	RecordLayout& layout
+) {
+	bool valid = offset >= alignUp(sizeof(FileHeader))
+		&& offset % ALIGNMENT == 0
+		&& offset <= file_header.strings_offset
+		&& sizeof(RecordHeader) <= file_header.strings_offset - offset;
+	if (!valid) {
+		return nullptr;
+	}
+	const auto* header = reinterpret_cast<const RecordHeader*>(memory + offset);
+	if (header->position_bytes != sizeof(int16_t)
+		&& header->position_bytes != sizeof(int32_t)
+		&& header->position_bytes != sizeof(int64_t)
+	) {
+		return nullptr;
+	}
+	// counts are 32-bit, so the layout does not overflow
+	layout = computeLayout(*header);
+	return layout.size <= file_header.strings_offset - offset ? header : nullptr;
+}
+
+/// Returns true if all @ref count values are less than @ref limit, or are RecordedFrameView::NONE if allowed
+static bool areIndices(const uint32_t* values, size_t count, size_t limit, bool none_allowed) {
+	for (size_t i = 0; i < count; i++) {
+		if (values[i] >= limit && !(none_allowed && values[i] == RecordedFrameView::NONE)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/// Returns true if @ref count + 1 @ref starts of ranges do not decrease, starting at 0 and ending at @ref total
+static bool areRangeStarts(const uint32_t* starts, size_t count, size_t total) {
+	return starts[0] == 0 && starts[count] == total && std::is_sorted(starts, starts + count + 1);
+}
+
+/// Quantizes the position @ref value (relative to an anchor) of the person @ref name
+static int64_t quantize(double value, double resolution, const std::string& name) {
+	double quantized = std::round(value / resolution);
+	if (!(std::abs(quantized) <= MAX_QUANTIZED)) {
+		throw std::invalid_argument("Cannot quantize the position of '" + name + "', it is too far from the others");
+	}
+	return static_cast<int64_t>(quantized);
+}
+
+/// Reads a quantized position stored in @ref bytes bytes
+static int64_t getPosition(const void* column, uint32_t bytes, size_t i) {
+	switch (bytes) {
+		case sizeof(int16_t):
+			return static_cast<const int16_t*>(column)[i];
+		case sizeof(int32_t):
+			return static_cast<const int32_t*>(column)[i];
+		default:
+			return static_cast<const int64_t*>(column)[i];
+	}
+}
+
+/// Stores quantized positions in @ref bytes bytes each
+static void setPositions(void* column, uint32_t bytes, const std::vector<int64_t>& values) {
+	for (size_t i = 0; i < values.size(); i++) {
+		switch (bytes) {
+			case sizeof(int16_t):
+				static_cast<int16_t*>(column)[i] = values[i];
+				break;
+			case sizeof(int32_t):
+				static_cast<int32_t*>(column)[i] = values[i];
+				break;
+			default:
+				static_cast<int64_t*>(column)[i] = values[i];
+		}
+	}
+}
+
+/// Returns the smallest number of bytes (2, 4 or 8) that stores all values
+static uint32_t computePositionBytes(const std::vector<int64_t>& values) {
+	int64_t max_abs = 0;
+	for (auto value: values) {
+		max_abs = std::max(max_abs, value < 0 ? -value : value);
+	}
+	if (max_abs <= std::numeric_limits<int16_t>::max()) {
+		return sizeof(int16_t);
+	}
+	if (max_abs <= std::numeric_limits<int32_t>::max()) {
+		return sizeof(int32_t);
+	}
+	return sizeof(int64_t);
+}
+
+double RecordedFrameView::getPositionX(size_t person) const {
+	auto value = getPosition(position_x, position_bytes, person);
+	if (reference[person] == NONE) {
+		return anchor_x + value * resolution;
+	}
+	return key_anchor_x + (getPosition(key_position_x, key_position_bytes, reference[person]) + value) * resolution;
+}
+
+double RecordedFrameView::getPositionY(size_t person) const {
+	auto value = getPosition(position_y, position_bytes, person);
+	if (reference[person] == NONE) {
+		return anchor_y + value * resolution;
+	}
+	return key_anchor_y + (getPosition(key_position_y, key_position_bytes, reference[person]) + value) * resolution;
+}
+
+void RecordedFrameView::decodePositions(std::vector<double>& x, std::vector<double>& y) const {
+	x.resize(num_people);
+	y.resize(num_people);
+	for (size_t i = 0; i < num_people; i++) {
+		x[i] = getPositionX(i);
+		y[i] = getPositionY(i);
+	}
+}
+
+std::string_view RecordedFrameView::getString(uint32_t id) const {
+	return std::string_view(string_chars + string_offsets[id], string_offsets[id + 1] - string_offsets[id]);
+}
+
+FrameRecorder::FrameRecorder(const std::string& path): FrameRecorder(path, Parameters()) {}
+
+FrameRecorder::FrameRecorder(const std::string& path, const Parameters& params):
+	params_(params),
+	offset_(0),
+	keyframe_(0),
+	key_anchor_x_(0.0),
+	key_anchor_y_(0.0)
+{
+	if (params.keyframe_interval == 0 || params.keyframe_interval > UINT32_MAX || !(params.position_resolution > 0.0)) {
+		throw std::invalid_argument("Invalid parameters of the recording '" + path + "'");
+	}
+	file_.open(path, std::ios::binary | std::ios::trunc);
+	if (!file_) {
+		throw std::runtime_error("Cannot create the recording '" + path + "': " + std::strerror(errno));
+	}
+	// completed in close()
+	FileHeader header{};
+	file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	offset_ = alignUp(sizeof(header));
+}
+
+FrameRecorder::~FrameRecorder() {
+	try {
+		close();
+	} catch (const std::exception&) {
+		// the recording stays incomplete
+	}
+}
+
+uint32_t FrameRecorder::intern(const std::string& str) {
+	auto it = string_ids_.find(str);
+	if (it != string_ids_.cend()) {
+		return it->second;
+	}
+	uint32_t id = strings_.size();
+	strings_.push_back(str);
+	string_ids_.emplace(str, id);
+	return id;
+}
+
+void FrameRecorder::record(const Frame& frame) {
+	if (!file_.is_open()) {
+		throw std::runtime_error("The recording is already closed");
+	}
+	const auto& people = frame.people;
+	const auto& groups = frame.groups;
+	RecordHeader header{};
+	header.stamp_sec = frame.header.stamp.sec;
+	header.stamp_nsec = frame.header.stamp.nsec;
+	header.seq = frame.header.seq;
+	header.frame_id = intern(frame.header.frame_id);
+	header.num_people = people.size();
+	header.num_groups = groups.size();
+
+	double sum_x = 0.0;
+	double sum_y = 0.0;
+	for (const auto& person: people) {
+		if (!std::isfinite(person.getPositionX()) || !std::isfinite(person.getPositionY())) {
+			throw std::invalid_argument("Cannot record a non-finite position of '" + person.getName() + "'");
+		}
+		sum_x += person.getPositionX();
+		sum_y += person.getPositionY();
+	}
+	header.anchor_x = people.empty() ? 0.0 : sum_x / people.size();
+	header.anchor_y = people.empty() ? 0.0 : sum_y / people.size();
+
+	bool is_keyframe = index_.size() % params_.keyframe_interval == 0;
+	if (is_keyframe) {
+		keyframe_ = index_.size();
+		key_anchor_x_ = header.anchor_x;
+		key_anchor_y_ = header.anchor_y;
+		key_people_.clear();
+	}
+	header.keyframe = keyframe_;
+
+	// delta encoding
+	double resolution = params_.position_resolution;
+	names_.resize(people.size());
+	references_.resize(people.size());
+	values_x_.resize(people.size());
+	values_y_.resize(people.size());
+	for (size_t i = 0; i < people.size(); i++) {
+		const auto& person = people[i];
+		names_[i] = intern(person.getName());
+		auto it = is_keyframe ? key_people_.cend() : key_people_.find(names_[i]);
+		if (it == key_people_.cend()) {
+			references_[i] = RecordedFrameView::NONE;
+			values_x_[i] = quantize(person.getPositionX() - header.anchor_x, resolution, person.getName());
+			values_y_[i] = quantize(person.getPositionY() - header.anchor_y, resolution, person.getName());
+		} else {
+			references_[i] = it->second;
+			values_x_[i] = quantize(person.getPositionX() - key_anchor_x_, resolution, person.getName()) - key_x_[it->second];
+			values_y_[i] = quantize(person.getPositionY() - key_anchor_y_, resolution, person.getName()) - key_y_[it->second];
+		}
+	}
+	if (is_keyframe) {
+		key_x_ = values_x_;
+		key_y_ = values_y_;
+		for (size_t i = 0; i < people.size(); i++) {
+			key_people_.emplace(names_[i], i);
+		}
+	}
+	header.position_bytes = std::max(computePositionBytes(values_x_), computePositionBytes(values_y_));
+
+	group_index_.clear();
+	person_index_.clear();
+	for (size_t g = 0; g < groups.size(); g++) {
+		group_index_.emplace(groups[g].getName(), g);
+	}
+	for (size_t i = 0; i < people.size(); i++) {
+		person_index_.emplace(people[i].getName(), i);
+	}
+	for (const auto& group: groups) {
+		for (const auto& member: group.getMembers()) {
+			header.num_members += person_index_.count(member.getName());
+		}
+		header.num_relations += group.getSocialRelations().size();
+	}
+
+	auto layout = computeLayout(header);
+	// zeroed, so the padding is deterministic
+	buffer_.assign(layout.size, 0);
+	char* record = buffer_.data();
+	std::memcpy(record, &header, sizeof(header));
+	std::memcpy(getColumn<uint32_t>(record, layout.name), names_.data(), names_.size() * sizeof(uint32_t));
+	std::memcpy(
+		getColumn<uint32_t>(record, layout.reference),
+		references_.data(),
+		references_.size() * sizeof(uint32_t)
+	);
+	setPositions(getColumn<char>(record, layout.position_x), header.position_bytes, values_x_);
+	setPositions(getColumn<char>(record, layout.position_y), header.position_bytes, values_y_);
+
+	for (size_t i = 0; i < people.size(); i++) {
+		const auto& person = people[i];
+		getColumn<uint64_t>(record, layout.track_age)[i] = person.getTrackAge();
+		getColumn<uint32_t>(record, layout.detection_id)[i] = person.getDetectionID();
+		auto it = group_index_.find(person.getGroupName());
+		getColumn<uint32_t>(record, layout.group)[i] = it == group_index_.cend()
+			? RecordedFrameView::NONE
+			: it->second;
+		getColumn<float>(record, layout.yaw)[i] = person.getOrientationYaw();
+		getColumn<float>(record, layout.vx)[i] = person.getVelocityX();
+		getColumn<float>(record, layout.vy)[i] = person.getVelocityY();
+		getColumn<float>(record, layout.cov_xx)[i] = person.getCovariancePoseXX();
+		getColumn<float>(record, layout.cov_xy)[i] = person.getCovariancePoseXY();
+		getColumn<float>(record, layout.cov_yy)[i] = person.getCovariancePoseYY();
+		getColumn<float>(record, layout.cov_yawyaw)[i] = person.getCovariancePoseYawYaw();
+		getColumn<float>(record, layout.vel_cov_xx)[i] = person.getCovarianceVelocityXX();
+		getColumn<float>(record, layout.vel_cov_xy)[i] = person.getCovarianceVelocityXY();
+		getColumn<float>(record, layout.vel_cov_yy)[i] = person.getCovarianceVelocityYY();
+		getColumn<float>(record, layout.reliability)[i] = person.getReliability();
+		getColumn<uint8_t>(record, layout.flags)[i] = (person.isOccluded() ? RecordedFrameView::OCCLUDED : 0)
+			| (person.isMatched() ? RecordedFrameView::MATCHED : 0);
+	}
+
+	auto* member_start = getColumn<uint32_t>(record, layout.group_member_start);
+	auto* relation_start = getColumn<uint32_t>(record, layout.group_relation_start);
+	uint32_t num_members = 0;
+	uint32_t num_relations = 0;
+	for (size_t g = 0; g < groups.size(); g++) {
+		const auto& group = groups[g];
+		auto ellipse = group.getEllipse();
+		auto cog = group.getCenterOfGravity();
+		getColumn<uint64_t>(record, layout.group_age)[g] = group.getAge();
+		getColumn<double>(record, layout.group_cog_x)[g] = cog.x;
+		getColumn<double>(record, layout.group_cog_y)[g] = cog.y;
+		getColumn<double>(record, layout.group_x)[g] = ellipse.center_x;
+		getColumn<double>(record, layout.group_y)[g] = ellipse.center_y;
+		getColumn<double>(record, layout.group_yaw)[g] = ellipse.yaw;
+		getColumn<double>(record, layout.group_span_x)[g] = ellipse.span_x;
+		getColumn<double>(record, layout.group_span_y)[g] = ellipse.span_y;
+		getColumn<uint32_t>(record, layout.group_name)[g] = intern(group.getName());
+
+		member_start[g] = num_members;
+		for (const auto& member: group.getMembers()) {
+			auto it = person_index_.find(member.getName());
+			if (it != person_index_.cend()) {
+				getColumn<uint32_t>(record, layout.group_members)[num_members++] = it->second;
+			}
+		}
+		relation_start[g] = num_relations;
+		for (const auto& relation: group.getSocialRelations()) {
+			getColumn<uint32_t>(record, layout.relation_a)[num_relations] = intern(std::get<0>(relation));
+			getColumn<uint32_t>(record, layout.relation_b)[num_relations] = intern(std::get<1>(relation));
+			getColumn<float>(record, layout.relation_strength)[num_relations] = std::get<2>(relation);
+			num_relations++;
+		}
+	}
+	member_start[groups.size()] = num_members;
+	relation_start[groups.size()] = num_relations;
+
+	file_.write(buffer_.data(), buffer_.size());
+	if (!file_) {
+		throw std::runtime_error("Cannot write a frame into the recording");
+	}
+	index_.push_back(IndexEntry{offset_, header.stamp_sec, header.stamp_nsec});
+	offset_ += buffer_.size();
+}
+
+void FrameRecorder::close() {
+	if (!file_.is_open()) {
+		return;
+	}
+	FileHeader header{};
+	header.magic = RECORDING_MAGIC;
+	header.version = RECORDING_VERSION;
+	header.keyframe_interval = params_.keyframe_interval;
+	header.position_resolution = params_.position_resolution;
+	header.num_frames = index_.size();
+	header.num_strings = strings_.size();
+
+	// string table: offsets of strings followed by their characters
+	header.strings_offset = offset_;
+	std::vector<uint32_t> string_offsets(strings_.size() + 1, 0);
+	for (size_t i = 0; i < strings_.size(); i++) {
+		string_offsets[i + 1] = string_offsets[i] + strings_[i].size();
+	}
+	file_.write(reinterpret_cast<const char*>(string_offsets.data()), string_offsets.size() * sizeof(uint32_t));
+	for (const auto& str: strings_) {
+		file_.write(str.data(), str.size());
+	}
+	size_t strings_size = string_offsets.size() * sizeof(uint32_t) + string_offsets.back();
+	std::vector<char> padding(alignUp(strings_size) - strings_size, 0);
+	file_.write(padding.data(), padding.size());
+
+	header.index_offset = header.strings_offset + alignUp(strings_size);
+	for (const auto& entry: index_) {
+		IndexRecord record{entry.offset, entry.stamp_sec, entry.stamp_nsec};
+		file_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+	}
+
+	file_.seekp(0);
+	file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file_.close();
+	if (!file_) {
+		throw std::runtime_error("Cannot complete the recording");
+	}
+}
+
+FrameRecording::FrameRecording(const std::string& path):
+	memory_(nullptr),
+	size_(0)
+{
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1) {
+		throw std::runtime_error("Cannot open the recording '" + path + "': " + std::strerror(errno));
+	}
+	struct stat info;
+	if (fstat(fd, &info) == -1 || static_cast<size_t>(info.st_size) < sizeof(FileHeader)) {
+		close(fd);
+		throw std::runtime_error("The file '" + path + "' is not a complete recording");
+	}
+	size_ = info.st_size;
+	void* memory = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (memory == MAP_FAILED) {
+		throw std::runtime_error("Cannot map the recording '" + path + "': " + std::strerror(errno));
+	}
+	memory_ = static_cast<const char*>(memory);
+
+	// records are validated when accessed, see getFrame
+	const auto* header = reinterpret_cast<const FileHeader*>(memory_);
+	bool valid = header->magic == RECORDING_MAGIC
+		&& header->version == RECORDING_VERSION
+		&& header->strings_offset % ALIGNMENT == 0
+		&& header->index_offset % ALIGNMENT == 0
+		&& header->index_offset <= size_
+		&& header->num_frames <= (size_ - header->index_offset) / sizeof(IndexRecord)
+		&& header->strings_offset >= alignUp(sizeof(FileHeader))
+		&& header->strings_offset <= header->index_offset
+		&& header->num_strings < (header->index_offset - header->strings_offset) / sizeof(uint32_t);
+	if (valid) {
+		// characters of the strings end before the index
+		const auto* string_offsets = getColumn<uint32_t>(memory_, header->strings_offset);
+		size_t chars_size = header->index_offset - header->strings_offset - (header->num_strings + 1) * sizeof(uint32_t);
+		valid = areRangeStarts(string_offsets, header->num_strings, string_offsets[header->num_strings])
+			&& string_offsets[header->num_strings] <= chars_size;
+	}
+	if (!valid) {
+		munmap(const_cast<char*>(memory_), size_);
+		throw std::runtime_error("The file '" + path + "' is not a complete recording");
+	}
+}
+
+FrameRecording::~FrameRecording() {
+	munmap(const_cast<char*>(memory_), size_);
+}
+
+size_t FrameRecording::size() const {
+	return reinterpret_cast<const FileHeader*>(memory_)->num_frames;
+}
+
+ros::Time FrameRecording::getStamp(size_t frame) const {
+	if (frame >= size()) {
+		throw std::out_of_range("The recording has no frame " + std::to_string(frame));
+	}
+	const auto* header = reinterpret_cast<const FileHeader*>(memory_);
+	const auto& entry = getColumn<IndexRecord>(memory_, header->index_offset)[frame];
+	return ros::Time(entry.stamp_sec, entry.stamp_nsec);
+}
+
+size_t FrameRecording::findFrame(const ros::Time& stamp) const {
+	const auto* header = reinterpret_cast<const FileHeader*>(memory_);
+	const auto* index = getColumn<IndexRecord>(memory_, header->index_offset);
+	const auto* it = std::partition_point(index, index + header->num_frames, [&stamp](const IndexRecord& entry) {
+		return ros::Time(entry.stamp_sec, entry.stamp_nsec) < stamp;
+	});
+	return it - index;
+}
+
+RecordedFrameView FrameRecording::getFrame(size_t frame) const {
+	if (frame >= size()) {
+		throw std::out_of_range("The recording has no frame " + std::to_string(frame));
+	}
+	const auto* file_header = reinterpret_cast<const FileHeader*>(memory_);
+	const auto* index = getColumn<IndexRecord>(memory_, file_header->index_offset);
+	RecordLayout layout;
+	const auto* header = findRecord(memory_, *file_header, index[frame].offset, layout);
+	RecordLayout key_layout;
+	const auto* key_header = header != nullptr && header->keyframe <= frame
+		? findRecord(memory_, *file_header, index[header->keyframe].offset, key_layout)
+		: nullptr;
+	const char* record = memory_ + index[frame].offset;
+
+	// indices stored in the record must not point outside of it (or outside of the string table)
+	size_t strings = file_header->num_strings;
+	bool valid = key_header != nullptr
+		&& header->frame_id < strings
+		&& areIndices(getColumn<uint32_t>(record, layout.name), header->num_people, strings, false)
+		&& areIndices(getColumn<uint32_t>(record, layout.group), header->num_people, header->num_groups, true)
+		&& areIndices(
+			getColumn<uint32_t>(record, layout.reference),
+			header->num_people,
+			key_header->num_people,
+			true
+		)
+		&& areIndices(getColumn<uint32_t>(record, layout.group_name), header->num_groups, strings, false)
+		&& areRangeStarts(getColumn<uint32_t>(record, layout.group_member_start), header->num_groups, header->num_members)
+		&& areIndices(getColumn<uint32_t>(record, layout.group_members), header->num_members, header->num_people, false)
+		&& areRangeStarts(
+			getColumn<uint32_t>(record, layout.group_relation_start),
+			header->num_groups,
+			header->num_relations
+		)
+		&& areIndices(getColumn<uint32_t>(record, layout.relation_a), header->num_relations, strings, false)
+		&& areIndices(getColumn<uint32_t>(record, layout.relation_b), header->num_relations, strings, false);
+	if (!valid) {
+		throw std::runtime_error("The frame " + std::to_string(frame) + " of the recording is corrupt");
+	}
+	const char* key_record = memory_ + index[header->keyframe].offset;
+
+	RecordedFrameView view;
+	view.string_offsets = getColumn<uint32_t>(memory_, file_header->strings_offset);
+	view.string_chars = reinterpret_cast<const char*>(view.string_offsets + file_header->num_strings + 1);
+	view.stamp = ros::Time(header->stamp_sec, header->stamp_nsec);
+	view.seq = header->seq;
+	view.frame_id = view.getString(header->frame_id);
+
+	view.num_people = header->num_people;
+	view.name = getColumn<uint32_t>(record, layout.name);
+	view.yaw = getColumn<float>(record, layout.yaw);
+	view.vx = getColumn<float>(record, layout.vx);
+	view.vy = getColumn<float>(record, layout.vy);
+	view.cov_xx = getColumn<float>(record, layout.cov_xx);
+	view.cov_xy = getColumn<float>(record, layout.cov_xy);
+	view.cov_yy = getColumn<float>(record, layout.cov_yy);
+	view.cov_yawyaw = getColumn<float>(record, layout.cov_yawyaw);
+	view.vel_cov_xx = getColumn<float>(record, layout.vel_cov_xx);
+	view.vel_cov_xy = getColumn<float>(record, layout.vel_cov_xy);
+	view.vel_cov_yy = getColumn<float>(record, layout.vel_cov_yy);
+	view.reliability = getColumn<float>(record, layout.reliability);
+	view.flags = getColumn<uint8_t>(record, layout.flags);
+	view.detection_id = getColumn<uint32_t>(record, layout.detection_id);
+	view.track_age = getColumn<uint64_t>(record, layout.track_age);
+	view.group = getColumn<uint32_t>(record, layout.group);
+
+	view.num_groups = header->num_groups;
+	view.group_name = getColumn<uint32_t>(record, layout.group_name);
+	view.group_age = getColumn<uint64_t>(record, layout.group_age);
+	view.group_cog_x = getColumn<double>(record, layout.group_cog_x);
+	view.group_cog_y = getColumn<double>(record, layout.group_cog_y);
+	view.group_x = getColumn<double>(record, layout.group_x);
+	view.group_y = getColumn<double>(record, layout.group_y);
+	view.group_yaw = getColumn<double>(record, layout.group_yaw);
+	view.group_span_x = getColumn<double>(record, layout.group_span_x);
+	view.group_span_y = getColumn<double>(record, layout.group_span_y);
+	view.group_member_start = getColumn<uint32_t>(record, layout.group_member_start);
+	view.group_members = getColumn<uint32_t>(record, layout.group_members);
+	view.group_relation_start = getColumn<uint32_t>(record, layout.group_relation_start);
+	view.relation_a = getColumn<uint32_t>(record, layout.relation_a);
+	view.relation_b = getColumn<uint32_t>(record, layout.relation_b);
+	view.relation_strength = getColumn<float>(record, layout.relation_strength);
+
+	view.resolution = file_header->position_resolution;
+	view.anchor_x = header->anchor_x;
+	view.anchor_y = header->anchor_y;
+	view.reference = getColumn<uint32_t>(record, layout.reference);
+	view.position_x = record + layout.position_x;
+	view.position_y = record + layout.position_y;
+	view.position_bytes = header->position_bytes;
+
+	view.key_anchor_x = key_header->anchor_x;
+	view.key_anchor_y = key_header->anchor_y;
+	view.key_position_x = key_record + key_layout.position_x;
+	view.key_position_y = key_record + key_layout.position_y;
+	view.key_position_bytes = key_header->position_bytes;
+	return view;
+}
+
+void FrameRecording::read(size_t frame, Frame& output) const {
+	auto view = getFrame(frame);
+	output.header.stamp = view.stamp;
+	output.header.seq = view.seq;
+	output.header.frame_id = view.frame_id;
+
+	output.people.clear();
+	output.people.reserve(view.num_people);
+	geometry_msgs::PoseWithCovariance pose;
+	geometry_msgs::PoseWithCovariance velocity;
+	for (size_t i = 0; i < view.num_people; i++) {
+		pose.pose.position.x = view.getPositionX(i);
+		pose.pose.position.y = view.getPositionY(i);
+		pose.pose.orientation.z = std::sin(0.5 * view.yaw[i]);
+		pose.pose.orientation.w = std::cos(0.5 * view.yaw[i]);
+		pose.covariance[Person::COV_XX_INDEX] = view.cov_xx[i];
+		pose.covariance[Person::COV_XY_INDEX] = view.cov_xy[i];
+		pose.covariance[Person::COV_YX_INDEX] = view.cov_xy[i];
+		pose.covariance[Person::COV_YY_INDEX] = view.cov_yy[i];
+		pose.covariance[Person::COV_YAWYAW_INDEX] = view.cov_yawyaw[i];
+		velocity.pose.position.x = view.vx[i];
+		velocity.pose.position.y = view.vy[i];
+		velocity.covariance[Person::COV_XX_INDEX] = view.vel_cov_xx[i];
+		velocity.covariance[Person::COV_XY_INDEX] = view.vel_cov_xy[i];
+		velocity.covariance[Person::COV_YX_INDEX] = view.vel_cov_xy[i];
+		velocity.covariance[Person::COV_YY_INDEX] = view.vel_cov_yy[i];
+		output.people.emplace_back(
+			std::string(view.getName(i)),
+			pose,
+			velocity,
+			view.reliability[i],
+			view.flags[i] & RecordedFrameView::OCCLUDED,
+			view.flags[i] & RecordedFrameView::MATCHED,
+			view.detection_id[i],
+			view.track_age[i],
+			view.group[i] == RecordedFrameView::NONE ? std::string() : std::string(view.getGroupName(view.group[i]))
+		);
+	}
+
+	output.groups.clear();
+	output.groups.reserve(view.num_groups);
+	std::vector<Person> members;
+	std::vector<std::string> member_ids;
+	std::vector<std::tuple<std::string, std::string, double>> relations;
+	for (size_t g = 0; g < view.num_groups; g++) {
+		members.clear();
+		member_ids.clear();
+		for (size_t k = view.group_member_start[g]; k < view.group_member_start[g + 1]; k++) {
+			members.push_back(output.people[view.group_members[k]]);
+			member_ids.push_back(members.back().getName());
+		}
+		relations.clear();
+		for (size_t k = view.group_relation_start[g]; k < view.group_relation_start[g + 1]; k++) {
+			relations.emplace_back(
+				std::string(view.getString(view.relation_a[k])),
+				std::string(view.getString(view.relation_b[k])),
+				view.relation_strength[k]
+			);
+		}
+		geometry_msgs::Point cog;
+		cog.x = view.group_cog_x[g];
+		cog.y = view.group_cog_y[g];
+		Group::Ellipse ellipse{
+			view.group_x[g],
+			view.group_y[g],
+			view.group_yaw[g],
+			view.group_span_x[g],
+			view.group_span_y[g]
+		};
+		output.groups.emplace_back(
+			std::string(view.getGroupName(g)),
+			view.group_age[g],
+			members,
+			member_ids,
+			relations,
+			cog,
+			&ellipse
+		);
+	}
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,131 @@
+#include <people_msgs_utils/robot_metrics.h>
+#include <people_msgs_utils/vectorization.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace people_msgs_utils {
+
+/// Number of people processed at once in the vectorized loop
+static constexpr size_t BLOCK_SIZE = 256;
+
+void computeRobotRelativeMetrics(
+	const RobotState& robot,
+	const PeopleArrays& people,
+	double collision_distance,
+	RobotRelativeMetrics& metrics
+) {
+	size_t num = people.size();
+	for (auto* array: {
+		&metrics.distance,
+		&metrics.bearing,
+		&metrics.relative_vx,
+		&metrics.relative_vy,
+		&metrics.closest_approach_distance,
+		&metrics.closest_approach_time,
+		&metrics.time_to_collision
+	}) {
+		array->resize(num);
+	}
+
+	const double* x = people.x.data();
+	const double* y = people.y.data();
+	const double* vx = people.vx.data();
+	const double* vy = people.vy.data();
+	const double collision_distance_sq = collision_distance * collision_distance;
+	const double infinity = std::numeric_limits<double>::infinity();
+	// copied, so the compiler does not have to assume that outputs alias the robot's state
+	const double robot_x = robot.x;
+	const double robot_y = robot.y;
+	const double robot_vx = robot.vx;
+	const double robot_vy = robot.vy;
+
+	// results are stored in local buffers first, which cannot alias the inputs, so no runtime alias checks
+	// (which the compiler gives up on for so many arrays) are needed for vectorization
+	std::array<double, BLOCK_SIZE> distance;
+	std::array<double, BLOCK_SIZE> ca_distance;
+	std::array<double, BLOCK_SIZE> ca_time;
+	std::array<double, BLOCK_SIZE> ttc;
+	for (size_t begin = 0; begin < num; begin += BLOCK_SIZE) {
+		size_t size = std::min(BLOCK_SIZE, num - begin);
+		for (size_t k = 0; k < size; k++) {
+			size_t i = begin + k;
+			double px = x[i] - robot_x;
+			double py = y[i] - robot_y;
+			double rvx = vx[i] - robot_vx;
+			double rvy = vy[i] - robot_vy;
+			distance[k] = std::sqrt(px * px + py * py);
+
+			// relative position over time: p + v * t; squared distance: a * t^2 + 2 * b * t + |p|^2
+			double a = rvx * rvx + rvy * rvy;
+			double b = px * rvx + py * rvy;
+			uint64_t moving = vectorization::maskLessNonNegative(0.0, a);
+			uint64_t approaching = moving & vectorization::maskNegative(b);
+
+			double t_ca = vectorization::select(approaching, -b / a, 0.0);
+			double cx = px + rvx * t_ca;
+			double cy = py + rvy * t_ca;
+			ca_time[k] = t_ca;
+			ca_distance[k] = std::sqrt(cx * cx + cy * cy);
+
+			// the first root of a * t^2 + 2 * b * t + c = 0, where c = |p|^2 - collision_distance^2
+			double c = px * px + py * py - collision_distance_sq;
+			double discriminant = b * b - a * c;
+			uint64_t reaching = approaching & ~vectorization::maskNegative(discriminant);
+			double root = (-b - std::sqrt(vectorization::select(reaching, discriminant, 0.0))) / a;
+			double t_collision = vectorization::select(reaching, root, infinity);
+			ttc[k] = vectorization::select(vectorization::maskNegative(c), 0.0, t_collision);
+		}
+		std::copy(distance.cbegin(), distance.cbegin() + size, metrics.distance.begin() + begin);
+		std::copy(ca_distance.cbegin(), ca_distance.cbegin() + size, metrics.closest_approach_distance.begin() + begin);
+		std::copy(ca_time.cbegin(), ca_time.cbegin() + size, metrics.closest_approach_time.begin() + begin);
+		std::copy(ttc.cbegin(), ttc.cbegin() + size, metrics.time_to_collision.begin() + begin);
+	}
+
+	for (size_t i = 0; i < num; i++) {
+		metrics.relative_vx[i] = vx[i] - robot_vx;
+		metrics.relative_vy[i] = vy[i] - robot_vy;
+	}
+
+	// bearings in the local frame of the robot
+	double cos_yaw = std::cos(robot.yaw);
+	double sin_yaw = std::sin(robot.yaw);
+	for (size_t i = 0; i < num; i++) {
+		double px = x[i] - robot_x;
+		double py = y[i] - robot_y;
+		metrics.bearing[i] = std::atan2(-sin_yaw * px + cos_yaw * py, cos_yaw * px + sin_yaw * py);
+	}
+}
+
+void selectMostCritical(
+	const RobotRelativeMetrics& metrics,
+	size_t k,
+	CriticalityCriterion criterion,
+	std::vector<size_t>& indices
+) {
+	const std::vector<double>* values = &metrics.distance;
+	if (criterion == CriticalityCriterion::CLOSEST_APPROACH_DISTANCE) {
+		values = &metrics.closest_approach_distance;
+	} else if (criterion == CriticalityCriterion::TIME_TO_COLLISION) {
+		values = &metrics.time_to_collision;
+	}
+
+	indices.resize(values->size());
+	for (size_t i = 0; i < indices.size(); i++) {
+		indices[i] = i;
+	}
+	k = std::min(k, indices.size());
+	std::partial_sort(
+		indices.begin(),
+		indices.begin() + k,
+		indices.end(),
+		[values](size_t lhs, size_t rhs) {
+			return (*values)[lhs] < (*values)[rhs] || ((*values)[lhs] == (*values)[rhs] && lhs < rhs);
+		}
+	);
+	indices.resize(k);
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,121 @@
+#include <people_msgs_utils/serialization.h>
+#include <people_msgs_utils/utils.h>
+
+#include <cstring>
+
+namespace people_msgs_utils {
+
+/// Sequential reader of the ROS1 wire format (little-endian, 32-bit length prefixes)
+class BufferReader {
+public:
+	BufferReader(const uint8_t* buffer, size_t length): ptr_(buffer), end_(buffer + length) {}
+
+	template <typename T>
+	bool read(T& value) {
+		if (static_cast<size_t>(end_ - ptr_) < sizeof(T)) {
+			return false;
+		}
+		std::memcpy(&value, ptr_, sizeof(T));
+		ptr_ += sizeof(T);
+		return true;
+	}
+
+	bool read(std::string_view& str) {
+		uint32_t len = 0;
+		if (!read(len) || static_cast<size_t>(end_ - ptr_) < len) {
+			return false;
+		}
+		str = std::string_view(reinterpret_cast<const char*>(ptr_), len);
+		ptr_ += len;
+		return true;
+	}
+
+	bool read(geometry_msgs::Point& point) {
+		return read(point.x) && read(point.y) && read(point.z);
+	}
+
+	bool read(std::vector<std::string_view>& strings) {
+		uint32_t count = 0;
+		// each string takes at least 4 bytes (its length), which bounds the count of a malformed buffer
+		if (!read(count) || static_cast<size_t>(end_ - ptr_) / sizeof(uint32_t) < count) {
+			return false;
+		}
+		strings.resize(count);
+		for (auto& str: strings) {
+			if (!read(str)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool atEnd() const {
+		return ptr_ == end_;
+	}
+
+	size_t remaining() const {
+		return static_cast<size_t>(end_ - ptr_);
+	}
+
+protected:
+	const uint8_t* ptr_;
+	const uint8_t* end_;
+};
+
+bool decodePeople(const uint8_t* buffer, size_t length, PeopleView& view) {
+	BufferReader reader(buffer, length);
+
+	// std_msgs/Header
+	uint32_t stamp_sec = 0;
+	uint32_t stamp_nsec = 0;
+	if (!reader.read(view.seq) || !reader.read(stamp_sec) || !reader.read(stamp_nsec) || !reader.read(view.frame_id)) {
+		return false;
+	}
+	view.stamp = ros::Time(stamp_sec, stamp_nsec);
+
+	// people_msgs/Person[]
+	uint32_t count = 0;
+	if (!reader.read(count)) {
+		return false;
+	}
+	// sanity check against malformed length; an empty person takes 68 bytes on the wire:
+	// name length (4), position and velocity (2 x 3 x 8), reliability (8), tagnames and tags counts (2 x 4)
+	const size_t PERSON_MIN_SIZE = sizeof(uint32_t)
+		+ 2 * 3 * sizeof(double)
+		+ sizeof(double)
+		+ 2 * sizeof(uint32_t);
+	static_assert(PERSON_MIN_SIZE == 68, "Unexpected wire size of people_msgs/Person");
+	if (reader.remaining() / PERSON_MIN_SIZE < count) {
+		return false;
+	}
+	// resizing (instead of clearing) keeps capacities of tag vectors of already existing elements
+	view.people.resize(count);
+	for (auto& person: view.people) {
+		bool ok = reader.read(person.name)
+			&& reader.read(person.position)
+			&& reader.read(person.velocity)
+			&& reader.read(person.reliability)
+			&& reader.read(person.tagnames)
+			&& reader.read(person.tags);
+		if (!ok) {
+			return false;
+		}
+	}
+	return reader.atEnd();
+}
+
+std::pair<std::vector<Person>, std::vector<Group>> createFromSerializedPeople(const uint8_t* buffer, size_t length) {
+	PeopleView view;
+	if (!decodePeople(buffer, length, view)) {
+		return std::make_pair(std::vector<Person>(), std::vector<Group>());
+	}
+	return createFromPeople(view.people);
+}
+
+std::pair<std::vector<Person>, std::vector<Group>> createFromSerializedPeople(const ros::SerializedMessage& msg) {
+	// skip the length prefix (if present)
+	size_t prefix_length = static_cast<size_t>(msg.message_start - msg.buf.get());
+	return createFromSerializedPeople(msg.message_start, msg.num_bytes - prefix_length);
+}
+
+} // namespace people_msgs_utils
@@ -0,0 +1,428 @@
+#include <people_msgs_utils/shared_frame.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace people_msgs_utils {
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "sequence counters must be usable across processes");
+
+/// "PMUFRAME" in little endian
+static constexpr uint64_t SEGMENT_MAGIC = 0x454d415246554d50ULL;
+static constexpr uint32_t SEGMENT_VERSION = 1;
+/// Arrays start at cache lines, so slots do not share them
+static constexpr size_t ALIGNMENT = 64;
+
+/// Beginning of the segment, followed by the slots
+struct SegmentHeader {
+	uint64_t magic;
+	uint32_t version;
+	uint32_t slots;
+	uint64_t max_people;
+	uint64_t max_groups;
+	uint64_t max_string_bytes;
+	/// Number of the latest published frame
+	alignas(ALIGNMENT) std::atomic<uint64_t> latest;
+};
+
+/// Beginning of each slot, followed by the arrays
+struct SlotHeader {
+	/// Odd while the slot is being written
+	std::atomic<uint64_t> sequence;
+	uint64_t number;
+	uint32_t stamp_sec;
+	uint32_t stamp_nsec;
+	uint32_t seq;
+	uint32_t num_people;
+	uint32_t num_groups;
+	uint32_t frame_id_offset;
+	uint32_t frame_id_length;
+};
+
+/// Byte offsets of the arrays within a slot; the same in every process as they depend only on the capacities
+struct SlotLayout {
+	size_t x;
+	size_t y;
+	size_t yaw;
+	size_t vx;
+	size_t vy;
+	size_t cov_xx;
+	size_t cov_xy;
+	size_t cov_yy;
+	size_t reliability;
+	size_t group;
+	size_t name_offset;
+	size_t name_length;
+	size_t group_x;
+	size_t group_y;
+	size_t group_yaw;
+	size_t group_span_x;
+	size_t group_span_y;
+	size_t group_member_start;
+	size_t group_members;
+	size_t group_name_offset;
+	size_t group_name_length;
+	size_t strings;
+	/// Size of the slot
+	size_t size;
+};
+
+static size_t alignUp(size_t offset) {
+	return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+static SlotLayout computeLayout(size_t max_people, size_t max_groups, size_t max_string_bytes) {
+	SlotLayout layout;
+	size_t offset = alignUp(sizeof(SlotHeader));
+	auto append = [&offset](size_t bytes) {
+		size_t start = offset;
+		offset = alignUp(offset + bytes);
+		return start;
+	};
+	for (auto* array: {
+		&layout.x, &layout.y, &layout.yaw, &layout.vx, &layout.vy,
+		&layout.cov_xx, &layout.cov_xy, &layout.cov_yy, &layout.reliability
+	}) {
+		*array = append(max_people * sizeof(double));
+	}
+	for (auto* array: {&layout.group, &layout.name_offset, &layout.name_length}) {
+		*array = append(max_people * sizeof(uint32_t));
+	}
+	for (auto* array: {
+		&layout.group_x, &layout.group_y, &layout.group_yaw, &layout.group_span_x, &layout.group_span_y
+	}) {
+		*array = append(max_groups * sizeof(double));
+	}
+	layout.group_member_start = append((max_groups + 1) * sizeof(uint32_t));
+	// each person is a member of at most one group
+	layout.group_members = append(max_people * sizeof(uint32_t));
+	layout.group_name_offset = append(max_groups * sizeof(uint32_t));
+	layout.group_name_length = append(max_groups * sizeof(uint32_t));
+	layout.strings = append(max_string_bytes);
+	layout.size = offset;
+	return layout;
+}
+
+static size_t computeSegmentSize(const SlotLayout& layout, size_t slots) {
+	return alignUp(sizeof(SegmentHeader)) + slots * layout.size;
+}
+
+template <typename T>
+static T* getArray(void* slot, size_t offset) {
+	return reinterpret_cast<T*>(static_cast<char*>(slot) + offset);
+}
+
+template <typename T>
+static const T* getArray(const void* slot, size_t offset) {
+	return reinterpret_cast<const T*>(static_cast<const char*>(slot) + offset);
+}
+
+static std::runtime_error createSystemError(const std::string& what, const std::string& name) {
+	return std::runtime_error(what + " '" + name + "': " + std::strerror(errno));
+}
+
+std::string_view SharedFrameView::getName(size_t person) const {
+	return std::string_view(strings + name_offset[person], name_length[person]);
+}
+
+std::string_view SharedFrameView::getGroupName(size_t group) const {
+	return std::string_view(strings + group_name_offset[group], group_name_length[group]);
+}
+
+bool SharedFrameView::isValid() const {
+	if (slot_sequence == nullptr) {
+		return false;
+	}
+	// reads of the data must not be reordered after the check
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return slot_sequence->load(std::memory_order_relaxed) == expected_sequence;
+}
+
+SharedFrameWriter::SharedFrameWriter(const std::string& name): SharedFrameWriter(name, Parameters()) {}
+
+SharedFrameWriter::SharedFrameWriter(const std::string& name, const Parameters& params):
+	name_(name),
+	memory_(nullptr),
+	size_(0),
+	published_(0)
+{
+	bool valid = params.slots > 0
+		&& params.slots <= UINT32_MAX
+		&& params.max_people <= UINT32_MAX
+		&& params.max_groups <= UINT32_MAX
+		&& params.max_string_bytes <= UINT32_MAX;
+	if (!valid) {
+		throw std::invalid_argument("Invalid capacities of the shared-memory segment '" + name + "'");
+	}
+	auto layout = computeLayout(params.max_people, params.max_groups, params.max_string_bytes);
+	size_ = computeSegmentSize(layout, params.slots);
+
+	// a new object, so readers of the previous one keep their (complete) mapping
+	shm_unlink(name.c_str());
+	int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+	if (fd == -1) {
+		throw createSystemError("Cannot create the shared-memory segment", name);
+	}
+	if (ftruncate(fd, size_) == -1) {
+		auto error = createSystemError("Cannot resize the shared-memory segment", name);
+		close(fd);
+		shm_unlink(name.c_str());
+		throw error;
+	}
+	memory_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (memory_ == MAP_FAILED) {
+		auto error = createSystemError("Cannot map the shared-memory segment", name);
+		shm_unlink(name.c_str());
+		throw error;
+	}
+
+	// the memory is zeroed, i.e., no frame is published and all slots are consistent
+	auto* header = new (memory_) SegmentHeader();
+	header->version = SEGMENT_VERSION;
+	header->slots = params.slots;
+	header->max_people = params.max_people;
+	header->max_groups = params.max_groups;
+	header->max_string_bytes = params.max_string_bytes;
+	header->latest.store(0, std::memory_order_relaxed);
+	for (size_t s = 0; s < params.slots; s++) {
+		new (static_cast<char*>(memory_) + alignUp(sizeof(SegmentHeader)) + s * layout.size) SlotHeader();
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+	header->magic = SEGMENT_MAGIC;
+}
+
+SharedFrameWriter::~SharedFrameWriter() {
+	munmap(memory_, size_);
+	shm_unlink(name_.c_str());
+}
+
+bool SharedFrameWriter::publish(const Frame& frame) {
+	auto* header = static_cast<SegmentHeader*>(memory_);
+	const auto& people = frame.people;
+	const auto& groups = frame.groups;
+	if (people.size() > header->max_people || groups.size() > header->max_groups) {
+		return false;
+	}
+
+	person_index_.clear();
+	group_index_.clear();
+	size_t string_bytes = frame.header.frame_id.size();
+	for (size_t i = 0; i < people.size(); i++) {
+		person_index_.emplace(people[i].getName(), i);
+		string_bytes += people[i].getName().size();
+	}
+	size_t num_members = 0;
+	for (size_t g = 0; g < groups.size(); g++) {
+		group_index_.emplace(groups[g].getName(), g);
+		string_bytes += groups[g].getName().size();
+		for (const auto& member: groups[g].getMembers()) {
+			num_members += person_index_.count(member.getName());
+		}
+	}
+	if (string_bytes > header->max_string_bytes || num_members > header->max_people) {
+		return false;
+	}
+	arrays_.assign(people);
+
+	auto layout = computeLayout(header->max_people, header->max_groups, header->max_string_bytes);
+	uint64_t number = published_ + 1;
+	void* slot = static_cast<char*>(memory_)
+		+ alignUp(sizeof(SegmentHeader))
+		+ (number - 1) % header->slots * layout.size;
+	auto* slot_header = static_cast<SlotHeader*>(slot);
+
+	uint64_t sequence = slot_header->sequence.load(std::memory_order_relaxed);
+	slot_header->sequence.store(sequence + 1, std::memory_order_relaxed);
+	// writes of the data must not be reordered before marking the slot
+	std::atomic_thread_fence(std::memory_order_release);
+
+	auto* strings = getArray<char>(slot, layout.strings);
+	uint32_t strings_size = 0;
+	auto intern = [&](const std::string& str, uint32_t& offset, uint32_t& length) {
+		std::memcpy(strings + strings_size, str.data(), str.size());
+		offset = strings_size;
+		length = str.size();
+		strings_size += str.size();
+	};
+
+	slot_header->number = number;
+	slot_header->stamp_sec = frame.header.stamp.sec;
+	slot_header->stamp_nsec = frame.header.stamp.nsec;
+	slot_header->seq = frame.header.seq;
+	slot_header->num_people = people.size();
+	slot_header->num_groups = groups.size();
+	intern(frame.header.frame_id, slot_header->frame_id_offset, slot_header->frame_id_length);
+
+	size_t num = people.size();
+	std::pair<const std::vector<double>*, size_t> person_arrays[] = {
+		{&arrays_.x, layout.x},
+		{&arrays_.y, layout.y},
+		{&arrays_.yaw, layout.yaw},
+		{&arrays_.vx, layout.vx},
+		{&arrays_.vy, layout.vy},
+		{&arrays_.cov_xx, layout.cov_xx},
+		{&arrays_.cov_xy, layout.cov_xy},
+		{&arrays_.cov_yy, layout.cov_yy}
+	};
+	for (const auto& array: person_arrays) {
+		std::memcpy(getArray<double>(slot, array.second), array.first->data(), num * sizeof(double));
+	}
+	auto* reliability = getArray<double>(slot, layout.reliability);
+	auto* group = getArray<uint32_t>(slot, layout.group);
+	auto* name_offset = getArray<uint32_t>(slot, layout.name_offset);
+	auto* name_length = getArray<uint32_t>(slot, layout.name_length);
+	for (size_t i = 0; i < num; i++) {
+		const auto& person = people[i];
+		reliability[i] = person.getReliability();
+		auto it = group_index_.find(person.getGroupName());
+		group[i] = it == group_index_.cend() ? SharedFrameView::NO_GROUP : it->second;
+		intern(person.getName(), name_offset[i], name_length[i]);
+	}
+
+	auto* group_x = getArray<double>(slot, layout.group_x);
+	auto* group_y = getArray<double>(slot, layout.group_y);
+	auto* group_yaw = getArray<double>(slot, layout.group_yaw);
+	auto* group_span_x = getArray<double>(slot, layout.group_span_x);
+	auto* group_span_y = getArray<double>(slot, layout.group_span_y);
+	auto* member_start = getArray<uint32_t>(slot, layout.group_member_start);
+	auto* members = getArray<uint32_t>(slot, layout.group_members);
+	auto* group_name_offset = getArray<uint32_t>(slot, layout.group_name_offset);
+	auto* group_name_length = getArray<uint32_t>(slot, layout.group_name_length);
+	uint32_t member_count = 0;
+	for (size_t g = 0; g < groups.size(); g++) {
+		auto ellipse = groups[g].getEllipse();
+		group_x[g] = ellipse.center_x;
+		group_y[g] = ellipse.center_y;
+		group_yaw[g] = ellipse.yaw;
+		group_span_x[g] = ellipse.span_x;
+		group_span_y[g] = ellipse.span_y;
+		member_start[g] = member_count;
+		for (const auto& member: groups[g].getMembers()) {
+			auto it = person_index_.find(member.getName());
+			if (it != person_index_.cend()) {
+				members[member_count++] = it->second;
+			}
+		}
+		intern(groups[g].getName(), group_name_offset[g], group_name_length[g]);
+	}
+	member_start[groups.size()] = member_count;
+
+	slot_header->sequence.store(sequence + 2, std::memory_order_release);
+	header->latest.store(number, std::memory_order_release);
+	published_ = number;
+	return true;
+}
+
+SharedFrameReader::SharedFrameReader(const std::string& name):
+	memory_(nullptr),
+	size_(0)
+{
+	int fd = shm_open(name.c_str(), O_RDONLY, 0);
+	if (fd == -1) {
+		throw createSystemError("Cannot open the shared-memory segment", name);
+	}
+	struct stat info;
+	if (fstat(fd, &info) == -1) {
+		auto error = createSystemError("Cannot inspect the shared-memory segment", name);
+		close(fd);
+		throw error;
+	}
+	size_ = info.st_size;
+	if (size_ < sizeof(SegmentHeader)) {
+		close(fd);
+		throw std::runtime_error("The shared-memory segment '" + name + "' does not contain frames");
+	}
+	memory_ = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (memory_ == MAP_FAILED) {
+		throw createSystemError("Cannot map the shared-memory segment", name);
+	}
+
+	const auto* header = static_cast<const SegmentHeader*>(memory_);
+	bool valid = header->magic == SEGMENT_MAGIC && header->version == SEGMENT_VERSION && header->slots > 0;
+	if (valid) {
+		std::atomic_thread_fence(std::memory_order_acquire);
+		auto layout = computeLayout(header->max_people, header->max_groups, header->max_string_bytes);
+		valid = size_ >= computeSegmentSize(layout, header->slots);
+	}
+	if (!valid) {
+		munmap(const_cast<void*>(memory_), size_);
+		throw std::runtime_error("The shared-memory segment '" + name + "' does not contain frames");
+	}
+}
+
+SharedFrameReader::~SharedFrameReader() {
+	munmap(const_cast<void*>(memory_), size_);
+}
+
+uint64_t SharedFrameReader::getLatestNumber() const {
+	return static_cast<const SegmentHeader*>(memory_)->latest.load(std::memory_order_acquire);
+}
+
+bool SharedFrameReader::getLatest(SharedFrameView& view) const {
+	const auto* header = static_cast<const SegmentHeader*>(memory_);
+	auto layout = computeLayout(header->max_people, header->max_groups, header->max_string_bytes);
+	while (true) {
+		uint64_t number = header->latest.load(std::memory_order_acquire);
+		if (number == 0) {
+			view = SharedFrameView();
+			return false;
+		}
+		const void* slot = static_cast<const char*>(memory_)
+			+ alignUp(sizeof(SegmentHeader))
+			+ (number - 1) % header->slots * layout.size;
+		const auto* slot_header = static_cast<const SlotHeader*>(slot);
+		uint64_t sequence = slot_header->sequence.load(std::memory_order_acquire);
+		if (sequence % 2 == 1) {
+			// the writer has lapped the ring in the meantime
+			continue;
+		}
+
+		view.number = slot_header->number;
+		view.stamp = ros::Time(slot_header->stamp_sec, slot_header->stamp_nsec);
+		view.seq = slot_header->seq;
+		view.num_people = std::min<size_t>(slot_header->num_people, header->max_people);
+		view.num_groups = std::min<size_t>(slot_header->num_groups, header->max_groups);
+		view.strings = getArray<char>(slot, layout.strings);
+		view.frame_id = std::string_view(view.strings + slot_header->frame_id_offset, slot_header->frame_id_length);
+		view.slot_sequence = &slot_header->sequence;
+		view.expected_sequence = sequence;
+		if (!view.isValid() || view.number != number) {
+			continue;
+		}
+
+		view.x = getArray<double>(slot, layout.x);
+		view.y = getArray<double>(slot, layout.y);
+		view.yaw = getArray<double>(slot, layout.yaw);
+		view.vx = getArray<double>(slot, layout.vx);
+		view.vy = getArray<double>(slot, layout.vy);
+		view.cov_xx = getArray<double>(slot, layout.cov_xx);
+		view.cov_xy = getArray<double>(slot, layout.cov_xy);
+		view.cov_yy = getArray<double>(slot, layout.cov_yy);
+		view.reliability = getArray<double>(slot, layout.reliability);
+		view.group = getArray<uint32_t>(slot, layout.group);
+		view.name_offset = getArray<uint32_t>(slot, layout.name_offset);
+		view.name_length = getArray<uint32_t>(slot, layout.name_length);
+		view.group_x = getArray<double>(slot, layout.group_x);
+		view.group_y = getArray<double>(slot, layout.group_y);
+		view.group_yaw = getArray<double>(slot, layout.group_yaw);
+		view.group_span_x = getArray<double>(slot, layout.group_span_x);
+		view.group_span_y = getArray<double>(slot, layout.group_span_y);
+		view.group_member_start = getArray<uint32_t>(slot, layout.group_member_start);
+		view.group_members = getArray<uint32_t>(slot, layout.group_members);
+		view.group_name_offset = getArray<uint32_t>(slot, layout.group_name_offset);
+		view.group_name_length = getArray<uint32_t>(slot, layout.group_name_length);
+		return true;
+	}
+}
+
+} // namespace people_msgs_utils
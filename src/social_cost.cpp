@@ -0,0 +1,225 @@
+#include <people_msgs_utils/social_cost.h>
+#include <people_msgs_utils/vectorization.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace people_msgs_utils {
+
+/// The cost at this Mahalanobis distance is below 1e-290 anyway
+static constexpr double CUTOFF_MAX = 36.0;
+
+/**
+ * @brief Evaluates the Gaussian along a row of @ref num points with equally spaced x coordinates, combining
+ * the results with @ref out according to @ref SUM
+ *
+ * @param dx0 x coordinate of the first point relative to the center of the Gaussian
+ * @param dy y coordinate of the points relative to the center of the Gaussian
+ */
+template <bool SUM>
+static void evaluateRow(
+	double a,
+	double b,
+	double c,
+	double amplitude,
+	double exponent_min,
+	double dx0,
+	double step,
+	double dy,
+	int num,
+	double* out
+) {
+	double c1 = 2.0 * b * dy;
+	double c0 = c * dy * dy;
+	for (int k = 0; k < num; k++) {
+		double dx = dx0 + static_cast<double>(k) * step;
+		double exponent = -0.5 * ((a * dx + c1) * dx + c0);
+		double value = vectorization::maskBelow(
+			amplitude * vectorization::expNonPositive(exponent),
+			exponent,
+			exponent_min
+		);
+		out[k] = SUM ? out[k] + value : vectorization::maxNonNegative(out[k], value);
+	}
+}
+
+/// Evaluates the Gaussian at arbitrary points, combining the results with @ref out according to @ref SUM
+template <bool SUM>
+static void evaluateScattered(
+	double a,
+	double b,
+	double c,
+	double amplitude,
+	double exponent_min,
+	double center_x,
+	double center_y,
+	const double* xs,
+	const double* ys,
+	size_t num,
+	double* out
+) {
+	for (size_t k = 0; k < num; k++) {
+		double dx = xs[k] - center_x;
+		double dy = ys[k] - center_y;
+		double exponent = -0.5 * (a * dx * dx + 2.0 * b * dx * dy + c * dy * dy);
+		double value = vectorization::maskBelow(
+			amplitude * vectorization::expNonPositive(exponent),
+			exponent,
+			exponent_min
+		);
+		out[k] = SUM ? out[k] + value : vectorization::maxNonNegative(out[k], value);
+	}
+}
+
+SocialCostModel::SocialCostModel():
+	SocialCostModel(Parameters())
+{}
+
+SocialCostModel::SocialCostModel(const Parameters& params):
+	params_(params)
+{
+	// keeps exponents of the evaluated points within the domain of expNonPositive
+	params_.cutoff = std::clamp(params_.cutoff, 0.0, CUTOFF_MAX);
+	// costs must not be negative for the MAX reduction
+	params_.person_amplitude = std::max(params_.person_amplitude, 0.0);
+	params_.group_amplitude = std::max(params_.group_amplitude, 0.0);
+}
+
+void SocialCostModel::setFrame(const People& people, const Groups& groups) {
+	gaussians_.clear();
+	double person_variance = params_.person_sigma * params_.person_sigma;
+	for (const auto& person: people) {
+		double sxx = person_variance;
+		double sxy = 0.0;
+		double syy = person_variance;
+		if (params_.use_covariance) {
+			sxx += person.getCovariancePoseXX();
+			sxy += person.getCovariancePoseXY();
+			syy += person.getCovariancePoseYY();
+		}
+		addGaussian(person.getPositionX(), person.getPositionY(), params_.person_amplitude, sxx, sxy, syy);
+	}
+
+	for (const auto& group: groups) {
+		// variances along the axes of the ellipse, rotated to the global frame
+		double sigma_a = params_.group_sigma_scale * group.getSpanX() / 2.0;
+		double sigma_b = params_.group_sigma_scale * group.getSpanY() / 2.0;
+		double yaw = group.getOrientationYaw();
+		double cos_yaw = std::cos(yaw);
+		double sin_yaw = std::sin(yaw);
+		double var_a = sigma_a * sigma_a;
+		double var_b = sigma_b * sigma_b;
+		double sxx = var_a * cos_yaw * cos_yaw + var_b * sin_yaw * sin_yaw;
+		double sxy = (var_a - var_b) * cos_yaw * sin_yaw;
+		double syy = var_a * sin_yaw * sin_yaw + var_b * cos_yaw * cos_yaw;
+		if (params_.use_covariance) {
+			sxx += group.getCovariancePoseXX();
+			sxy += group.getCovariancePoseXY();
+			syy += group.getCovariancePoseYY();
+		}
+		addGaussian(group.getPositionX(), group.getPositionY(), params_.group_amplitude, sxx, sxy, syy);
+	}
+}
+
+void SocialCostModel::evaluateGrid(const GridWindow& grid, std::vector<double>& costs) const {
+	costs.assign(grid.size_x * grid.size_y, 0.0);
+	if (costs.empty() || grid.resolution <= 0.0) {
+		return;
+	}
+	double exponent_min = -0.5 * params_.cutoff * params_.cutoff;
+	// coordinates of the first and the last cell centers
+	double x_first = grid.origin_x + 0.5 * grid.resolution;
+	double y_first = grid.origin_y + 0.5 * grid.resolution;
+	double x_last = x_first + static_cast<double>(grid.size_x - 1) * grid.resolution;
+	double y_last = y_first + static_cast<double>(grid.size_y - 1) * grid.resolution;
+
+	for (const auto& g: gaussians_) {
+		if (g.max_x < x_first || g.min_x > x_last || g.max_y < y_first || g.min_y > y_last) {
+			continue;
+		}
+		// range of cells overlapped by the bounding box
+		auto to_index = [&](double coord, double first, size_t size) {
+			double index = std::ceil((coord - first) / grid.resolution);
+			return static_cast<size_t>(std::clamp(index, 0.0, static_cast<double>(size - 1)));
+		};
+		size_t i_min = to_index(g.min_x, x_first, grid.size_x);
+		size_t i_max = static_cast<size_t>(std::clamp(
+			std::floor((g.max_x - x_first) / grid.resolution),
+			0.0,
+			static_cast<double>(grid.size_x - 1)
+		));
+		size_t j_min = to_index(g.min_y, y_first, grid.size_y);
+		size_t j_max = static_cast<size_t>(std::clamp(
+			std::floor((g.max_y - y_first) / grid.resolution),
+			0.0,
+			static_cast<double>(grid.size_y - 1)
+		));
+		if (i_min > i_max || j_min > j_max) {
+			continue;
+		}
+
+		double dx0 = x_first + static_cast<double>(i_min) * grid.resolution - g.center_x;
+		int num = static_cast<int>(i_max - i_min + 1);
+		for (size_t j = j_min; j <= j_max; j++) {
+			double dy = y_first + static_cast<double>(j) * grid.resolution - g.center_y;
+			double* out = costs.data() + j * grid.size_x + i_min;
+			if (params_.reduction == Reduction::SUM) {
+				evaluateRow<true>(g.a, g.b, g.c, g.amplitude, exponent_min, dx0, grid.resolution, dy, num, out);
+			} else {
+				evaluateRow<false>(g.a, g.b, g.c, g.amplitude, exponent_min, dx0, grid.resolution, dy, num, out);
+			}
+		}
+	}
+}
+
+void SocialCostModel::evaluatePoints(const double* xs, const double* ys, size_t num, double* costs) const {
+	std::fill(costs, costs + num, 0.0);
+	if (num == 0) {
+		return;
+	}
+	// Gaussians that do not overlap the bounding box of all points are skipped
+	auto [x_min, x_max] = std::minmax_element(xs, xs + num);
+	auto [y_min, y_max] = std::minmax_element(ys, ys + num);
+	double exponent_min = -0.5 * params_.cutoff * params_.cutoff;
+	for (const auto& g: gaussians_) {
+		if (g.max_x < *x_min || g.min_x > *x_max || g.max_y < *y_min || g.min_y > *y_max) {
+			continue;
+		}
+		if (params_.reduction == Reduction::SUM) {
+			evaluateScattered<true>(g.a, g.b, g.c, g.amplitude, exponent_min, g.center_x, g.center_y, xs, ys, num, costs);
+		} else {
+			evaluateScattered<false>(g.a, g.b, g.c, g.amplitude, exponent_min, g.center_x, g.center_y, xs, ys, num, costs);
+		}
+	}
+}
+
+double SocialCostModel::evaluate(double x, double y) const {
+	double cost = 0.0;
+	evaluatePoints(&x, &y, 1, &cost);
+	return cost;
+}
+
+void SocialCostModel::addGaussian(double x, double y, double amplitude, double sxx, double sxy, double syy) {
+	double det = sxx * syy - sxy * sxy;
+	if (!(det > 0.0) || !(sxx > 0.0) || !std::isfinite(det) || !std::isfinite(x) || !std::isfinite(y)) {
+		// degenerate shape, e.g., a group whose spatial model could not be computed
+		return;
+	}
+	Gaussian g;
+	g.center_x = x;
+	g.center_y = y;
+	g.amplitude = amplitude;
+	g.a = syy / det;
+	g.b = -sxy / det;
+	g.c = sxx / det;
+	// extents of the ellipse at the cut-off Mahalanobis distance
+	double extent_x = params_.cutoff * std::sqrt(sxx);
+	double extent_y = params_.cutoff * std::sqrt(syy);
+	g.min_x = x - extent_x;
+	g.max_x = x + extent_x;
+	g.min_y = y - extent_y;
+	g.max_y = y + extent_y;
+	gaussians_.push_back(g);
+}
+
+} // namespace people_msgs_utils
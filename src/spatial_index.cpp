@@ -0,0 +1,296 @@
+#include <people_msgs_utils/spatial_index.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace people_msgs_utils {
+
+/// Bounds the number of grid cells relative to the number of items, e.g., when some item is far away from the rest
+static constexpr double CELLS_PER_ITEM_MAX = 4.0;
+static constexpr double CELLS_MIN = 1024.0;
+/// Bounds cell coordinates, so they can safely be converted to integers
+static constexpr double CELL_COORD_LIMIT = 1e15;
+
+/**
+ * @brief Converts counts of items stored in @ref start (count of cell i at index i+1) into the beginnings of ranges
+ */
+static void countsToOffsets(std::vector<size_t>& start) {
+	for (size_t i = 1; i < start.size(); i++) {
+		start[i] += start[i - 1];
+	}
+}
+
+/**
+ * @brief Restores beginnings of ranges after they were advanced while filling the cells
+ */
+static void restoreOffsets(std::vector<size_t>& start) {
+	for (size_t i = start.size() - 1; i > 0; i--) {
+		start[i] = start[i - 1];
+	}
+	start[0] = 0;
+}
+
+SpatialIndex::SpatialIndex(double cell_size):
+	cell_size_(cell_size > 0.0 ? cell_size : 1.0),
+	cell_size_effective_(cell_size_),
+	origin_x_(0.0),
+	origin_y_(0.0),
+	cells_x_(0),
+	cells_y_(0)
+{}
+
+void SpatialIndex::build(const People& people, const Groups& groups) {
+	people_x_.clear();
+	people_y_.clear();
+	for (const auto& person: people) {
+		people_x_.push_back(person.getPositionX());
+		people_y_.push_back(person.getPositionY());
+	}
+
+	ellipses_.clear();
+	for (const auto& group: groups) {
+		ellipses_.push_back(OSpaceEllipse::fromGroup(group));
+	}
+
+	// bounds of all items
+	double min_x = std::numeric_limits<double>::infinity();
+	double min_y = std::numeric_limits<double>::infinity();
+	double max_x = -std::numeric_limits<double>::infinity();
+	double max_y = -std::numeric_limits<double>::infinity();
+	size_t items = 0;
+	for (size_t i = 0; i < people_x_.size(); i++) {
+		if (!std::isfinite(people_x_[i]) || !std::isfinite(people_y_[i])) {
+			continue;
+		}
+		min_x = std::min(min_x, people_x_[i]);
+		min_y = std::min(min_y, people_y_[i]);
+		max_x = std::max(max_x, people_x_[i]);
+		max_y = std::max(max_y, people_y_[i]);
+		items++;
+	}
+	for (const auto& ellipse: ellipses_) {
+		if (!ellipse.valid) {
+			continue;
+		}
+		min_x = std::min(min_x, ellipse.min_x);
+		min_y = std::min(min_y, ellipse.min_y);
+		max_x = std::max(max_x, ellipse.max_x);
+		max_y = std::max(max_y, ellipse.max_y);
+		items++;
+	}
+
+	if (items == 0) {
+		cells_x_ = 0;
+		cells_y_ = 0;
+		people_cell_start_.assign(1, 0);
+		people_cells_.clear();
+		groups_cell_start_.assign(1, 0);
+		groups_cells_.clear();
+		return;
+	}
+
+	// dimensions of the grid
+	cell_size_effective_ = cell_size_;
+	double cells_max = std::max(CELLS_MIN, CELLS_PER_ITEM_MAX * static_cast<double>(items));
+	double cells_x = 0.0;
+	double cells_y = 0.0;
+	while (true) {
+		cells_x = std::floor((max_x - min_x) / cell_size_effective_) + 1.0;
+		cells_y = std::floor((max_y - min_y) / cell_size_effective_) + 1.0;
+		if (cells_x * cells_y <= cells_max) {
+			break;
+		}
+		cell_size_effective_ *= 2.0;
+	}
+	origin_x_ = min_x;
+	origin_y_ = min_y;
+	cells_x_ = static_cast<long long>(cells_x);
+	cells_y_ = static_cast<long long>(cells_y);
+	size_t cells = static_cast<size_t>(cells_x_ * cells_y_);
+
+	// counting sort of people into cells
+	people_cell_start_.assign(cells + 1, 0);
+	for (size_t i = 0; i < people_x_.size(); i++) {
+		if (!std::isfinite(people_x_[i]) || !std::isfinite(people_y_[i])) {
+			continue;
+		}
+		people_cell_start_[toCellIndex(toCell(people_x_[i], origin_x_), toCell(people_y_[i], origin_y_)) + 1]++;
+	}
+	countsToOffsets(people_cell_start_);
+	people_cells_.resize(people_cell_start_.back());
+	for (size_t i = 0; i < people_x_.size(); i++) {
+		if (!std::isfinite(people_x_[i]) || !std::isfinite(people_y_[i])) {
+			continue;
+		}
+		size_t cell = toCellIndex(toCell(people_x_[i], origin_x_), toCell(people_y_[i], origin_y_));
+		people_cells_[people_cell_start_[cell]++] = i;
+	}
+	restoreOffsets(people_cell_start_);
+
+	// groups are stored in each cell overlapped by their bounding boxes
+	groups_cell_start_.assign(cells + 1, 0);
+	for (int pass = 0; pass < 2; pass++) {
+		for (size_t i = 0; i < ellipses_.size(); i++) {
+			const auto& ellipse = ellipses_[i];
+			if (!ellipse.valid) {
+				continue;
+			}
+			long long cx_min = std::max(toCell(ellipse.min_x, origin_x_), 0LL);
+			long long cx_max = std::min(toCell(ellipse.max_x, origin_x_), cells_x_ - 1);
+			long long cy_min = std::max(toCell(ellipse.min_y, origin_y_), 0LL);
+			long long cy_max = std::min(toCell(ellipse.max_y, origin_y_), cells_y_ - 1);
+			for (long long cy = cy_min; cy <= cy_max; cy++) {
+				for (long long cx = cx_min; cx <= cx_max; cx++) {
+					size_t cell = toCellIndex(cx, cy);
+					if (pass == 0) {
+						groups_cell_start_[cell + 1]++;
+					} else {
+						groups_cells_[groups_cell_start_[cell]++] = i;
+					}
+				}
+			}
+		}
+		if (pass == 0) {
+			countsToOffsets(groups_cell_start_);
+			groups_cells_.resize(groups_cell_start_.back());
+		}
+	}
+	restoreOffsets(groups_cell_start_);
+}
+
+void SpatialIndex::queryRadius(double x, double y, double radius, std::vector<size_t>& indices) const {
+	indices.clear();
+	if (cells_x_ == 0 || radius < 0.0) {
+		return;
+	}
+	long long cx_min = std::max(toCell(x - radius, origin_x_), 0LL);
+	long long cx_max = std::min(toCell(x + radius, origin_x_), cells_x_ - 1);
+	long long cy_min = std::max(toCell(y - radius, origin_y_), 0LL);
+	long long cy_max = std::min(toCell(y + radius, origin_y_), cells_y_ - 1);
+	double radius_sq = radius * radius;
+	for (long long cy = cy_min; cy <= cy_max; cy++) {
+		for (long long cx = cx_min; cx <= cx_max; cx++) {
+			size_t cell = toCellIndex(cx, cy);
+			for (size_t j = people_cell_start_[cell]; j < people_cell_start_[cell + 1]; j++) {
+				size_t i = people_cells_[j];
+				double dx = people_x_[i] - x;
+				double dy = people_y_[i] - y;
+				if (dx * dx + dy * dy <= radius_sq) {
+					indices.push_back(i);
+				}
+			}
+		}
+	}
+}
+
+std::vector<size_t> SpatialIndex::queryRadius(double x, double y, double radius) const {
+	std::vector<size_t> indices;
+	queryRadius(x, y, radius, indices);
+	return indices;
+}
+
+void SpatialIndex::queryNearest(double x, double y, size_t k, std::vector<size_t>& indices) const {
+	indices.clear();
+	k = std::min(k, people_cells_.size());
+	if (cells_x_ == 0 || k == 0) {
+		return;
+	}
+
+	// max-heap of the best candidates found so far: squared distance and index (ties resolved by index)
+	static thread_local std::vector<std::pair<double, size_t>> heap;
+	heap.clear();
+	auto visit_cell = [&](long long cx, long long cy) {
+		if (cx < 0 || cx >= cells_x_ || cy < 0 || cy >= cells_y_) {
+			return;
+		}
+		size_t cell = toCellIndex(cx, cy);
+		for (size_t j = people_cell_start_[cell]; j < people_cell_start_[cell + 1]; j++) {
+			size_t i = people_cells_[j];
+			double dx = people_x_[i] - x;
+			double dy = people_y_[i] - y;
+			std::pair<double, size_t> candidate(dx * dx + dy * dy, i);
+			if (heap.size() < k) {
+				heap.push_back(candidate);
+				std::push_heap(heap.begin(), heap.end());
+			} else if (candidate < heap.front()) {
+				std::pop_heap(heap.begin(), heap.end());
+				heap.back() = candidate;
+				std::push_heap(heap.begin(), heap.end());
+			}
+		}
+	};
+
+	// visit rings of cells (Chebyshev distance from the query cell) starting from the first one touching the grid
+	long long qx = toCell(x, origin_x_);
+	long long qy = toCell(y, origin_y_);
+	long long ring_first = std::max({0LL, -qx, qx - (cells_x_ - 1), -qy, qy - (cells_y_ - 1)});
+	long long ring_last = std::max({qx, cells_x_ - 1 - qx, qy, cells_y_ - 1 - qy});
+	for (long long r = ring_first; r <= ring_last; r++) {
+		// points in cells of the ring r are at least (r - 1) cells away from the query point
+		double distance_min = static_cast<double>(std::max(r - 1, 0LL)) * cell_size_effective_;
+		if (heap.size() == k && distance_min * distance_min > heap.front().first) {
+			break;
+		}
+		for (long long cy = std::max(qy - r, 0LL); cy <= std::min(qy + r, cells_y_ - 1); cy++) {
+			if (cy == qy - r || cy == qy + r) {
+				for (long long cx = std::max(qx - r, 0LL); cx <= std::min(qx + r, cells_x_ - 1); cx++) {
+					visit_cell(cx, cy);
+				}
+			} else {
+				visit_cell(qx - r, cy);
+				if (r > 0) {
+					visit_cell(qx + r, cy);
+				}
+			}
+		}
+	}
+
+	std::sort_heap(heap.begin(), heap.end());
+	for (const auto& candidate: heap) {
+		indices.push_back(candidate.second);
+	}
+}
+
+std::vector<size_t> SpatialIndex::queryNearest(double x, double y, size_t k) const {
+	std::vector<size_t> indices;
+	queryNearest(x, y, k, indices);
+	return indices;
+}
+
+void SpatialIndex::queryGroupsContaining(double x, double y, std::vector<size_t>& indices) const {
+	indices.clear();
+	if (cells_x_ == 0) {
+		return;
+	}
+	long long cx = toCell(x, origin_x_);
+	long long cy = toCell(y, origin_y_);
+	if (cx < 0 || cx >= cells_x_ || cy < 0 || cy >= cells_y_) {
+		return;
+	}
+	size_t cell = toCellIndex(cx, cy);
+	for (size_t j = groups_cell_start_[cell]; j < groups_cell_start_[cell + 1]; j++) {
+		size_t i = groups_cells_[j];
+		const auto& ellipse = ellipses_[i];
+		if (x < ellipse.min_x || x > ellipse.max_x || y < ellipse.min_y || y > ellipse.max_y) {
+			continue;
+		}
+		if (ellipse.contains(x, y)) {
+			indices.push_back(i);
+		}
+	}
+}
+
+std::vector<size_t> SpatialIndex::queryGroupsContaining(double x, double y) const {
+	std::vector<size_t> indices;
+	queryGroupsContaining(x, y, indices);
+	return indices;
+}
+
+long long SpatialIndex::toCell(double coord, double origin) const {
+	double cell = std::floor((coord - origin) / cell_size_effective_);
+	return static_cast<long long>(std::clamp(cell, -CELL_COORD_LIMIT, CELL_COORD_LIMIT));
+}
+
+} // namespace people_msgs_utils
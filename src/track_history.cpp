@@ -0,0 +1,144 @@
+#include <people_msgs_utils/track_history.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace people_msgs_utils {
+
+TrackHistory::TrackHistory():
+	TrackHistory(Parameters())
+{}
+
+TrackHistory::TrackHistory(const Parameters& params):
+	params_(params)
+{
+	params_.capacity = std::max<size_t>(params_.capacity, 1);
+	params_.max_tracks = std::max<size_t>(params_.max_tracks, 1);
+	params_.velocity_smoothing = std::clamp(params_.velocity_smoothing, 1e-6, 1.0);
+	params_.acceleration_smoothing = std::clamp(params_.acceleration_smoothing, 1e-6, 1.0);
+
+	// everything is allocated upfront
+	tracks_.resize(params_.max_tracks);
+	states_.resize(params_.max_tracks * params_.capacity);
+	ids_.reserve(params_.max_tracks);
+	spare_nodes_.reserve(params_.max_tracks);
+	clear();
+}
+
+void TrackHistory::update(const People& people, double stamp) {
+	for (const auto& person: people) {
+		update(person, stamp);
+	}
+	evict(stamp);
+}
+
+size_t TrackHistory::update(const Person& person, double stamp) {
+	size_t track = find(person.getName());
+	if (track == NONE) {
+		track = allocate(person.getName());
+	}
+	auto& t = tracks_[track];
+
+	// the tracker reused the ID for another person
+	if (person.getTrackAge() < t.track_age) {
+		t.count = 0;
+	}
+	if (t.count > 0 && !(stamp > getLastSeen(track))) {
+		return track;
+	}
+	t.track_age = person.getTrackAge();
+
+	TrackState state{stamp, person.getPositionX(), person.getPositionY(), person.getOrientationYaw()};
+	auto& e = t.estimate;
+	if (t.count == 0) {
+		e = TrackEstimate{person.getVelocityX(), person.getVelocityY(), 0.0, 0.0, 0.0};
+	} else {
+		// exponential moving averages of finite differences
+		const auto& prev = getState(track, 0);
+		double dt = stamp - prev.stamp;
+		double vx = e.vx + params_.velocity_smoothing * ((state.x - prev.x) / dt - e.vx);
+		double vy = e.vy + params_.velocity_smoothing * ((state.y - prev.y) / dt - e.vy);
+		e.ax += params_.acceleration_smoothing * ((vx - e.vx) / dt - e.ax);
+		e.ay += params_.acceleration_smoothing * ((vy - e.vy) / dt - e.ay);
+		e.vx = vx;
+		e.vy = vy;
+		double yaw_change = std::remainder(state.yaw - prev.yaw, 2.0 * M_PI);
+		e.heading_rate += params_.velocity_smoothing * (yaw_change / dt - e.heading_rate);
+	}
+
+	t.head = t.count == 0 ? 0 : (t.head + 1) % params_.capacity;
+	t.count = std::min(t.count + 1, params_.capacity);
+	states_[track * params_.capacity + t.head] = state;
+	return track;
+}
+
+size_t TrackHistory::evict(double stamp) {
+	size_t evicted = 0;
+	for (size_t track = 0; track < tracks_.size(); track++) {
+		if (tracks_[track].count > 0 && getLastSeen(track) < stamp - params_.timeout) {
+			release(track);
+			evicted++;
+		}
+	}
+	return evicted;
+}
+
+void TrackHistory::clear() {
+	for (size_t track = 0; track < tracks_.size(); track++) {
+		if (tracks_[track].count > 0) {
+			release(track);
+		}
+	}
+	free_slots_.clear();
+	// slots with lower indices are allocated first
+	for (size_t track = tracks_.size(); track > 0; track--) {
+		free_slots_.push_back(track - 1);
+	}
+}
+
+size_t TrackHistory::find(const std::string& name) const {
+	auto it = ids_.find(name);
+	return it == ids_.cend() ? NONE : it->second;
+}
+
+size_t TrackHistory::allocate(const std::string& name) {
+	if (free_slots_.empty()) {
+		// evict the least recently seen track
+		size_t oldest = 0;
+		for (size_t track = 1; track < tracks_.size(); track++) {
+			if (getLastSeen(track) < getLastSeen(oldest)) {
+				oldest = track;
+			}
+		}
+		release(oldest);
+	}
+	size_t track = free_slots_.back();
+	free_slots_.pop_back();
+
+	auto& t = tracks_[track];
+	t.name = name;
+	t.track_age = 0;
+	t.head = 0;
+	t.count = 0;
+	if (spare_nodes_.empty()) {
+		ids_.emplace(name, track);
+	} else {
+		auto node = std::move(spare_nodes_.back());
+		spare_nodes_.pop_back();
+		node.key() = name;
+		node.mapped() = track;
+		ids_.insert(std::move(node));
+	}
+	return track;
+}
+
+void TrackHistory::release(size_t track) {
+	auto it = ids_.find(tracks_[track].name);
+	if (it != ids_.end()) {
+		spare_nodes_.push_back(ids_.extract(it));
+	}
+	tracks_[track].count = 0;
+	free_slots_.push_back(track);
+}
+
+} // namespace people_msgs_utils
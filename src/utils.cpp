@@ -1,201 +1,307 @@
 #include <people_msgs_utils/utils.h>
+#include <people_msgs_utils/group_cache.h>
+#include <people_msgs_utils/instrumentation.h>
 
-#include <map>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
 #include <tuple>
 
 namespace people_msgs_utils {
 
-std::pair<std::vector<Person>, std::vector<Group>> createFromPeople(const std::vector<people_msgs::Person>& people) {
-	if (people.empty()) {
-		return std::make_pair(std::vector<Person>(), std::vector<Group>());
+/**
+ * @brief Resizes @ref v reusing the existing elements; new elements are copies of @ref placeholder
+ *
+ * In contrast to std::vector::resize, does not require T to be default-constructible
+ */
+template <typename T>
+static void resizeReusing(std::vector<T>& v, size_t size, const T& placeholder) {
+	if (v.size() > size) {
+		v.erase(v.begin() + size, v.end());
+	}
+	while (v.size() < size) {
+		v.push_back(placeholder);
 	}
+}
+
+/**
+ * @brief Temporary buffers of @ref createFromPeopleImpl, kept between calls to avoid reallocations
+ */
+struct ConversionWorkspace {
+	/// Sequence of a single group's members (indices of people) within the @ref member_indices
+	struct GroupRange {
+		size_t begin;
+		size_t end;
+	};
+	/// Indices of people assigned to any group, sorted by group name (and then by index)
+	std::vector<size_t> grouped;
+	/// Indices of unique group members, consecutive per group
+	std::vector<size_t> member_indices;
+	/// Groups with multiple members
+	std::vector<GroupRange> groups_valid;
+	/// Members of each valid group
+	std::vector<std::vector<Person>> group_members;
+	/// Sorted names of all tracked people
+	std::vector<std::string_view> names_tracked;
+};
+
+/// Used to grow vectors of people, as Person is not default-constructible
+static const Person& getPersonPlaceholder() {
+	static const Person PERSON_PLACEHOLDER(
+		std::string(),
+		geometry_msgs::PoseWithCovariance(),
+		geometry_msgs::PoseWithCovariance(),
+		0.0,
+		true,
+		false,
+		0,
+		0,
+		std::string()
+	);
+	return PERSON_PLACEHOLDER;
+}
+
+/**
+ * @brief Stage 1 of @ref createFromPeopleImpl: converts people and parses their tags into @ref output
+ *
+ * @tparam PersonT type providing name, position, velocity, reliability, tagnames and tags members
+ */
+template <typename PersonT>
+static void createPeopleImpl(const std::vector<PersonT>& people, People& output, const ParallelFor& parallel_for) {
+	PEOPLE_MSGS_UTILS_RECORD_SCOPE(instrumentation::Stage::PARSE_PEOPLE, people.size());
+	resizeReusing(output, people.size(), getPersonPlaceholder());
+	forEachIndex(
+		people.size(),
+		[&](size_t i) {
+			const auto& person_std = people[i];
+			output[i].assign(
+				person_std.name,
+				person_std.position,
+				person_std.velocity,
+				person_std.reliability,
+				person_std.tagnames,
+				person_std.tags
+			);
+		},
+		parallel_for
+	);
+}
+
+/**
+ * @brief Implementation of @ref createFromPeople shared by people_msgs::Person and PersonView inputs
+ *
+ * Stage 1 and Stages 4/5 are independent per person or per group, so they are distributed with @ref parallel_for
+ * (if given). Results are stored in slots indexed like the sequential loop, so the output order is deterministic.
+ *
+ * Outputs overwrite the contents of @ref frame element-wise, and temporaries are kept in a workspace of the calling
+ * thread, so the conversion of frames of similar shape does not reallocate.
+ *
+ * @param cache optional; provides ellipses of groups instead of fitting and is updated with the created groups
+ *
+ * @tparam PersonT type providing name, position, velocity, reliability, tagnames and tags members
+ */
+template <typename PersonT>
+static void createFromPeopleImpl(
+	const std::vector<PersonT>& people,
+	Frame& frame,
+	const ParallelFor& parallel_for,
+	GroupCache* cache = nullptr
+) {
+	PEOPLE_MSGS_UTILS_RECORD_SCOPE(instrumentation::Stage::CREATE_FROM_PEOPLE, people.size());
+	// referenced explicitly, as the name of a thread_local variable used in tasks would resolve to the worker's one
+	static thread_local ConversionWorkspace workspace;
+	auto& ws = workspace;
+	auto& people_total = frame.people;
+	auto& groups_total = frame.groups;
 
 	/*
 	 * Stage 1
 	 */
 	// convert and parse people data
-	std::vector<Person> people_total;
-	for (const auto& person_std: people) {
-		people_total.emplace_back(Person(person_std));
-	}
+	createPeopleImpl(people, people_total, parallel_for);
 
 	/*
-	 * Stage 2
+	 * Stages 2 and 3
 	 */
-	// temporary group that helps in further association
-	struct GroupPrimitive {
-		std::string id;
-		std::vector<std::string> track_names;
-	};
-	// collect group IDs with member IDs
-	std::vector<GroupPrimitive> groups_primitive;
-	for (const auto& person: people_total) {
-		if (!person.isAssignedToGroup()) {
-			continue;
+	PEOPLE_MSGS_UTILS_RECORD_START(record_collect, instrumentation::Stage::COLLECT_GROUPS);
+	// collect people assigned to groups; sorting by group name yields the same order of groups as std::map did
+	ws.grouped.clear();
+	for (size_t i = 0; i < people_total.size(); i++) {
+		if (people_total[i].isAssignedToGroup()) {
+			ws.grouped.push_back(i);
 		}
-
-		bool found_matching_group = false;
-		for (auto& group: groups_primitive) {
-			if (person.getGroupName() == group.id) {
-				// found group of the person
-				group.track_names.push_back(person.getName());
-				// found matching group, let's check next **person**
-				found_matching_group = true;
-				break;
-			}
+	}
+	std::sort(
+		ws.grouped.begin(),
+		ws.grouped.end(),
+		[&](size_t lhs, size_t rhs) {
+			int cmp = people_total[lhs].getGroupName().compare(people_total[rhs].getGroupName());
+			return cmp < 0 || (cmp == 0 && lhs < rhs);
 		}
+	);
 
-		if (found_matching_group) {
-			continue;
+	// collect unique members of each group (the first occurrence of the name wins), keep groups with multiple members
+	ws.member_indices.clear();
+	ws.groups_valid.clear();
+	// read only by the instrumentation
+	size_t groups_collected = 0;
+	(void)groups_collected;
+	for (size_t begin = 0; begin < ws.grouped.size(); ) {
+		const auto& group_name = people_total[ws.grouped[begin]].getGroupName();
+		size_t end = begin + 1;
+		while (end < ws.grouped.size() && people_total[ws.grouped[end]].getGroupName() == group_name) {
+			end++;
 		}
-		// person was not matched to existing groups - let's create a new one
-		GroupPrimitive temp;
-		temp.id = person.getGroupName();
-		temp.track_names.push_back(person.getName());
-		groups_primitive.push_back(temp);
-	}
 
-	/*
-	 * Stage 3
-	 */
-	// collect constructor data for groups
-	struct GroupTemp {
-		// TODO: consider reference (most likely not feasible) or shared_ptr
-		std::vector<Person> people;
-		std::vector<std::string> tagnames;
-		std::vector<std::string> tags;
-	};
-	std::map<std::string, GroupTemp> people_grouped;
-	for (const auto& groupp: groups_primitive) {
-		for (const auto& person_std: people) {
-			auto it = std::find(groupp.track_names.begin(), groupp.track_names.end(), person_std.name);
-			if (it == groupp.track_names.end()) {
-				// given person was not found among group's tracked names
-				continue;
-			}
-			// find a 'utils' version of person
-			auto person_util_it = std::find_if(
-				people_total.cbegin(),
-				people_total.cend(),
-				[&](const Person& person) {
-					return person.getName() == person_std.name;
+		ConversionWorkspace::GroupRange range{ws.member_indices.size(), ws.member_indices.size()};
+		for (size_t j = begin; j < end; j++) {
+			const auto& name = people_total[ws.grouped[j]].getName();
+			auto it = std::find_if(
+				ws.member_indices.cbegin() + range.begin,
+				ws.member_indices.cend(),
+				[&](size_t index) {
+					return people_total[index].getName() == name;
 				}
 			);
-
-			// person found, make sure that wasn't added already
-			// firstly, the key
-			if (people_grouped.find(groupp.id) != people_grouped.cend()) {
-				// secondly, person by ID
-				auto it_group = std::find_if(
-					people_grouped[groupp.id].people.cbegin(),
-					people_grouped[groupp.id].people.cend(),
-					[&](const Person& person) {
-						return person.getName() == person_std.name;
-					}
-				);
-				if (it_group != people_grouped[groupp.id].people.cend()) {
-					// already there
-					continue;
-				}
-				// let's not update group data, just add the person
-				people_grouped[groupp.id].people.push_back(*person_util_it);
+			if (it != ws.member_indices.cend()) {
+				// already there
 				continue;
 			}
+			ws.member_indices.push_back(ws.grouped[j]);
+		}
+		range.end = ws.member_indices.size();
 
-			// all good, add
-			people_grouped[groupp.id].people.push_back(*person_util_it);
-			people_grouped[groupp.id].tagnames = person_std.tagnames;
-			people_grouped[groupp.id].tags = person_std.tags;
+		if (range.end - range.begin >= 2) {
+			ws.groups_valid.push_back(range);
+		} else {
+			ws.member_indices.erase(ws.member_indices.begin() + range.begin, ws.member_indices.end());
 		}
+		groups_collected++;
+		begin = end;
+	}
+
+	// names of tracked people for checking validity of group members
+	ws.names_tracked.clear();
+	for (const auto& person: people_total) {
+		ws.names_tracked.emplace_back(person.getName());
 	}
+	std::sort(ws.names_tracked.begin(), ws.names_tracked.end());
+	PEOPLE_MSGS_UTILS_RECORD_STOP(record_collect, groups_collected);
 
 	/*
 	 * Stage 4
 	 */
-	// create groups if they have multiple members assigned
-	std::vector<Group> groups_total;
-	for (const auto& group: people_grouped) {
-		if (group.second.people.size() < 2) {
-			continue;
-		}
-		groups_total.emplace_back(
-			group.first,
-			group.second.people,
-			group.second.tagnames,
-			group.second.tags
-		);
+	PEOPLE_MSGS_UTILS_RECORD_START(record_create, instrumentation::Stage::CREATE_GROUPS);
+	static const Group GROUP_PLACEHOLDER(
+		std::string(),
+		0,
+		std::vector<Person>(),
+		std::vector<std::string>(),
+		std::vector<std::tuple<std::string, std::string, double>>(),
+		geometry_msgs::Point()
+	);
+	resizeReusing(groups_total, ws.groups_valid.size(), GROUP_PLACEHOLDER);
+	if (ws.group_members.size() < ws.groups_valid.size()) {
+		ws.group_members.resize(ws.groups_valid.size());
 	}
 
 	/*
 	 * Stage 5
 	 *
-	 * It may happen that not all people are tracked with the selected data source but groups will still
-	 * have relations with extra IDs
+	 * Performed along with Stage 4, as both are independent per group. It may happen that not all people
+	 * are tracked with the selected data source but groups will still have relations with extra IDs.
 	 */
-	std::vector<Group> groups_total_cleaned;
-	for (const auto& group: groups_total) {
-		// keep only members tracked according to the @ref people_total container
-		auto member_ids = group.getMemberIDs();
-		std::vector<std::string> member_ids_valid;
-		for (const auto& member_id: member_ids) {
-			auto it = std::find_if(
-				people_total.cbegin(),
-				people_total.cend(),
-				[&](const Person& person) {
-					return person.getName() == member_id;
-				}
-			);
-			if (it == people_total.cend()) {
-				continue;
-			}
-			member_ids_valid.push_back(member_id);
-		}
-		// erase relations with inexisting member IDs
-		auto relations = group.getSocialRelations();
-		std::vector<std::tuple<std::string, std::string, double>> relations_valid;
-		for (const auto& rel: relations) {
-			auto member1_it = std::find(member_ids_valid.cbegin(), member_ids_valid.cend(), std::get<0>(rel));
-			auto member2_it = std::find(member_ids_valid.cbegin(), member_ids_valid.cend(), std::get<1>(rel));
-			if (member1_it != member_ids_valid.cend() && member2_it != member_ids_valid.cend()) {
-				relations_valid.emplace_back(*member1_it, *member2_it, std::get<2>(rel));
+	// fits into the small buffer of std::function, so does not allocate
+	std::function<bool(const std::string&)> is_tracked = [names = &ws.names_tracked](const std::string& id) {
+		return std::binary_search(names->cbegin(), names->cend(), std::string_view(id));
+	};
+	forEachIndex(
+		ws.groups_valid.size(),
+		[&](size_t k) {
+			const auto& range = ws.groups_valid[k];
+			auto& members = ws.group_members[k];
+			resizeReusing(members, range.end - range.begin, getPersonPlaceholder());
+			for (size_t j = range.begin; j < range.end; j++) {
+				members[j - range.begin] = people_total[ws.member_indices[j]];
 			}
-		}
-		// keep only valid members
-		auto members = group.getMembers();
-		People members_valid;
-		for (const auto& member: members) {
-			auto it = std::find(
-				member_ids_valid.cbegin(),
-				member_ids_valid.cend(),
-				member.getName()
+			// group data are taken from the first member
+			const auto& person_std = people[ws.member_indices[range.begin]];
+			const auto& group_name = people_total[ws.member_indices[range.begin]].getGroupName();
+			Group::Ellipse ellipse;
+			bool cached = cache != nullptr && cache->findEllipse(group_name, members, ellipse);
+			auto& group = groups_total[k];
+			group.assign(
+				group_name,
+				members,
+				person_std.tagnames,
+				person_std.tags,
+				cached ? &ellipse : nullptr
 			);
-			if (it == member_ids_valid.cend()) {
-				continue;
-			}
-			members_valid.push_back(member);
-		}
-		// recompute center of gravity as with changed members it may be outdated
-		geometry_msgs::Point cog_valid;
-		for (const auto& member: members_valid) {
-			cog_valid.x += member.getPositionX();
-			cog_valid.y += member.getPositionY();
-			cog_valid.z += member.getPositionZ();
-		}
-		cog_valid.x /= members_valid.size();
-		cog_valid.y /= members_valid.size();
-		cog_valid.z /= members_valid.size();
-		// create an instance with 'valid', i.e., recomputed/cleaned params
-		groups_total_cleaned.emplace_back(
-			group.getName(),
-			group.getAge(),
-			members_valid,
-			member_ids_valid,
-			relations_valid,
-			cog_valid
-		);
+			group.retainMembers(is_tracked);
+		},
+		parallel_for
+	);
+	if (cache != nullptr) {
+		cache->update(groups_total);
 	}
+	PEOPLE_MSGS_UTILS_RECORD_STOP(record_create, groups_total.size());
+}
+
+std::pair<std::vector<Person>, std::vector<Group>> createFromPeople(const std::vector<people_msgs::Person>& people) {
+	return createFromPeople(people, ParallelFor());
+}
+
+std::pair<std::vector<Person>, std::vector<Group>> createFromPeople(
+	const std::vector<people_msgs::Person>& people,
+	const ParallelFor& parallel_for
+) {
+	Frame frame;
+	createFromPeopleImpl(people, frame, parallel_for);
+	return std::make_pair(std::move(frame.people), std::move(frame.groups));
+}
+
+std::pair<std::vector<Person>, std::vector<Group>> createFromPeople(const std::vector<PersonView>& people) {
+	Frame frame;
+	createFromPeopleImpl(people, frame, ParallelFor());
+	return std::make_pair(std::move(frame.people), std::move(frame.groups));
+}
+
+/// Clears the header of a reused frame (keeps the memory of the frame ID)
+static void resetHeader(std_msgs::Header& header) {
+	header.seq = 0;
+	header.stamp = ros::Time();
+	header.frame_id.clear();
+}
+
+void createFromPeople(const std::vector<people_msgs::Person>& people, Frame& frame, const ParallelFor& parallel_for) {
+	resetHeader(frame.header);
+	createFromPeopleImpl(people, frame, parallel_for);
+}
 
-	return std::make_pair(people_total, groups_total_cleaned);
+void createFromPeople(const people_msgs::People& msg, Frame& frame, const ParallelFor& parallel_for) {
+	createFromPeopleImpl(msg.people, frame, parallel_for);
+	frame.header = msg.header;
+}
+
+void createFromPeople(
+	const people_msgs::People& msg,
+	Frame& frame,
+	GroupCache& cache,
+	const ParallelFor& parallel_for
+) {
+	createFromPeopleImpl(msg.people, frame, parallel_for, &cache);
+	frame.header = msg.header;
+}
+
+void createFromPeople(const std::vector<PersonView>& people, Frame& frame, const ParallelFor& parallel_for) {
+	resetHeader(frame.header);
+	createFromPeopleImpl(people, frame, parallel_for);
+}
+
+void createPeople(const std::vector<people_msgs::Person>& people, People& output, const ParallelFor& parallel_for) {
+	createPeopleImpl(people, output, parallel_for);
 }
 
 std::vector<Group> fillGroupsWithMembers(const std::vector<Group>& groups, const std::vector<Person>& people) {
@@ -222,47 +328,60 @@ std::vector<Group> fillGroupsWithMembers(const std::vector<Group>& groups, const
 	return groups_filled;
 }
 
-bool parseStringBool(const std::string& str) {
+bool parseStringBool(std::string_view str) {
 	if (str == "True" || str == "true" || str == "1") {
 		return true;
 	}
 	return false;
 }
 
-// Template full specialization
-template<>
-std::vector<std::string> parseString<std::string>(const std::string& str, const std::string& delimiter) {
-	std::vector<std::string> values;
-	std::string payload(str);
-
-	if (str.empty() || delimiter.empty()) {
-		return values;
+double parseStringDouble(std::string_view str) {
+	// strtod requires a null-terminated string; numeric tokens are short, so a stack buffer is enough in most cases
+	char buffer[64];
+	if (str.size() >= sizeof(buffer)) {
+		return std::stod(std::string(str));
 	}
+	std::memcpy(buffer, str.data(), str.size());
+	buffer[str.size()] = '\0';
 
-	// https://stackoverflow.com/a/14266139
-	size_t pos = 0;
-	std::string token;
-	while ((pos = payload.find(delimiter)) != std::string::npos) {
-		token = payload.substr(0, pos);
-
-		// check if token stores some valid chars and not whitespaces
-		if(token.find_first_not_of(' ') == std::string::npos) {
-			payload.erase(0, pos + delimiter.length());
-			continue;
-		}
+	char* end = nullptr;
+	double value = std::strtod(buffer, &end);
+	if (end == buffer) {
+		throw std::invalid_argument("parseStringDouble");
+	}
+	return value;
+}
 
-		// convert with the biggest possible precision, then convert to desired type
-		values.push_back(token);
-		payload.erase(0, pos + delimiter.length());
+unsigned long parseStringUnsigned(std::string_view str) {
+	char buffer[32];
+	if (str.size() >= sizeof(buffer)) {
+		return std::stoul(std::string(str));
 	}
+	std::memcpy(buffer, str.data(), str.size());
+	buffer[str.size()] = '\0';
 
-	bool token_with_whitespace_only = payload.find_first_not_of("\t\n ") == std::string::npos;
-	if (payload.empty() || token_with_whitespace_only) {
-		return values;
+	char* end = nullptr;
+	unsigned long value = std::strtoul(buffer, &end, 10);
+	if (end == buffer) {
+		throw std::invalid_argument("parseStringUnsigned");
 	}
+	return value;
+}
 
-	// token still stores some meaningful value
-	values.push_back(payload);
+// Template full specializations
+template<>
+std::vector<std::string_view> parseString<std::string_view>(std::string_view str, std::string_view delimiter) {
+	std::vector<std::string_view> values;
+	forEachToken(str, delimiter, [&values](std::string_view token) {
+		values.push_back(token);
+	});
+	return values;
+}
+
+template<>
+std::vector<std::string> parseString<std::string>(std::string_view str, std::string_view delimiter) {
+	auto views = parseString<std::string_view>(str, delimiter);
+	return std::vector<std::string>(views.cbegin(), views.cend());
 }
 
 } // namespace people_msgs_utils
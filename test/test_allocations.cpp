@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/serialization.h>
+#include <people_msgs_utils/track_history.h>
+#include <people_msgs_utils/utils.h>
+
+#include <ros/serialization.h>
+#include <social_nav_utils/ellipse_fitting.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Counting hook of the global allocation functions (counts only while enabled)
+static std::atomic<bool> counting(false);
+static std::atomic<size_t> allocations(0);
+
+// the replaced operators are backed by malloc and free, which GCC would report as mismatched under -Wall
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size) {
+	if (counting.load(std::memory_order_relaxed)) {
+		allocations.fetch_add(1, std::memory_order_relaxed);
+	}
+	void* ptr = std::malloc(size == 0 ? 1 : size);
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+/// Returns the number of allocations made by @ref fun
+template <typename Fun>
+size_t countAllocations(Fun fun) {
+	allocations.store(0);
+	counting.store(true);
+	fun();
+	counting.store(false);
+	return allocations.load();
+}
+
+using namespace people_msgs_utils;
+
+/**
+ * @brief Returns the number of allocations made by the ellipse fitting (of an external library) of the groups
+ *
+ * The library makes no allocations of its own in the steady state, so these are the only ones expected
+ */
+size_t countFittingAllocations(const Groups& groups);
+
+// Test cases
+TEST(AllocationTest, steadyStatePeople) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 200;
+	params.group_ratio = 0.0;
+	auto people = CrowdGenerator(params).generate();
+
+	Frame frame;
+	// warm up buffers of the frame and of the thread's workspace
+	createFromPeople(people, frame);
+	EXPECT_EQ(countAllocations([&]() { createFromPeople(people, frame); }), 0);
+	ASSERT_EQ(frame.people.size(), people.size());
+
+	geometry_msgs::TransformStamped transform;
+	transform.header.frame_id = "map";
+	transform.child_frame_id = "odom";
+	transform.transform.translation.x = 1.0;
+	transform.transform.rotation.w = 1.0;
+	EXPECT_EQ(countAllocations([&]() { frame.people.front().transform(transform); }), 0);
+
+	// serialized input decoded into a reused view
+	people_msgs::People msg;
+	msg.people = people;
+	ros::SerializedMessage serialized = ros::serialization::serializeMessage(msg);
+	size_t prefix_length = static_cast<size_t>(serialized.message_start - serialized.buf.get());
+	size_t length = serialized.num_bytes - prefix_length;
+
+	PeopleView view;
+	ASSERT_TRUE(decodePeople(serialized.message_start, length, view));
+	createFromPeople(view.people, frame);
+	EXPECT_EQ(
+		countAllocations([&]() {
+			decodePeople(serialized.message_start, length, view);
+			createFromPeople(view.people, frame);
+		}),
+		0
+	);
+}
+
+TEST(AllocationTest, steadyStateGroups) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 200;
+	params.group_ratio = 0.6;
+	auto people = CrowdGenerator(params).generate();
+
+	Frame frame;
+	createFromPeople(people, frame);
+	ASSERT_FALSE(frame.groups.empty());
+
+	// ellipse fitting of an external library may allocate on its own, anything else is an allocation of the library
+	createFromPeople(people, frame);
+	EXPECT_EQ(countAllocations([&]() { createFromPeople(people, frame); }), countFittingAllocations(frame.groups));
+
+	// results are the same as the ones of the allocating version
+	auto ref = createFromPeople(people);
+	ASSERT_EQ(frame.groups.size(), ref.second.size());
+	for (size_t i = 0; i < ref.second.size(); i++) {
+		EXPECT_EQ(frame.groups.at(i).getName(), ref.second.at(i).getName());
+		EXPECT_EQ(frame.groups.at(i).getMemberIDs(), ref.second.at(i).getMemberIDs());
+		EXPECT_DOUBLE_EQ(frame.groups.at(i).getSpanX(), ref.second.at(i).getSpanX());
+	}
+
+	geometry_msgs::TransformStamped transform;
+	transform.header.frame_id = "map";
+	transform.child_frame_id = "odom";
+	transform.transform.rotation.w = 1.0;
+	auto& group = frame.groups.front();
+	group.transform(transform);
+	EXPECT_EQ(countAllocations([&]() { group.transform(transform); }), countFittingAllocations(Groups{group}));
+}
+
+TEST(AllocationTest, steadyStateTrackHistory) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 100;
+	params.group_ratio = 0.0;
+	People people;
+	std::tie(people, std::ignore) = createFromPeople(CrowdGenerator(params).generate());
+	// the same people under different track IDs
+	People renamed;
+	for (const auto& person: people) {
+		renamed.emplace_back(
+			person.getName() + "_renamed_to_exceed_small_string_buffers",
+			geometry_msgs::PoseWithCovariance(),
+			geometry_msgs::PoseWithCovariance(),
+			1.0,
+			false,
+			true,
+			1,
+			1,
+			""
+		);
+	}
+
+	TrackHistory::Parameters history_params;
+	history_params.max_tracks = people.size();
+	TrackHistory history(history_params);
+	history.update(renamed, 0.0);
+	history.update(people, 1.0);
+	EXPECT_EQ(countAllocations([&]() { history.update(people, 2.0); }), 0);
+	// new tracks replace the old ones and reuse their memory
+	EXPECT_EQ(countAllocations([&]() { history.update(renamed, 3.0); }), 0);
+	EXPECT_EQ(history.size(), people.size());
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+size_t countFittingAllocations(const Groups& groups) {
+	size_t count = 0;
+	std::vector<double> x;
+	std::vector<double> y;
+	for (const auto& group: groups) {
+		x.clear();
+		y.clear();
+		for (const auto& member: group.getMembers()) {
+			x.push_back(member.getPositionX());
+			y.push_back(member.getPositionY());
+		}
+		count += countAllocations([&]() { social_nav_utils::EllipseFitting fitting(x, y); });
+	}
+	return count;
+}
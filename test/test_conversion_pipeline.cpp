@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/conversion_pipeline.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace people_msgs_utils;
+
+std::shared_ptr<const people_msgs::People> createMessage(unsigned int num_people, const std::string& name);
+
+// Test cases
+TEST(ConversionPipelineTest, convertsAllWhenBlocking) {
+	const unsigned int MESSAGES = 50;
+	ConversionPipeline pipeline(2, ConversionPipeline::OverflowPolicy::BLOCK);
+
+	std::atomic<unsigned int> callbacks(0);
+	pipeline.setCallback([&](const std::shared_ptr<const Frame>&) { callbacks++; });
+
+	std::thread producer([&]() {
+		for (unsigned int i = 0; i < MESSAGES; i++) {
+			EXPECT_TRUE(pipeline.push(createMessage(1 + i % 5, std::to_string(i))));
+		}
+	});
+	producer.join();
+	ASSERT_TRUE(pipeline.waitUntilIdle(std::chrono::milliseconds(5000)));
+
+	auto stats = pipeline.getStatistics();
+	EXPECT_EQ(stats.pushed, MESSAGES);
+	EXPECT_EQ(stats.converted, MESSAGES);
+	EXPECT_EQ(stats.dropped, 0);
+	EXPECT_EQ(callbacks.load(), MESSAGES);
+	EXPECT_LE(stats.latency_min, stats.latency_mean);
+	EXPECT_LE(stats.latency_mean, stats.latency_max);
+
+	auto frame = pipeline.getLatest();
+	ASSERT_EQ(frame->people.size(), 1 + (MESSAGES - 1) % 5);
+	EXPECT_EQ(frame->people.front().getName(), std::to_string(MESSAGES - 1));
+}
+
+TEST(ConversionPipelineTest, dropsSupersededFrames) {
+	const unsigned int MESSAGES = 200;
+	ConversionPipeline pipeline(1, ConversionPipeline::OverflowPolicy::DROP_OLDEST);
+
+	for (unsigned int i = 0; i < MESSAGES; i++) {
+		pipeline.push(createMessage(20, std::to_string(i)));
+	}
+	ASSERT_TRUE(pipeline.waitUntilIdle(std::chrono::milliseconds(5000)));
+
+	auto stats = pipeline.getStatistics();
+	EXPECT_EQ(stats.pushed, MESSAGES);
+	EXPECT_EQ(stats.converted + stats.dropped, MESSAGES);
+	// the latest message is never dropped with this policy
+	EXPECT_EQ(pipeline.getLatest()->people.front().getName(), std::to_string(MESSAGES - 1));
+}
+
+TEST(ConversionPipelineTest, dropsNewFrames) {
+	ConversionPipeline pipeline(1, ConversionPipeline::OverflowPolicy::DROP_NEWEST);
+	for (unsigned int i = 0; i < 100; i++) {
+		pipeline.push(createMessage(20, std::to_string(i)));
+	}
+	ASSERT_TRUE(pipeline.waitUntilIdle(std::chrono::milliseconds(5000)));
+
+	auto stats = pipeline.getStatistics();
+	EXPECT_EQ(stats.converted + stats.dropped, 100);
+	// the first message is never dropped with this policy
+	EXPECT_GE(stats.converted, 1);
+}
+
+TEST(ConversionPipelineTest, survivesMalformedTags) {
+	ConversionPipeline pipeline(4, ConversionPipeline::OverflowPolicy::BLOCK);
+
+	auto msg = std::make_shared<people_msgs::People>();
+	people_msgs::Person person;
+	person.name = "0";
+	person.tagnames = {"track_age"};
+	person.tags = {"not a number"};
+	msg->people.push_back(person);
+
+	pipeline.push(msg);
+	pipeline.push(createMessage(3, "valid"));
+	ASSERT_TRUE(pipeline.waitUntilIdle(std::chrono::milliseconds(5000)));
+
+	auto stats = pipeline.getStatistics();
+	EXPECT_EQ(stats.failed, 1);
+	EXPECT_EQ(stats.converted, 1);
+	EXPECT_EQ(pipeline.getLatest()->people.size(), 3);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+std::shared_ptr<const people_msgs::People> createMessage(unsigned int num_people, const std::string& name) {
+	auto msg = std::make_shared<people_msgs::People>();
+	for (unsigned int i = 0; i < num_people; i++) {
+		people_msgs::Person person;
+		person.name = name;
+		person.position.x = static_cast<double>(i);
+		person.velocity.x = 0.5;
+		person.reliability = 0.9;
+		person.tagnames = {"track_age", "group_id"};
+		person.tags = {std::to_string(i), std::to_string(i % 2)};
+		msg->people.push_back(person);
+	}
+	return msg;
+}
@@ -402,6 +402,35 @@ TEST(ExtractionTest, fillGroupsWithMembers) {
 	}
 }
 
+TEST(ExtractionTest, parallelSameAsSequential) {
+	std::vector<people_msgs::Person> people_std = createSet2();
+
+	std::vector<Person> people_seq;
+	std::vector<Group> groups_seq;
+	std::tie(people_seq, groups_seq) = createFromPeople(people_std);
+
+	for (unsigned int threads: {1, 2, 3, 16}) {
+		std::vector<Person> people;
+		std::vector<Group> groups;
+		std::tie(people, groups) = createFromPeople(people_std, createThreadParallelFor(threads));
+
+		// order must be preserved
+		ASSERT_EQ(people.size(), people_seq.size());
+		for (size_t i = 0; i < people.size(); i++) {
+			EXPECT_EQ(people.at(i).getName(), people_seq.at(i).getName());
+			EXPECT_EQ(people.at(i).getGroupName(), people_seq.at(i).getGroupName());
+			EXPECT_EQ(people.at(i).getDetectionID(), people_seq.at(i).getDetectionID());
+		}
+		ASSERT_EQ(groups.size(), groups_seq.size());
+		for (size_t i = 0; i < groups.size(); i++) {
+			EXPECT_EQ(groups.at(i).getName(), groups_seq.at(i).getName());
+			EXPECT_EQ(groups.at(i).getMemberIDs(), groups_seq.at(i).getMemberIDs());
+			EXPECT_EQ(groups.at(i).getSocialRelations(), groups_seq.at(i).getSocialRelations());
+			EXPECT_DOUBLE_EQ(groups.at(i).getCenterOfGravity().x, groups_seq.at(i).getCenterOfGravity().x);
+		}
+	}
+}
+
 int main(int argc, char** argv) {
 	testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/utils.h>
+
+using namespace people_msgs_utils;
+
+// Test cases
+TEST(CrowdGeneratorTest, deterministic) {
+	CrowdGenerator::Parameters params;
+	params.seed = 123;
+	params.num_people = 50;
+	params.malformed_tag_ratio = 0.2;
+
+	CrowdGenerator generator1(params);
+	CrowdGenerator generator2(params);
+	for (unsigned int frame = 0; frame < 5; frame++) {
+		auto people1 = generator1.generate();
+		auto people2 = generator2.generate();
+		ASSERT_EQ(people1.size(), people2.size());
+		for (size_t i = 0; i < people1.size(); i++) {
+			EXPECT_EQ(people1.at(i).name, people2.at(i).name);
+			EXPECT_EQ(people1.at(i).position.x, people2.at(i).position.x);
+			EXPECT_EQ(people1.at(i).tags, people2.at(i).tags);
+		}
+		generator1.step();
+		generator2.step();
+	}
+
+	// fresh generators with the same seed produce the same crowd
+	params.seed = 321;
+	auto people_a = CrowdGenerator(params).generate();
+	auto people_b = CrowdGenerator(params).generate();
+	ASSERT_EQ(people_a.size(), people_b.size());
+	for (size_t i = 0; i < people_a.size(); i++) {
+		EXPECT_EQ(people_a.at(i).name, people_b.at(i).name);
+		EXPECT_EQ(people_a.at(i).position.x, people_b.at(i).position.x);
+		EXPECT_EQ(people_a.at(i).position.y, people_b.at(i).position.y);
+		EXPECT_EQ(people_a.at(i).velocity.x, people_b.at(i).velocity.x);
+		EXPECT_EQ(people_a.at(i).reliability, people_b.at(i).reliability);
+		EXPECT_EQ(people_a.at(i).tagnames, people_b.at(i).tagnames);
+		EXPECT_EQ(people_a.at(i).tags, people_b.at(i).tags);
+	}
+
+	// other seed, other crowd
+	params.seed = 123;
+	auto people_c = CrowdGenerator(params).generate();
+	ASSERT_EQ(people_c.size(), people_a.size());
+	size_t num_different = 0;
+	for (size_t i = 0; i < people_a.size(); i++) {
+		if (people_a.at(i).position.x != people_c.at(i).position.x
+			|| people_a.at(i).position.y != people_c.at(i).position.y
+		) {
+			num_different++;
+		}
+	}
+	EXPECT_EQ(num_different, people_a.size());
+}
+
+TEST(CrowdGeneratorTest, parsedGroups) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 100;
+	params.group_ratio = 0.6;
+	params.group_size_min = 3;
+	params.group_size_max = 3;
+	params.relation_density = 1.0;
+	params.occlusion_ratio = 0.0;
+
+	CrowdGenerator generator(params);
+	std::vector<Person> people;
+	std::vector<Group> groups;
+	std::tie(people, groups) = createFromPeople(generator.generate());
+
+	ASSERT_EQ(people.size(), 100);
+	ASSERT_EQ(groups.size(), 20);
+	for (const auto& group: groups) {
+		EXPECT_EQ(group.getMemberIDs().size(), 3);
+		EXPECT_EQ(group.getMembers().size(), 3);
+		// all pairs are related
+		EXPECT_EQ(group.getSocialRelations().size(), 3);
+		EXPECT_GT(group.getSpanX(), 0.0);
+	}
+	for (const auto& person: people) {
+		EXPECT_FALSE(person.isOccluded());
+		EXPECT_TRUE(person.isMatched());
+		EXPECT_GT(person.getCovariancePoseXX(), 0.0);
+		EXPECT_NEAR(person.getOrientationYaw(), std::atan2(person.getVelocityY(), person.getVelocityX()), 1e-03);
+	}
+}
+
+TEST(CrowdGeneratorTest, motion) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 20;
+	params.dt = 0.5;
+
+	CrowdGenerator generator(params);
+	auto frame1 = generator.generate();
+	generator.step();
+	auto frame2 = generator.generate();
+	ASSERT_EQ(frame1.size(), frame2.size());
+
+	for (size_t i = 0; i < frame1.size(); i++) {
+		double dist = std::hypot(
+			frame2.at(i).position.x - frame1.at(i).position.x,
+			frame2.at(i).position.y - frame1.at(i).position.y
+		);
+		EXPECT_LE(dist, params.speed_max * params.dt + 1e-06);
+		// members of groups may stick out of the area by the radius of the group
+		EXPECT_LE(std::abs(frame2.at(i).position.x), params.area_size / 2.0 + 1.5);
+	}
+}
+
+TEST(CrowdGeneratorTest, malformedTags) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 200;
+	params.malformed_tag_ratio = 1.0;
+
+	CrowdGenerator generator(params);
+	unsigned int errors = 0;
+	for (const auto& person_std: generator.generate()) {
+		try {
+			Person person(person_std);
+		} catch (const std::exception&) {
+			errors++;
+		}
+	}
+	// some of corruptions (mismatched sizes, malformed non-numeric tags) are silently ignored by the parser
+	EXPECT_GT(errors, 0);
+	EXPECT_LT(errors, 200);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
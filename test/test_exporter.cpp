@@ -0,0 +1,298 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/exporter.h>
+#include <people_msgs_utils/utils.h>
+
+#include <ros/serialization.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace people_msgs_utils;
+
+/// Returns a path of a file unique to the test process
+std::string createExportPath(const std::string& suffix);
+
+/// Reads the whole file
+std::string readFile(const std::string& path);
+
+/// Splits a CSV line without quoted fields
+std::vector<std::string> splitLine(const std::string& line);
+
+/// Reads a little-endian value at @ref position
+template <typename T>
+T readValue(const std::string& data, size_t position);
+
+/// Returns the position of the field @ref id of the FlatBuffers table at @ref table, 0 if it is not present
+size_t findField(const std::string& data, size_t table, uint16_t id);
+
+/// Returns the target of the FlatBuffers offset at @ref position
+size_t followOffset(const std::string& data, size_t position);
+
+// Test cases
+TEST(ExporterTest, csv) {
+	CrowdGenerator::Parameters crowd_params;
+	crowd_params.num_people = 30;
+	crowd_params.group_ratio = 0.5;
+	Frame frame;
+	createFromPeople(CrowdGenerator(crowd_params).generate(), frame);
+	frame.header.stamp = ros::Time(5, 250000000);
+	ASSERT_FALSE(frame.groups.empty());
+
+	auto path = createExportPath("csv");
+	FrameExporter::Parameters params;
+	params.row_group_size = 7;
+	{
+		FrameExporter exporter(path, params);
+		exporter.append(frame);
+		exporter.append(frame);
+		EXPECT_EQ(exporter.getRowCount(), 60);
+		// row groups are flushed as they fill up
+		EXPECT_EQ(exporter.getRowGroupCount(), 8);
+	}
+
+	std::istringstream lines(readFile(path));
+	std::string line;
+	std::getline(lines, line);
+	EXPECT_EQ(
+		line,
+		"stamp,id,x,y,vx,vy,cov_xx,cov_yy,cov_yawyaw,reliability,group,relation,relation_strength"
+	);
+	size_t num_lines = 0;
+	while (std::getline(lines, line)) {
+		const auto& person = frame.people[num_lines % frame.people.size()];
+		auto fields = splitLine(line);
+		ASSERT_EQ(fields.size(), 13);
+		EXPECT_EQ(fields[0], "5.250000000");
+		EXPECT_EQ(fields[1], person.getName());
+		EXPECT_NEAR(std::stod(fields[2]), person.getPositionX(), 1e-6);
+		EXPECT_NEAR(std::stod(fields[5]), person.getVelocityY(), 1e-6);
+		EXPECT_EQ(fields[10], person.getGroupName());
+		if (person.getGroupName().empty()) {
+			EXPECT_TRUE(fields[11].empty());
+			EXPECT_TRUE(fields[12].empty());
+		} else {
+			// the strongest relation within the group
+			auto relations = frame.groups.front().getSocialRelations(person.getName());
+			for (const auto& group: frame.groups) {
+				if (group.getName() == person.getGroupName()) {
+					relations = group.getSocialRelations(person.getName());
+				}
+			}
+			ASSERT_FALSE(relations.empty());
+			double strongest = 0.0;
+			for (const auto& relation: relations) {
+				strongest = std::max(strongest, relation.second);
+			}
+			EXPECT_NEAR(std::stod(fields[12]), strongest, 1e-6);
+		}
+		num_lines++;
+	}
+	EXPECT_EQ(num_lines, 60);
+	unlink(path.c_str());
+}
+
+TEST(ExporterTest, csvQuoting) {
+	Frame frame;
+	createFromPeople(CrowdGenerator(CrowdGenerator::Parameters()).generate(), frame);
+	frame.people.erase(frame.people.begin() + 1, frame.people.end());
+	frame.groups.clear();
+	frame.people.front().setName("a,\"b\"");
+	frame.people.front().setGroupName("");
+
+	auto path = createExportPath("quoting");
+	FrameExporter exporter(path);
+	exporter.append(frame);
+	exporter.close();
+	exporter.close();
+	auto contents = readFile(path);
+	EXPECT_NE(contents.find(",\"a,\"\"b\"\"\","), std::string::npos);
+	unlink(path.c_str());
+}
+
+TEST(ExporterTest, arrowStream) {
+	CrowdGenerator::Parameters crowd_params;
+	crowd_params.num_people = 50;
+	crowd_params.group_ratio = 0.5;
+	people_msgs::People msg;
+	msg.header.stamp = ros::Time(3.0);
+	msg.people = CrowdGenerator(crowd_params).generate();
+	Frame frame;
+	createFromPeople(msg.people, frame);
+	ros::SerializedMessage serialized = ros::serialization::serializeMessage(msg);
+	size_t prefix_length = static_cast<size_t>(serialized.message_start - serialized.buf.get());
+
+	auto path = createExportPath("arrow");
+	FrameExporter::Parameters params;
+	params.format = FrameExporter::Format::ARROW;
+	params.row_group_size = 64;
+	{
+		FrameExporter exporter(path, params);
+		for (size_t i = 0; i < 3; i++) {
+			ASSERT_TRUE(exporter.append(serialized.message_start, serialized.num_bytes - prefix_length));
+		}
+		EXPECT_FALSE(exporter.append(serialized.message_start, 10));
+		EXPECT_EQ(exporter.getRowCount(), 150);
+	}
+
+	// people with relations, the others have null relations and strengths
+	std::vector<bool> has_relation;
+	for (const auto& person: frame.people) {
+		bool found = false;
+		for (const auto& group: frame.groups) {
+			found |= !group.getSocialRelations(person.getName()).empty();
+		}
+		has_relation.push_back(found);
+	}
+	ASSERT_NE(std::count(has_relation.cbegin(), has_relation.cend(), true), 0);
+	ASSERT_NE(std::count(has_relation.cbegin(), has_relation.cend(), false), 0);
+
+	// framing of the stream: schema, record batches of 64, 64 and 22 rows, end of stream
+	const int64_t BATCH_ROWS[] = {64, 64, 22};
+	// buffers of columns: validity and values, offsets and characters of strings
+	const size_t X_NODE = 2;
+	const size_t X_BUFFER = 5;
+	const size_t GROUP_NODE = 10;
+	const size_t RELATION_NODE = 11;
+	const size_t RELATION_STRENGTH_NODE = 12;
+	const size_t RELATION_STRENGTH_BUFFER = 27;
+	auto contents = readFile(path);
+	size_t offset = 0;
+	size_t num_messages = 0;
+	size_t num_rows = 0;
+	while (true) {
+		ASSERT_LE(offset + 8, contents.size());
+		uint32_t prefix[2];
+		std::memcpy(prefix, contents.data() + offset, sizeof(prefix));
+		EXPECT_EQ(prefix[0], 0xFFFFFFFF);
+		offset += sizeof(prefix);
+		if (prefix[1] == 0) {
+			break;
+		}
+		EXPECT_EQ(prefix[1] % 8, 0);
+		// the body length is the last field of the message table
+		size_t metadata = offset;
+		offset += prefix[1];
+		if (num_messages > 0) {
+			uint32_t root;
+			std::memcpy(&root, contents.data() + metadata, sizeof(root));
+			int64_t body_length;
+			std::memcpy(&body_length, contents.data() + metadata + root + 16, sizeof(body_length));
+			EXPECT_EQ(body_length % 8, 0);
+			size_t body = offset;
+			offset += body_length;
+			ASSERT_LE(offset, contents.size());
+
+			// record batch: length, nodes (length, null count) and buffers (offset, length) of columns
+			size_t batch = followOffset(contents, findField(contents, metadata + root, 2));
+			EXPECT_EQ(readValue<int64_t>(contents, findField(contents, batch, 0)), BATCH_ROWS[num_messages - 1]);
+			size_t nodes = followOffset(contents, findField(contents, batch, 1));
+			size_t buffers = followOffset(contents, findField(contents, batch, 2));
+			ASSERT_EQ(readValue<uint32_t>(contents, nodes), 13);
+			auto get_node = [&](size_t index, size_t field) {
+				return readValue<int64_t>(contents, nodes + 4 + 16 * index + 8 * field);
+			};
+			auto get_buffer = [&](size_t index, size_t field) {
+				return static_cast<size_t>(readValue<int64_t>(contents, buffers + 4 + 16 * index + 8 * field));
+			};
+			int64_t rows = BATCH_ROWS[num_messages - 1];
+			EXPECT_EQ(get_node(0, 0), rows);
+
+			// values of the first row of the batch
+			const auto& first = frame.people[num_rows % frame.people.size()];
+			EXPECT_EQ(get_buffer(X_BUFFER + 1, 1), rows * sizeof(double));
+			EXPECT_EQ(readValue<double>(contents, body + get_buffer(X_BUFFER + 1, 0)), first.getPositionX());
+
+			// people without a group have null groups
+			int64_t group_nulls = 0;
+			for (int64_t row = 0; row < rows; row++) {
+				group_nulls += frame.people[(num_rows + row) % frame.people.size()].getGroupName().empty();
+			}
+			EXPECT_GT(group_nulls, 0);
+			EXPECT_EQ(get_node(GROUP_NODE, 1), group_nulls);
+
+			// missing relations are null, with the validity bitmap consistent with the null counts
+			int64_t nulls = 0;
+			size_t validity = body + get_buffer(RELATION_STRENGTH_BUFFER, 0);
+			ASSERT_EQ(get_buffer(RELATION_STRENGTH_BUFFER, 1), (rows + 7) / 8);
+			for (int64_t row = 0; row < rows; row++) {
+				bool valid = (readValue<uint8_t>(contents, validity + row / 8) >> (row % 8)) & 1;
+				EXPECT_EQ(valid, has_relation[(num_rows + row) % frame.people.size()]) << row;
+				nulls += !valid;
+				if (valid) {
+					size_t values = body + get_buffer(RELATION_STRENGTH_BUFFER + 1, 0);
+					EXPECT_GT(readValue<double>(contents, values + sizeof(double) * row), 0.0);
+				}
+			}
+			EXPECT_GT(nulls, 0);
+			EXPECT_EQ(get_node(RELATION_STRENGTH_NODE, 1), nulls);
+			EXPECT_EQ(get_node(RELATION_NODE, 1), nulls);
+			// no other nulls, so no other bitmaps
+			EXPECT_EQ(get_node(X_NODE, 1), 0);
+			EXPECT_EQ(get_buffer(X_BUFFER, 1), 0);
+			num_rows += rows;
+		}
+		num_messages++;
+	}
+	EXPECT_EQ(num_messages, 4);
+	EXPECT_EQ(num_rows, 150);
+	EXPECT_EQ(offset, contents.size());
+	unlink(path.c_str());
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+std::string createExportPath(const std::string& suffix) {
+	return testing::TempDir() + "people_msgs_utils_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+std::string readFile(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	std::ostringstream contents;
+	contents << file.rdbuf();
+	return contents.str();
+}
+
+std::vector<std::string> splitLine(const std::string& line) {
+	std::vector<std::string> fields;
+	std::istringstream stream(line);
+	std::string field;
+	while (std::getline(stream, field, ',')) {
+		fields.push_back(field);
+	}
+	// trailing empty field
+	if (!line.empty() && line.back() == ',') {
+		fields.emplace_back();
+	}
+	return fields;
+}
+
+template <typename T>
+T readValue(const std::string& data, size_t position) {
+	T value;
+	std::memcpy(&value, data.data() + position, sizeof(T));
+	return value;
+}
+
+size_t findField(const std::string& data, size_t table, uint16_t id) {
+	size_t vtable = table - readValue<int32_t>(data, table);
+	size_t slot = 2 * sizeof(uint16_t) + id * sizeof(uint16_t);
+	if (slot >= readValue<uint16_t>(data, vtable)) {
+		return 0;
+	}
+	uint16_t field = readValue<uint16_t>(data, vtable + slot);
+	return field == 0 ? 0 : table + field;
+}
+
+size_t followOffset(const std::string& data, size_t position) {
+	return position + readValue<uint32_t>(data, position);
+}
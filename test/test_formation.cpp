@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/formation.h>
+#include <people_msgs_utils/utils.h>
+
+#include <cmath>
+#include <map>
+#include <set>
+
+using namespace people_msgs_utils;
+
+/// Creates a person at the given position, looking in the direction of @ref yaw and moving with the given velocity
+Person createPerson(const std::string& name, double x, double y, double yaw, double vx = 0.0, double vy = 0.0);
+
+// Test cases
+TEST(FFormationTest, relationStrength) {
+	FFormationDetector detector;
+	// vis-a-vis
+	EXPECT_NEAR(
+		detector.computeRelationStrength(createPerson("a", 0.0, 0.0, 0.0), createPerson("b", 1.2, 0.0, M_PI)),
+		1.0,
+		1e-9
+	);
+	// L-arrangement
+	EXPECT_NEAR(
+		detector.computeRelationStrength(createPerson("a", 0.0, 0.0, 0.0), createPerson("b", 0.6, 0.6, -M_PI_2)),
+		1.0,
+		1e-9
+	);
+	// back to back
+	EXPECT_LT(
+		detector.computeRelationStrength(createPerson("a", 0.0, 0.0, M_PI), createPerson("b", 1.2, 0.0, 0.0)),
+		1e-3
+	);
+	// walking side by side
+	EXPECT_NEAR(
+		detector.computeRelationStrength(
+			createPerson("a", 0.0, 0.0, 0.0, 1.0, 0.0),
+			createPerson("b", 0.0, 0.8, 0.0, 1.0, 0.0)
+		),
+		1.0,
+		1e-9
+	);
+	// walking in opposite directions
+	EXPECT_EQ(
+		detector.computeRelationStrength(
+			createPerson("a", 0.0, 0.0, 0.0, 1.0, 0.0),
+			createPerson("b", 0.0, 0.8, M_PI, -1.0, 0.0)
+		),
+		0.0
+	);
+	// one walks past the other
+	EXPECT_EQ(
+		detector.computeRelationStrength(
+			createPerson("a", 0.0, 0.0, 0.0, 1.0, 0.0),
+			createPerson("b", 0.0, 0.8, -M_PI_2)
+		),
+		0.0
+	);
+	// too far apart
+	EXPECT_EQ(
+		detector.computeRelationStrength(createPerson("a", 0.0, 0.0, 0.0), createPerson("b", 2.5, 0.0, M_PI)),
+		0.0
+	);
+}
+
+TEST(FFormationTest, detect) {
+	auto loner = createPerson("f", 20.0, 0.0, 0.0);
+	loner.setGroupName("old");
+	People people{
+		createPerson("a", 0.0, 0.0, 0.0),
+		createPerson("b", 1.2, 0.0, M_PI),
+		createPerson("c", 0.6, 0.6, -M_PI_2),
+		createPerson("d", 10.0, 0.0, 0.0, 1.0, 0.0),
+		createPerson("e", 10.0, 0.8, 0.0, 1.1, 0.0),
+		loner,
+		// passes by the standing group
+		createPerson("g", 0.6, -1.0, 0.0, 1.0, 0.0)
+	};
+
+	FFormationDetector detector;
+	Groups groups;
+	detector.detect(people, groups);
+	ASSERT_EQ(groups.size(), 2);
+	EXPECT_EQ(groups[0].getName(), "a");
+	EXPECT_EQ(groups[0].getMemberIDs(), (std::vector<std::string>{"a", "b", "c"}));
+	EXPECT_EQ(groups[1].getName(), "d");
+	EXPECT_EQ(groups[1].getMemberIDs(), (std::vector<std::string>{"d", "e"}));
+	// existing assignments are ignored
+	EXPECT_FALSE(people[5].isAssignedToGroup());
+	EXPECT_FALSE(people[6].isAssignedToGroup());
+	EXPECT_EQ(people[2].getGroupName(), "a");
+
+	// spatial model and synthetic relations
+	EXPECT_NEAR(groups[0].getPositionX(), 0.6, 0.2);
+	EXPECT_GT(groups[0].getSpanX(), 0.0);
+	EXPECT_EQ(groups[0].getSocialRelations().size(), 3);
+	for (const auto& relation: groups[0].getSocialRelations()) {
+		EXPECT_GE(std::get<2>(relation), detector.getParameters().threshold);
+	}
+	ASSERT_EQ(groups[1].getSocialRelations().size(), 1);
+	EXPECT_GT(std::get<2>(groups[1].getSocialRelations().front()), 0.9);
+
+	// reused outputs
+	people.erase(people.begin() + 2, people.end());
+	detector.detect(people, groups);
+	ASSERT_EQ(groups.size(), 1);
+	EXPECT_EQ(groups[0].getMemberIDs(), (std::vector<std::string>{"a", "b"}));
+	people.clear();
+	detector.detect(people, groups);
+	EXPECT_TRUE(groups.empty());
+}
+
+TEST(FFormationTest, crowd) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 1000;
+	params.group_ratio = 0.5;
+	auto frame = createFromPeople(CrowdGenerator(params).generate());
+	auto& people = frame.first;
+	const auto& groups_generated = frame.second;
+
+	// members of generated pairs and triplets may stand up to 2.4 m apart
+	FFormationDetector::Parameters detector_params;
+	detector_params.max_distance = 2.5;
+	FFormationDetector detector(detector_params);
+	Groups groups;
+	detector.detect(people, groups);
+	ASSERT_FALSE(groups.empty());
+
+	std::map<std::string, std::string> detected;
+	for (const auto& person: people) {
+		detected[person.getName()] = person.getGroupName();
+	}
+	// members of the generated groups share velocities; the moving ones must be detected as a whole
+	size_t moving = 0;
+	for (const auto& group: groups_generated) {
+		const auto& member = group.getMembers().front();
+		if (std::hypot(member.getVelocityX(), member.getVelocityY()) <= detector.getParameters().standing_speed) {
+			continue;
+		}
+		moving++;
+		std::set<std::string> names;
+		for (const auto& id: group.getMemberIDs()) {
+			names.insert(detected[id]);
+		}
+		EXPECT_EQ(names.size(), 1);
+		EXPECT_FALSE(names.begin()->empty());
+	}
+	EXPECT_GT(moving, 0);
+	EXPECT_GE(groups.size(), moving);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+Person createPerson(const std::string& name, double x, double y, double yaw, double vx, double vy) {
+	geometry_msgs::PoseWithCovariance pose;
+	pose.pose.position.x = x;
+	pose.pose.position.y = y;
+	pose.pose.orientation.z = std::sin(yaw / 2.0);
+	pose.pose.orientation.w = std::cos(yaw / 2.0);
+	geometry_msgs::PoseWithCovariance vel;
+	vel.pose.position.x = vx;
+	vel.pose.position.y = vy;
+	return Person(name, pose, vel, 1.0, false, true, 1, 1, "");
+}
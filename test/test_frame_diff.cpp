@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/frame_diff.h>
+#include <people_msgs_utils/utils.h>
+
+#include <algorithm>
+
+using namespace people_msgs_utils;
+
+/// Creates a person at the given position, assigned to the group with @ref group_name (if not empty)
+Person createPerson(const std::string& name, double x, const std::string& group_name);
+/// Creates groups from the group names of @ref people, in the order of their first appearance
+Groups createGroups(const People& people);
+/// Returns names of events of the given type in the order of appearance ("person:group:other_group")
+std::vector<std::string> getEvents(const std::vector<FrameEvent>& events, FrameEventType type);
+
+// Test cases
+TEST(FrameDiffTest, events) {
+	Frame prev;
+	prev.people = {
+		createPerson("a", 0.0, "g1"),
+		createPerson("b", 1.0, "g1"),
+		createPerson("c", 2.0, "g1"),
+		createPerson("d", 3.0, "g2"),
+		createPerson("e", 4.0, "g2"),
+		createPerson("f", 5.0, ""),
+		createPerson("v", 6.0, "g3")
+	};
+	prev.groups = createGroups(prev.people);
+	prev.header.seq = 1;
+	prev.header.stamp = ros::Time(10.0);
+	prev.header.frame_id = "odom";
+
+	Frame curr;
+	curr.people = {
+		createPerson("a", 0.5, "g1"),
+		createPerson("b", 1.0, "g1"),
+		createPerson("c", 2.0, "g4"),
+		createPerson("d", 3.0, "g1"),
+		createPerson("e", 4.0, ""),
+		createPerson("n", 7.0, "g4"),
+		createPerson("f", 5.0, "")
+	};
+	curr.groups = createGroups(curr.people);
+	curr.header.seq = 2;
+	curr.header.stamp = ros::Time(10.1);
+	curr.header.frame_id = "map";
+
+	auto events = diffFrames(prev, curr);
+	EXPECT_EQ(getEvents(events, FrameEventType::TRACK_APPEARED), std::vector<std::string>{"n::"});
+	EXPECT_EQ(getEvents(events, FrameEventType::TRACK_VANISHED), std::vector<std::string>{"v::"});
+	EXPECT_EQ(getEvents(events, FrameEventType::GROUP_JOINED), (std::vector<std::string>{"c:g4:", "d:g1:", "n:g4:"}));
+	EXPECT_EQ(
+		getEvents(events, FrameEventType::GROUP_LEFT),
+		(std::vector<std::string>{"c:g1:", "d:g2:", "e:g2:", "v:g3:"})
+	);
+	EXPECT_EQ(getEvents(events, FrameEventType::GROUP_FORMED), std::vector<std::string>{":g4:"});
+	EXPECT_EQ(getEvents(events, FrameEventType::GROUP_DISSOLVED), (std::vector<std::string>{":g2:", ":g3:"}));
+	EXPECT_EQ(getEvents(events, FrameEventType::GROUP_SPLIT), (std::vector<std::string>{":g1:g1", ":g1:g4"}));
+	EXPECT_EQ(getEvents(events, FrameEventType::GROUP_MERGED), (std::vector<std::string>{":g1:g1", ":g1:g2"}));
+	// ordered by types
+	EXPECT_TRUE(std::is_sorted(
+		events.cbegin(),
+		events.cend(),
+		[](const FrameEvent& lhs, const FrameEvent& rhs) {
+			return lhs.type < rhs.type;
+		}
+	));
+
+	EXPECT_TRUE(diffFrames(curr, curr).empty());
+	EXPECT_TRUE(PeopleFrameDelta::fromFrames(curr, curr).empty());
+
+	// patching forward
+	auto delta = PeopleFrameDelta::fromFrames(prev, curr);
+	EXPECT_EQ(delta.removed_people, std::vector<std::string>{"v"});
+	// "b" and "f" did not change
+	EXPECT_EQ(delta.updated_people.size(), 5);
+	EXPECT_EQ(delta.removed_groups, (std::vector<std::string>{"g2", "g3"}));
+	EXPECT_EQ(delta.updated_groups.size(), 2);
+
+	EXPECT_EQ(delta.header.stamp, curr.header.stamp);
+
+	Frame patched = prev;
+	delta.apply(patched);
+	EXPECT_EQ(patched.header.seq, 2);
+	EXPECT_EQ(patched.header.stamp, ros::Time(10.1));
+	EXPECT_EQ(patched.header.frame_id, "map");
+	EXPECT_TRUE(diffFrames(patched, curr).empty());
+	EXPECT_TRUE(PeopleFrameDelta::fromFrames(patched, curr).empty());
+	ASSERT_EQ(patched.people.size(), curr.people.size());
+	ASSERT_EQ(patched.groups.size(), curr.groups.size());
+	EXPECT_EQ(patched.people.back().getName(), "n");
+}
+
+TEST(FrameDiffTest, crowd) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 300;
+	params.group_ratio = 0.5;
+	params.seed = 1;
+	Frame prev;
+	std::tie(prev.people, prev.groups) = createFromPeople(CrowdGenerator(params).generate());
+	params.seed = 2;
+	Frame curr;
+	std::tie(curr.people, curr.groups) = createFromPeople(CrowdGenerator(params).generate());
+
+	auto delta = PeopleFrameDelta::fromFrames(prev, curr);
+	delta.apply(prev);
+	EXPECT_TRUE(diffFrames(prev, curr).empty());
+	EXPECT_TRUE(PeopleFrameDelta::fromFrames(prev, curr).empty());
+	EXPECT_EQ(prev.people.size(), curr.people.size());
+	EXPECT_EQ(prev.groups.size(), curr.groups.size());
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+Person createPerson(const std::string& name, double x, const std::string& group_name) {
+	geometry_msgs::PoseWithCovariance pose;
+	pose.pose.position.x = x;
+	pose.pose.orientation.w = 1.0;
+	geometry_msgs::PoseWithCovariance vel;
+	return Person(name, pose, vel, 1.0, false, true, 1, 1, group_name);
+}
+
+Groups createGroups(const People& people) {
+	Groups groups;
+	for (const auto& person: people) {
+		if (!person.isAssignedToGroup()) {
+			continue;
+		}
+		auto it = std::find_if(groups.cbegin(), groups.cend(), [&](const Group& group) {
+			return group.getName() == person.getGroupName();
+		});
+		if (it != groups.cend()) {
+			continue;
+		}
+		People members;
+		std::vector<std::string> member_ids;
+		for (const auto& member: people) {
+			if (member.getGroupName() == person.getGroupName()) {
+				members.push_back(member);
+				member_ids.push_back(member.getName());
+			}
+		}
+		groups.emplace_back(
+			person.getGroupName(),
+			1,
+			members,
+			member_ids,
+			std::vector<std::tuple<std::string, std::string, double>>(),
+			geometry_msgs::Point()
+		);
+	}
+	return groups;
+}
+
+std::vector<std::string> getEvents(const std::vector<FrameEvent>& events, FrameEventType type) {
+	std::vector<std::string> names;
+	for (const auto& event: events) {
+		if (event.type == type) {
+			names.push_back(event.person + ":" + event.group + ":" + event.other_group);
+		}
+	}
+	return names;
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/frame_resampler.h>
+#include <people_msgs_utils/utils.h>
+
+#include <cmath>
+
+using namespace people_msgs_utils;
+
+/// Creates a person with the given planar state and anisotropic covariances
+Person createPerson(const std::string& name, double x, double y, double yaw, double vx, const std::string& group_name);
+/// Creates a frame with people "a" and "b" forming group "g" and a standalone person "c" shifted by @ref offset
+Frame createFrame(double stamp, double offset, double yaw_a);
+
+// Test cases
+TEST(FrameResamplerTest, interpolationAndExtrapolation) {
+	FrameResampler resampler;
+	Frame output;
+	EXPECT_FALSE(resampler.resample(ros::Time(1.0), output));
+
+	EXPECT_TRUE(resampler.add(createFrame(1.0, 0.0, 3.0)));
+	EXPECT_TRUE(resampler.add(createFrame(1.2, 0.2, -3.0)));
+	// older frames are rejected
+	EXPECT_FALSE(resampler.add(createFrame(1.1, 0.1, 0.0)));
+	EXPECT_EQ(resampler.size(), 2);
+	EXPECT_NEAR(resampler.getAge(ros::Time(1.5)), 0.3, 1e-6);
+
+	// interpolation
+	ASSERT_TRUE(resampler.resample(ros::Time(1.1), output));
+	EXPECT_EQ(output.header.stamp, ros::Time(1.1));
+	EXPECT_EQ(output.header.frame_id, "map");
+	ASSERT_EQ(output.people.size(), 3);
+	EXPECT_NEAR(output.people.at(0).getPositionX(), 0.1, 1e-6);
+	EXPECT_NEAR(output.people.at(1).getPositionX(), 1.1, 1e-6);
+	// along the shorter arc
+	EXPECT_NEAR(std::abs(output.people.at(0).getOrientationYaw()), M_PI, 1e-6);
+
+	// group moved rigidly with its members
+	ASSERT_EQ(output.groups.size(), 1);
+	const auto& group = output.groups.front();
+	EXPECT_NEAR(group.getCenterOfGravity().x, 0.6, 1e-6);
+	EXPECT_NEAR(group.getCenterOfGravity().y, 0.0, 1e-6);
+	ASSERT_EQ(group.getMembers().size(), 2);
+	EXPECT_NEAR(group.getMembers().at(1).getPositionX(), 1.1, 1e-6);
+
+	// extrapolation with constant velocities
+	ASSERT_TRUE(resampler.resample(ros::Time(1.5), output));
+	EXPECT_NEAR(output.people.at(0).getPositionX(), 0.2 + 0.3, 1e-6);
+	EXPECT_NEAR(output.people.at(2).getPositionX(), 5.2 - 0.3 * 0.5, 1e-6);
+	EXPECT_NEAR(output.groups.front().getCenterOfGravity().x, 0.7 + 0.3, 1e-6);
+	ASSERT_TRUE(resampler.resample(ros::Time(0.8), output));
+	EXPECT_NEAR(output.people.at(0).getPositionX(), -0.2, 1e-6);
+	EXPECT_FALSE(resampler.resample(ros::Time(1.8), output));
+
+	resampler.clear();
+	EXPECT_EQ(resampler.size(), 0);
+}
+
+TEST(FrameResamplerTest, rigidMotionOfGroup) {
+	Frame frame = createFrame(1.0, 0.0, 0.0);
+	auto& group = frame.groups.front();
+	const Group group_before = group;
+	group.moveRigidly(1.0, 2.0, M_PI / 2.0);
+	// rotated by 90 degrees, then translated
+	EXPECT_NEAR(group.getCenterOfGravity().x, 1.0, 1e-9);
+	EXPECT_NEAR(group.getCenterOfGravity().y, 2.5, 1e-9);
+	const auto& member = group.getMembers().at(1);
+	EXPECT_NEAR(member.getPositionX(), 1.0, 1e-9);
+	EXPECT_NEAR(member.getPositionY(), 3.0, 1e-9);
+	EXPECT_NEAR(member.getOrientationYaw(), M_PI / 2.0, 1e-9);
+	EXPECT_NEAR(member.getVelocityX(), 0.0, 1e-9);
+	EXPECT_NEAR(member.getVelocityY(), 1.0, 1e-9);
+
+	// covariances of members are rotated too: x and y swap, the correlation flips
+	EXPECT_NEAR(member.getCovariancePoseXX(), 0.1, 1e-9);
+	EXPECT_NEAR(member.getCovariancePoseYY(), 0.4, 1e-9);
+	EXPECT_NEAR(member.getCovariancePoseXY(), -0.05, 1e-9);
+	EXPECT_NEAR(member.getCovariancePoseYX(), -0.05, 1e-9);
+	EXPECT_NEAR(member.getCovariancePoseYawYaw(), 0.3, 1e-9);
+	EXPECT_NEAR(member.getCovarianceVelocityXX(), 0.02, 1e-9);
+	EXPECT_NEAR(member.getCovarianceVelocityYY(), 0.2, 1e-9);
+	EXPECT_NEAR(member.getCovarianceVelocityXY(), -0.01, 1e-9);
+
+	// spatial model of the group
+	EXPECT_NEAR(group.getPositionX(), 1.0 - group_before.getPositionY(), 1e-9);
+	EXPECT_NEAR(group.getPositionY(), 2.0 + group_before.getPositionX(), 1e-9);
+	EXPECT_NEAR(
+		std::remainder(group.getOrientationYaw() - group_before.getOrientationYaw() - M_PI / 2.0, 2.0 * M_PI),
+		0.0,
+		1e-9
+	);
+	EXPECT_NEAR(group.getCovariancePoseXX(), group_before.getCovariancePoseYY(), 1e-9);
+	EXPECT_NEAR(group.getCovariancePoseYY(), group_before.getCovariancePoseXX(), 1e-9);
+	EXPECT_NEAR(group.getCovariancePoseXY(), -group_before.getCovariancePoseXY(), 1e-9);
+	EXPECT_NEAR(group.getCovariancePoseYX(), -group_before.getCovariancePoseYX(), 1e-9);
+	EXPECT_NEAR(group.getCovariancePoseYawYaw(), group_before.getCovariancePoseYawYaw(), 1e-9);
+	// derived from the anisotropic covariances of members
+	EXPECT_GT(group_before.getCovariancePoseXX(), group_before.getCovariancePoseYY());
+}
+
+TEST(FrameResamplerTest, stampedConversion) {
+	people_msgs::People msg;
+	msg.header.stamp = ros::Time(12.5);
+	msg.header.frame_id = "odom";
+	msg.people.resize(2);
+	msg.people[0].name = "1";
+	msg.people[1].name = "2";
+
+	Frame frame;
+	createFromPeople(msg, frame);
+	EXPECT_EQ(frame.header.stamp, ros::Time(12.5));
+	EXPECT_EQ(frame.header.frame_id, "odom");
+	EXPECT_EQ(frame.people.size(), 2);
+
+	createFromPeople(msg.people, frame);
+	EXPECT_TRUE(frame.header.frame_id.empty());
+	EXPECT_TRUE(frame.header.stamp.isZero());
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+Person createPerson(const std::string& name, double x, double y, double yaw, double vx, const std::string& group_name) {
+	geometry_msgs::PoseWithCovariance pose;
+	pose.pose.position.x = x;
+	pose.pose.position.y = y;
+	pose.pose.orientation.z = std::sin(yaw / 2.0);
+	pose.pose.orientation.w = std::cos(yaw / 2.0);
+	pose.covariance[Person::COV_XX_INDEX] = 0.4;
+	pose.covariance[Person::COV_XY_INDEX] = 0.05;
+	pose.covariance[Person::COV_YX_INDEX] = 0.05;
+	pose.covariance[Person::COV_YY_INDEX] = 0.1;
+	pose.covariance[Person::COV_YAWYAW_INDEX] = 0.3;
+	geometry_msgs::PoseWithCovariance vel;
+	vel.pose.position.x = vx;
+	vel.pose.orientation.w = 1.0;
+	vel.covariance[Person::COV_XX_INDEX] = 0.2;
+	vel.covariance[Person::COV_XY_INDEX] = 0.01;
+	vel.covariance[Person::COV_YX_INDEX] = 0.01;
+	vel.covariance[Person::COV_YY_INDEX] = 0.02;
+	return Person(name, pose, vel, 1.0, false, true, 1, 1, group_name);
+}
+
+Frame createFrame(double stamp, double offset, double yaw_a) {
+	Frame frame;
+	frame.header.stamp = ros::Time(stamp);
+	frame.header.frame_id = "map";
+	frame.people = {
+		createPerson("a", offset, 0.0, yaw_a, 1.0, "g"),
+		createPerson("b", 1.0 + offset, 0.0, 0.0, 1.0, "g"),
+		createPerson("c", 5.0 + offset, 1.0, 0.0, -0.5, "")
+	};
+	geometry_msgs::Point cog;
+	cog.x = 0.5 + offset;
+	frame.groups.emplace_back(
+		"g",
+		1,
+		People{frame.people[0], frame.people[1]},
+		std::vector<std::string>{"a", "b"},
+		std::vector<std::tuple<std::string, std::string, double>>(),
+		cog
+	);
+	return frame;
+}
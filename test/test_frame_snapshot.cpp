@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/frame_snapshot.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace people_msgs_utils;
+
+Frame createFrame(unsigned int index);
+
+// Test cases
+TEST(FrameSnapshotTest, initiallyEmpty) {
+	FrameSnapshot snapshot;
+	auto frame = snapshot.get();
+	ASSERT_NE(frame, nullptr);
+	EXPECT_TRUE(frame->people.empty());
+	EXPECT_TRUE(frame->groups.empty());
+	EXPECT_EQ(snapshot.getVersion(), 0);
+}
+
+TEST(FrameSnapshotTest, readerKeepsFrame) {
+	FrameSnapshot snapshot;
+	snapshot.publish(createFrame(1));
+	auto frame1 = snapshot.get();
+	snapshot.publish(createFrame(2));
+	auto frame2 = snapshot.get();
+
+	EXPECT_EQ(snapshot.getVersion(), 2);
+	// frame obtained earlier must stay untouched
+	ASSERT_EQ(frame1->people.size(), 3);
+	EXPECT_EQ(frame1->people.at(0).getName(), "1");
+	ASSERT_EQ(frame2->people.size(), 4);
+	EXPECT_EQ(frame2->people.at(0).getName(), "2");
+}
+
+/// Intended to be run with ThreadSanitizer as well
+TEST(FrameSnapshotTest, concurrentReaders) {
+	const unsigned int FRAMES = 2000;
+	const unsigned int READERS = 4;
+
+	FrameSnapshot snapshot;
+	std::atomic<bool> done(false);
+	std::atomic<unsigned int> inconsistencies(0);
+
+	std::vector<std::thread> readers;
+	for (unsigned int r = 0; r < READERS; r++) {
+		readers.emplace_back([&]() {
+			unsigned long int version_prev = 0;
+			long int index_prev = -1;
+			while (!done.load()) {
+				auto version = snapshot.getVersion();
+				auto frame = snapshot.get();
+				if (version < version_prev) {
+					inconsistencies++;
+				}
+				version_prev = version;
+				if (frame->people.empty()) {
+					continue;
+				}
+				// snapshots never go backwards
+				long int index = std::stol(frame->people.front().getName());
+				if (index < index_prev) {
+					inconsistencies++;
+				}
+				index_prev = index;
+				// all people of a frame are named after its index
+				for (const auto& person: frame->people) {
+					if (person.getName() != frame->people.front().getName()) {
+						inconsistencies++;
+					}
+				}
+			}
+		});
+	}
+
+	for (unsigned int i = 0; i < FRAMES; i++) {
+		snapshot.publish(createFrame(i));
+	}
+	done = true;
+	for (auto& reader: readers) {
+		reader.join();
+	}
+
+	EXPECT_EQ(inconsistencies.load(), 0);
+	EXPECT_EQ(snapshot.getVersion(), FRAMES);
+	EXPECT_EQ(snapshot.get()->people.front().getName(), std::to_string(FRAMES - 1));
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+Frame createFrame(unsigned int index) {
+	Frame frame;
+	geometry_msgs::PoseWithCovariance pose;
+	pose.pose.orientation.w = 1.0;
+	geometry_msgs::PoseWithCovariance vel;
+	for (unsigned int i = 0; i < 2 + index % 3; i++) {
+		pose.pose.position.x = static_cast<double>(i);
+		frame.people.emplace_back(std::to_string(index), pose, vel, 0.9, false, true, i, index, "");
+	}
+	return frame;
+}
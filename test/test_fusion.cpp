@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/fusion.h>
+#include <people_msgs_utils/utils.h>
+
+#include <cmath>
+
+using namespace people_msgs_utils;
+
+/// Creates a person at the given position with isotropic pose covariance
+Person createPerson(const std::string& name, double x, double y, double variance, const std::string& group_name = "");
+
+/// Creates a group of the given people
+Group createGroup(const std::string& name, const People& members);
+
+// Test cases
+TEST(FusionTest, deduplication) {
+	Frame lidar;
+	lidar.header.stamp = ros::Time(10.0);
+	lidar.people = {
+		createPerson("a", 0.0, 0.0, 0.1),
+		createPerson("b", 5.0, 0.0, 0.1),
+		createPerson("c", 10.0, 0.0, 0.1),
+		createPerson("d", 15.0, 0.0, 0.001)
+	};
+	Frame rgbd;
+	rgbd.header.stamp = ros::Time(10.5);
+	rgbd.people = {
+		// the same person with the same ID
+		createPerson("a", 0.1, 0.0, 0.1),
+		// the same person with another ID, more certain
+		createPerson("x", 5.3, 0.0, 0.05),
+		// another person with a conflicting ID
+		createPerson("c", 20.0, 0.0, 0.1),
+		// near but outside of the gate
+		createPerson("y", 15.5, 0.0, 0.001)
+	};
+
+	PeopleFusion fusion;
+	Frame fused;
+	fusion.fuse({&lidar, &rgbd}, fused);
+	ASSERT_EQ(fused.people.size(), 6);
+	EXPECT_EQ(fused.header.stamp, ros::Time(10.5));
+	EXPECT_EQ(fusion.getAssignments().at(0), (std::vector<size_t>{0, 1, 2, 3}));
+	EXPECT_EQ(fusion.getAssignments().at(1), (std::vector<size_t>{0, 1, 4, 5}));
+
+	// information-weighted means
+	EXPECT_EQ(fused.people[0].getName(), "a");
+	EXPECT_NEAR(fused.people[0].getPositionX(), 0.05, 1e-9);
+	EXPECT_NEAR(fused.people[0].getCovariancePoseXX(), 0.05, 1e-9);
+	EXPECT_EQ(fused.people[1].getName(), "b");
+	EXPECT_NEAR(fused.people[1].getPositionX(), 5.2, 1e-9);
+	EXPECT_NEAR(fused.people[1].getCovariancePoseYY(), 0.1 / 3.0, 1e-9);
+	EXPECT_NEAR(fused.people[2].getPositionX(), 10.0, 1e-9);
+
+	EXPECT_EQ(fused.people[4].getName(), "1/c");
+	EXPECT_NEAR(fused.people[4].getPositionX(), 20.0, 1e-9);
+	EXPECT_EQ(fused.people[5].getName(), "y");
+	EXPECT_TRUE(fused.groups.empty());
+
+	// a single source is copied
+	fusion.fuse({&rgbd}, fused);
+	ASSERT_EQ(fused.people.size(), 4);
+	EXPECT_EQ(fused.people[1].getName(), "x");
+	fusion.fuse({}, fused);
+	EXPECT_TRUE(fused.people.empty());
+}
+
+TEST(FusionTest, groupsMergedThroughIds) {
+	Frame lidar;
+	lidar.people = {
+		createPerson("a", 0.0, 0.0, 0.1, "1"),
+		createPerson("b", 1.0, 0.0, 0.1, "1"),
+		createPerson("c", 5.0, 0.0, 0.1, "2"),
+		createPerson("d", 6.0, 0.0, 0.1, "2")
+	};
+	lidar.groups = {
+		createGroup("1", {lidar.people[0], lidar.people[1]}),
+		createGroup("2", {lidar.people[2], lidar.people[3]})
+	};
+	Frame rgbd;
+	rgbd.people = {
+		createPerson("u", 1.0, 0.0, 0.1, "1"),
+		createPerson("v", 1.0, 1.0, 0.1, "1"),
+		// group IDs of the sources are unrelated
+		createPerson("w", 5.0, 0.0, 0.1, "7"),
+		createPerson("z", 5.0, 1.0, 0.1, "7")
+	};
+	rgbd.groups = {
+		createGroup("1", {rgbd.people[0], rgbd.people[1]}),
+		createGroup("7", {rgbd.people[2], rgbd.people[3]})
+	};
+
+	PeopleFusion fusion;
+	Frame fused;
+	fusion.fuse({&lidar, &rgbd}, fused);
+	ASSERT_EQ(fused.people.size(), 6);
+	ASSERT_EQ(fused.groups.size(), 2);
+	// b and u are the same person, linking both groups "1"
+	EXPECT_EQ(fused.groups[0].getMemberIDs(), (std::vector<std::string>{"a", "b", "v"}));
+	EXPECT_EQ(fused.groups[1].getMemberIDs(), (std::vector<std::string>{"c", "d", "z"}));
+	EXPECT_EQ(fused.people[5].getGroupName(), fused.groups[1].getName());
+	// relations of both sources in IDs of fused people
+	ASSERT_EQ(fused.groups[0].getSocialRelations().size(), 2);
+	EXPECT_EQ(std::get<0>(fused.groups[0].getSocialRelations()[1]), "b");
+	EXPECT_EQ(std::get<1>(fused.groups[0].getSocialRelations()[1]), "v");
+}
+
+TEST(FusionTest, crowd) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 500;
+	params.group_ratio = 0.5;
+	Frame lidar;
+	createFromPeople(CrowdGenerator(params).generate(), lidar);
+
+	// another tracker with different IDs and slightly different estimates
+	Frame rgbd = lidar;
+	for (size_t i = 0; i < rgbd.people.size(); i++) {
+		auto& person = rgbd.people[i];
+		person.setName("r" + person.getName());
+		person.setPlanarState(
+			person.getPositionX() + 0.02 * std::sin(i),
+			person.getPositionY() + 0.02 * std::cos(i),
+			person.getOrientationYaw(),
+			person.getVelocityX(),
+			person.getVelocityY()
+		);
+	}
+	// groups are reported by the first tracker only
+	rgbd.groups.clear();
+
+	PeopleFusion fusion;
+	Frame fused;
+	fusion.fuse({&lidar, &rgbd}, fused);
+	ASSERT_EQ(fused.people.size(), lidar.people.size());
+	for (size_t i = 0; i < lidar.people.size(); i++) {
+		EXPECT_EQ(fusion.getAssignments().at(1).at(i), i);
+	}
+	EXPECT_EQ(fused.groups.size(), lidar.groups.size());
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+Person createPerson(const std::string& name, double x, double y, double variance, const std::string& group_name) {
+	geometry_msgs::PoseWithCovariance pose;
+	pose.pose.position.x = x;
+	pose.pose.position.y = y;
+	pose.pose.orientation.w = 1.0;
+	pose.covariance[Person::COV_XX_INDEX] = variance;
+	pose.covariance[Person::COV_YY_INDEX] = variance;
+	geometry_msgs::PoseWithCovariance vel;
+	return Person(name, pose, vel, 1.0, false, true, 1, 1, group_name);
+}
+
+Group createGroup(const std::string& name, const People& members) {
+	std::vector<std::string> member_ids;
+	std::vector<std::tuple<std::string, std::string, double>> relations;
+	for (const auto& member: members) {
+		member_ids.push_back(member.getName());
+	}
+	relations.emplace_back(member_ids.front(), member_ids.back(), 0.8);
+	return Group(name, 0, members, member_ids, relations, geometry_msgs::Point());
+}
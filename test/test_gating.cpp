@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/gating.h>
+#include <people_msgs_utils/utils.h>
+
+#include <cmath>
+
+using namespace people_msgs_utils;
+
+// Test cases
+TEST(GatingTest, covarianceFactors) {
+	PeopleArrays people;
+	people.x = {0.0, 0.0, 0.0};
+	people.y = {0.0, 0.0, 0.0};
+	// regular, without covariance data, singular
+	people.cov_xx = {0.5, 0.0, 1.0};
+	people.cov_xy = {0.2, 0.0, 1.0};
+	people.cov_yy = {0.3, 0.0, 1.0};
+	people.computeCovarianceFactors();
+	ASSERT_EQ(people.cov_inv_xx.size(), 3);
+
+	// L * L^T
+	EXPECT_NEAR(people.cov_chol_xx[0] * people.cov_chol_xx[0], 0.5, 1e-12);
+	EXPECT_NEAR(people.cov_chol_yx[0] * people.cov_chol_xx[0], 0.2, 1e-12);
+	EXPECT_NEAR(
+		people.cov_chol_yx[0] * people.cov_chol_yx[0] + people.cov_chol_yy[0] * people.cov_chol_yy[0],
+		0.3,
+		1e-12
+	);
+	// covariance * inverse = identity
+	EXPECT_NEAR(0.5 * people.cov_inv_xx[0] + 0.2 * people.cov_inv_xy[0], 1.0, 1e-12);
+	EXPECT_NEAR(0.5 * people.cov_inv_xy[0] + 0.2 * people.cov_inv_yy[0], 0.0, 1e-12);
+	EXPECT_NEAR(0.2 * people.cov_inv_xy[0] + 0.3 * people.cov_inv_yy[0], 1.0, 1e-12);
+
+	// regularized
+	for (size_t i = 1; i < 3; i++) {
+		EXPECT_TRUE(std::isfinite(people.cov_inv_xx[i]));
+		EXPECT_TRUE(std::isfinite(people.cov_inv_yy[i]));
+		EXPECT_GT(people.cov_chol_yy[i], 0.0);
+	}
+	EXPECT_NEAR(computeMahalanobisDistanceSq(people, 1, 1e-3, 0.0), 1.0, 1e-9);
+
+	EXPECT_NEAR(chiSquareQuantile2D(0.95), 5.991, 1e-3);
+	EXPECT_NEAR(chiSquareQuantile2D(0.99), 9.210, 1e-3);
+}
+
+TEST(GatingTest, sameAsBruteForce) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 600;
+	auto frame = createFromPeople(CrowdGenerator(params).generate());
+	const auto& people = frame.first;
+	PeopleArrays arrays;
+	arrays.assign(people);
+
+	std::vector<double> xs;
+	std::vector<double> ys;
+	for (double x = -20.0; x <= 20.0; x += 1.3) {
+		for (double y = -20.0; y <= 20.0; y += 1.7) {
+			xs.push_back(x);
+			ys.push_back(y);
+		}
+	}
+	double threshold = chiSquareQuantile2D(0.99);
+	auto pairs = gateMahalanobis(arrays, xs, ys, threshold);
+	ASSERT_FALSE(pairs.empty());
+
+	std::vector<GatingPair> pairs_ref;
+	for (size_t q = 0; q < xs.size(); q++) {
+		for (size_t i = 0; i < people.size(); i++) {
+			// inverse of the 2x2 matrix from the getters
+			double xx = people[i].getCovariancePoseXX();
+			double xy = people[i].getCovariancePoseXY();
+			double yy = people[i].getCovariancePoseYY();
+			double det = xx * yy - xy * xy;
+			double dx = xs[q] - people[i].getPositionX();
+			double dy = ys[q] - people[i].getPositionY();
+			double distance_sq = (yy * dx * dx - 2.0 * xy * dx * dy + xx * dy * dy) / det;
+			if (distance_sq <= threshold) {
+				pairs_ref.push_back(GatingPair{q, i, distance_sq});
+			}
+		}
+	}
+	ASSERT_EQ(pairs.size(), pairs_ref.size());
+	for (size_t k = 0; k < pairs.size(); k++) {
+		EXPECT_EQ(pairs[k].query, pairs_ref[k].query);
+		EXPECT_EQ(pairs[k].person, pairs_ref[k].person);
+		EXPECT_NEAR(pairs[k].distance_sq, pairs_ref[k].distance_sq, 1e-9);
+		EXPECT_NEAR(
+			pairs[k].distance_sq,
+			computeMahalanobisDistanceSq(arrays, pairs[k].person, xs[pairs[k].query], ys[pairs[k].query]),
+			1e-12
+		);
+	}
+
+	// reused output
+	std::vector<GatingPair> pairs_reused(3);
+	gateMahalanobis(arrays, xs.data(), ys.data(), 0, threshold, pairs_reused);
+	EXPECT_TRUE(pairs_reused.empty());
+	EXPECT_THROW(gateMahalanobis(arrays, xs, std::vector<double>(), threshold), std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
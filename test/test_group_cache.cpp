@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/group_cache.h>
+#include <people_msgs_utils/utils.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace people_msgs_utils;
+
+/// Creates a group with members of the given names and positions
+Group createGroup(
+	const std::string& name,
+	const std::vector<std::string>& member_names,
+	const std::vector<std::pair<double, double>>& positions
+);
+
+// Test cases
+TEST(GroupCacheTest, reuseAndMove) {
+	GroupCache cache;
+	std::vector<std::string> names{"a", "b", "c"};
+	std::vector<std::pair<double, double>> positions{{0.0, 0.0}, {2.0, 0.0}, {1.0, 1.5}};
+	auto group = createGroup("g1", names, positions);
+	Group::Ellipse ellipse;
+	EXPECT_FALSE(cache.findEllipse("g1", group.getMembers(), ellipse));
+	cache.update(Groups{group});
+	ASSERT_EQ(cache.size(), 1);
+	ASSERT_NE(cache.find("g1"), nullptr);
+	EXPECT_EQ(cache.find("g1")->age, 0);
+	EXPECT_EQ(cache.find("g1")->ellipse_source, GroupCache::EllipseSource::FITTED);
+
+	// small motions keep the ellipse, but they add up
+	for (size_t i = 1; i <= 3; i++) {
+		positions[0].first += 0.02;
+		auto moved = createGroup("g1", names, positions);
+		ASSERT_TRUE(cache.findEllipse("g1", moved.getMembers(), ellipse));
+		cache.update(Groups{moved});
+		if (i < 3) {
+			EXPECT_EQ(ellipse.center_x, group.getEllipse().center_x);
+			EXPECT_EQ(ellipse.span_x, group.getEllipse().span_x);
+			EXPECT_EQ(cache.find("g1")->ellipse_source, GroupCache::EllipseSource::REUSED);
+		} else {
+			// 0.06 m in total, still rigid up to the tolerance
+			EXPECT_EQ(cache.find("g1")->ellipse_source, GroupCache::EllipseSource::MOVED);
+		}
+	}
+	EXPECT_EQ(cache.find("g1")->age, 3);
+	EXPECT_EQ(cache.find("g1")->continuity, 4);
+
+	// rigid motion moves the ellipse, starting from a fitted one
+	auto reference = createGroup("g1", names, positions);
+	cache.clear();
+	cache.update(Groups{reference});
+	double yaw = 0.3;
+	auto positions_moved = positions;
+	for (auto& position: positions_moved) {
+		double x = position.first;
+		double y = position.second;
+		position.first = std::cos(yaw) * x - std::sin(yaw) * y + 1.0;
+		position.second = std::sin(yaw) * x + std::cos(yaw) * y - 2.0;
+	}
+	auto moved = createGroup("g1", names, positions_moved);
+	ASSERT_TRUE(cache.findEllipse("g1", moved.getMembers(), ellipse));
+	EXPECT_NEAR(ellipse.center_x, moved.getEllipse().center_x, 1e-9);
+	EXPECT_NEAR(ellipse.center_y, moved.getEllipse().center_y, 1e-9);
+	EXPECT_NEAR(ellipse.yaw, reference.getEllipse().yaw + yaw, 1e-9);
+	EXPECT_NEAR(ellipse.span_x, moved.getEllipse().span_x, 1e-9);
+	cache.update(Groups{moved});
+	EXPECT_EQ(cache.find("g1")->ellipse_source, GroupCache::EllipseSource::MOVED);
+
+	// non-rigid motion requires fitting
+	positions_moved[2].second += 0.5;
+	EXPECT_FALSE(cache.findEllipse("g1", createGroup("g1", names, positions_moved).getMembers(), ellipse));
+}
+
+TEST(GroupCacheTest, deformingWalk) {
+	// the group walks by 0.1 m per frame, while its members slowly move apart
+	GroupCache cache;
+	std::vector<std::string> names{"a", "b", "c"};
+	std::vector<std::pair<double, double>> formation{{-1.0, 0.0}, {1.0, 0.0}, {0.0, 1.0}};
+	size_t num_fitted = 0;
+	size_t num_derived = 0;
+	double span_error_max = 0.0;
+	for (size_t frame = 0; frame < 60; frame++) {
+		std::vector<std::pair<double, double>> positions;
+		double scale = 1.0 + 0.02 * frame;
+		for (const auto& [x, y]: formation) {
+			positions.emplace_back(scale * x + 0.1 * frame, scale * y);
+		}
+		auto group = createGroup("g1", names, positions);
+		Group::Ellipse ellipse;
+		if (cache.findEllipse("g1", group.getMembers(), ellipse)) {
+			span_error_max = std::max(span_error_max, std::abs(ellipse.span_x - group.getEllipse().span_x));
+			num_derived++;
+		}
+		cache.update(Groups{group});
+		num_fitted += cache.find("g1")->ellipse_source == GroupCache::EllipseSource::FITTED;
+	}
+	// deformations do not add up, so the ellipse is refitted regularly and stays close to a fitted one
+	EXPECT_GT(num_derived, 0);
+	EXPECT_GT(num_fitted, 10);
+	EXPECT_LT(span_error_max, 0.2);
+}
+
+TEST(GroupCacheTest, identity) {
+	GroupCache::Parameters params;
+	params.max_missed_frames = 2;
+	GroupCache cache(params);
+	std::vector<std::pair<double, double>> positions{{0.0, 0.0}, {2.0, 0.0}, {1.0, 1.5}, {1.0, -1.5}};
+	cache.update(Groups{createGroup("g1", {"a", "b", "c"}, positions)});
+
+	// the ID changes
+	auto renamed = createGroup("g7", {"c", "a", "b"}, {positions[2], positions[0], positions[1]});
+	Group::Ellipse ellipse;
+	EXPECT_TRUE(cache.findEllipse("g7", renamed.getMembers(), ellipse));
+	cache.update(Groups{renamed});
+	EXPECT_EQ(cache.find("g1"), nullptr);
+	ASSERT_NE(cache.find("g7"), nullptr);
+	EXPECT_EQ(cache.find("g7")->id, "g1");
+	EXPECT_EQ(cache.find("g7")->continuity, 2);
+
+	// the ID and members change
+	auto joined = createGroup("g8", {"a", "b", "c", "d"}, positions);
+	EXPECT_FALSE(cache.findEllipse("g8", joined.getMembers(), ellipse));
+	// another group competes for the same track
+	auto split = createGroup("g9", {"a", "b"}, positions);
+	cache.update(Groups{joined, split});
+	ASSERT_EQ(cache.size(), 2);
+	EXPECT_EQ(cache.find("g8")->id, "g1");
+	EXPECT_EQ(cache.find("g9")->id, "g9");
+	EXPECT_EQ(cache.find("g9")->age, 0);
+
+	// missing groups are forgotten eventually
+	cache.update(Groups{joined});
+	EXPECT_EQ(cache.find("g9")->continuity, 0);
+	EXPECT_EQ(cache.find("g9")->missed, 1);
+	cache.update(Groups{joined});
+	cache.update(Groups{joined});
+	EXPECT_EQ(cache.size(), 1);
+	EXPECT_EQ(cache.find("g8")->age, 5);
+
+	cache.clear();
+	EXPECT_EQ(cache.size(), 0);
+	EXPECT_EQ(cache.find("g8"), nullptr);
+}
+
+TEST(GroupCacheTest, conversion) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 200;
+	params.group_ratio = 0.5;
+	CrowdGenerator generator(params);
+	people_msgs::People msg;
+	msg.people = generator.generate();
+
+	GroupCache cache;
+	Frame frame;
+	Frame frame_ref;
+	for (size_t i = 0; i < 2; i++) {
+		// the same message twice: all ellipses are reused in the second frame
+		createFromPeople(msg, frame, cache);
+		createFromPeople(msg, frame_ref);
+		ASSERT_EQ(frame.groups.size(), frame_ref.groups.size());
+		ASSERT_EQ(cache.size(), frame.groups.size());
+		for (size_t g = 0; g < frame.groups.size(); g++) {
+			const auto& group = frame.groups[g];
+			const auto& group_ref = frame_ref.groups[g];
+			EXPECT_EQ(group.getName(), group_ref.getName());
+			EXPECT_EQ(group.getPositionX(), group_ref.getPositionX());
+			EXPECT_EQ(group.getSpanY(), group_ref.getSpanY());
+			EXPECT_EQ(group.getCovariancePoseXX(), group_ref.getCovariancePoseXX());
+			const auto* track = cache.find(group.getName());
+			ASSERT_NE(track, nullptr);
+			EXPECT_EQ(track->age, i);
+			EXPECT_EQ(
+				track->ellipse_source,
+				i == 0 ? GroupCache::EllipseSource::FITTED : GroupCache::EllipseSource::REUSED
+			);
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+Group createGroup(
+	const std::string& name,
+	const std::vector<std::string>& member_names,
+	const std::vector<std::pair<double, double>>& positions
+) {
+	std::vector<Person> members;
+	geometry_msgs::Point cog;
+	for (size_t i = 0; i < member_names.size(); i++) {
+		geometry_msgs::PoseWithCovariance pose;
+		pose.pose.position.x = positions.at(i).first;
+		pose.pose.position.y = positions.at(i).second;
+		pose.pose.orientation.w = 1.0;
+		geometry_msgs::PoseWithCovariance vel;
+		members.emplace_back(member_names[i], pose, vel, 1.0, false, true, 1, 1, name);
+		cog.x += pose.pose.position.x / member_names.size();
+		cog.y += pose.pose.position.y / member_names.size();
+	}
+	return Group(name, 0, members, member_names, {}, cog);
+}
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/grouping.h>
+
+using namespace people_msgs_utils;
+
+/// Creates a person at the given position, assigned to the group with @ref group_name (if not empty)
+Person createPerson(const std::string& name, double x, const std::string& group_name);
+/// Creates a message with the given tags only
+people_msgs::Person createMessage(const std::string& name, const std::string& tagname, const std::string& tag);
+
+// Test cases
+TEST(GroupingTest, disjointSets) {
+	DisjointSets sets(6);
+	EXPECT_TRUE(sets.unite(0, 1));
+	EXPECT_TRUE(sets.unite(2, 3));
+	EXPECT_TRUE(sets.unite(1, 3));
+	EXPECT_FALSE(sets.unite(0, 2));
+	EXPECT_EQ(sets.find(0), sets.find(3));
+	EXPECT_NE(sets.find(0), sets.find(4));
+	EXPECT_EQ(sets.getSize(2), 4);
+	EXPECT_EQ(sets.getSize(5), 1);
+	sets.reset(3);
+	EXPECT_EQ(sets.size(), 3);
+	EXPECT_EQ(sets.getSize(0), 1);
+}
+
+TEST(GroupingTest, relations) {
+	People people{
+		createPerson("a", 0.0, ""),
+		createPerson("b", 1.0, ""),
+		createPerson("c", 2.0, ""),
+		createPerson("d", 3.0, "g7"),
+		createPerson("e", 4.0, ""),
+		createPerson("f", 5.0, "g7"),
+		createPerson("h", 6.0, "")
+	};
+	std::vector<std::tuple<std::string, std::string, double>> relations{
+		{"a", "b", 0.9},
+		{"c", "b", 0.6},
+		{"d", "e", 0.3},
+		{"e", "f", 0.8},
+		{"x", "h", 0.9},
+		{"c", "h", 0.2}
+	};
+
+	// people are reassigned by the grouping
+	auto people_original = people;
+	Groups groups;
+	groupByRelations(people, relations, 0.5, groups);
+	ASSERT_EQ(groups.size(), 2);
+
+	EXPECT_EQ(groups[0].getName(), "a");
+	EXPECT_EQ(groups[0].getMemberIDs(), (std::vector<std::string>{"a", "b", "c"}));
+	EXPECT_EQ(groups[0].getSocialRelations().size(), 2);
+	EXPECT_DOUBLE_EQ(groups[0].getCenterOfGravity().x, 1.0);
+	ASSERT_EQ(groups[0].getMembers().size(), 3);
+	EXPECT_EQ(groups[0].getMembers()[2].getGroupName(), "a");
+
+	// named after the group of the first assigned member, linked by the group name
+	EXPECT_EQ(groups[1].getName(), "g7");
+	EXPECT_EQ(groups[1].getMemberIDs(), (std::vector<std::string>{"d", "e", "f"}));
+	EXPECT_EQ(groups[1].getSocialRelations().size(), 2);
+
+	EXPECT_EQ(people[1].getGroupName(), "a");
+	EXPECT_EQ(people[4].getGroupName(), "g7");
+	EXPECT_FALSE(people[6].isAssignedToGroup());
+
+	// strong relations only
+	people = people_original;
+	groupByRelations(people, relations, 0.85, groups);
+	ASSERT_EQ(groups.size(), 2);
+	EXPECT_EQ(groups[0].getMemberIDs(), (std::vector<std::string>{"a", "b"}));
+	EXPECT_EQ(groups[1].getName(), "g7");
+	EXPECT_EQ(groups[1].getMemberIDs(), (std::vector<std::string>{"d", "f"}));
+	EXPECT_FALSE(people[2].isAssignedToGroup());
+	EXPECT_FALSE(people[4].isAssignedToGroup());
+}
+
+TEST(GroupingTest, uniqueNames) {
+	// IDs of "a" and "c" are also names of other groups
+	People people{
+		createPerson("a", 0.0, ""),
+		createPerson("b", 1.0, ""),
+		createPerson("c", 2.0, "a"),
+		createPerson("d", 3.0, "a"),
+		createPerson("e", 4.0, "a_1"),
+		createPerson("f", 5.0, "a_1"),
+		createPerson("g", 6.0, "c"),
+		createPerson("h", 7.0, "")
+	};
+	std::vector<std::tuple<std::string, std::string, double>> relations{
+		{"a", "b", 0.9},
+		{"g", "h", 0.9}
+	};
+	Groups groups;
+	groupByRelations(people, relations, 0.5, groups);
+	ASSERT_EQ(groups.size(), 4);
+	EXPECT_EQ(groups[0].getName(), "a_2");
+	EXPECT_EQ(groups[1].getName(), "a");
+	EXPECT_EQ(groups[2].getName(), "a_1");
+	EXPECT_EQ(groups[3].getName(), "c");
+	EXPECT_EQ(people[0].getGroupName(), "a_2");
+	EXPECT_EQ(people[7].getGroupName(), "c");
+}
+
+TEST(GroupingTest, messagesWithoutGroupIDs) {
+	std::vector<people_msgs::Person> people{
+		createMessage("1", "social_relations", "1 2 0.9 2 3 0.7"),
+		createMessage("2", "social_relations", "1 2 0.9"),
+		createMessage("3", "", ""),
+		createMessage("4", "group_track_ids", "4 5"),
+		createMessage("5", "", ""),
+		createMessage("6", "social_relations", "6 1 0.1")
+	};
+	Frame frame;
+	createFromPeopleByRelations(people, frame, 0.5);
+	ASSERT_EQ(frame.people.size(), 6);
+	ASSERT_EQ(frame.groups.size(), 2);
+	EXPECT_EQ(frame.groups[0].getMemberIDs(), (std::vector<std::string>{"1", "2", "3"}));
+	// duplicates skipped, the weak relation with a non-member too
+	EXPECT_EQ(frame.groups[0].getSocialRelations().size(), 2);
+	EXPECT_EQ(frame.groups[1].getMemberIDs(), (std::vector<std::string>{"4", "5"}));
+	EXPECT_TRUE(frame.groups[1].getSocialRelations().empty());
+	EXPECT_EQ(frame.people[2].getGroupName(), "1");
+	EXPECT_FALSE(frame.people[5].isAssignedToGroup());
+
+	// people published with group IDs are linked as well, and names of groups stay unique
+	people.push_back(createMessage("7", "group_id", "1"));
+	people.push_back(createMessage("8", "group_id", "1"));
+	people.front().tagnames.push_back("group_id");
+	people.front().tags.push_back("4");
+	createFromPeopleByRelations(people, frame, 0.5);
+	ASSERT_EQ(frame.people.size(), 8);
+	ASSERT_EQ(frame.groups.size(), 3);
+	EXPECT_EQ(frame.groups[0].getName(), "4");
+	EXPECT_EQ(frame.groups[0].getMemberIDs(), (std::vector<std::string>{"1", "2", "3"}));
+	EXPECT_EQ(frame.groups[1].getName(), "4_1");
+	EXPECT_EQ(frame.groups[1].getMemberIDs(), (std::vector<std::string>{"4", "5"}));
+	EXPECT_EQ(frame.groups[2].getName(), "1");
+	EXPECT_EQ(frame.groups[2].getMemberIDs(), (std::vector<std::string>{"7", "8"}));
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+Person createPerson(const std::string& name, double x, const std::string& group_name) {
+	geometry_msgs::PoseWithCovariance pose;
+	pose.pose.position.x = x;
+	pose.pose.orientation.w = 1.0;
+	geometry_msgs::PoseWithCovariance vel;
+	return Person(name, pose, vel, 1.0, false, true, 1, 1, group_name);
+}
+
+people_msgs::Person createMessage(const std::string& name, const std::string& tagname, const std::string& tag) {
+	people_msgs::Person person;
+	person.name = name;
+	person.position.x = std::stod(name);
+	person.reliability = 1.0;
+	if (!tagname.empty()) {
+		person.tagnames.push_back(tagname);
+		person.tags.push_back(tag);
+	}
+	return person;
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/instrumentation.h>
+#include <people_msgs_utils/utils.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace people_msgs_utils;
+using namespace people_msgs_utils::instrumentation;
+
+/// Records 90 calls of 1 us, 9 calls of 10 us and 1 call of 1 ms
+void recordLatencies(Stage stage);
+
+/// Splits a CSV file into lines of fields
+std::vector<std::vector<std::string>> parseCsv(const std::string& csv);
+
+// Test cases
+TEST(InstrumentationTest, enabled) {
+	// the test is built only along with the instrumented library
+	EXPECT_TRUE(isEnabled());
+}
+
+TEST(InstrumentationTest, histogram) {
+	reset();
+	recordLatencies(Stage::TRANSFORM_GROUP);
+
+	// buckets are a quarter of an octave wide: 1000 ns falls into (896, 1024], 10000 ns into (8192, 10240]
+	// and 1 ms into (917504, 1048576]
+	auto histogram = getHistogram(Stage::TRANSFORM_GROUP);
+	ASSERT_EQ(histogram.size(), 3);
+	EXPECT_DOUBLE_EQ(histogram[0].upper_bound, 1024e-09);
+	EXPECT_EQ(histogram[0].count, 90);
+	EXPECT_DOUBLE_EQ(histogram[1].upper_bound, 10240e-09);
+	EXPECT_EQ(histogram[1].count, 9);
+	EXPECT_DOUBLE_EQ(histogram[2].upper_bound, 1048576e-09);
+	EXPECT_EQ(histogram[2].count, 1);
+
+	auto stats = getStatistics(Stage::TRANSFORM_GROUP);
+	EXPECT_EQ(stats.calls, 100);
+	EXPECT_EQ(stats.items, 200);
+	EXPECT_EQ(stats.errors, 0);
+	EXPECT_NEAR(stats.time_total, 90e-06 + 90e-06 + 1e-03, 1e-12);
+	// percentiles are upper bounds of the buckets where they fall
+	EXPECT_DOUBLE_EQ(stats.time_p50, 1024e-09);
+	EXPECT_DOUBLE_EQ(stats.time_p99, 10240e-09);
+	EXPECT_DOUBLE_EQ(stats.time_max, 1e-03);
+
+	// other stages stay untouched
+	EXPECT_EQ(getStatistics(Stage::TRANSFORM_PERSON).calls, 0);
+	EXPECT_TRUE(getHistogram(Stage::TRANSFORM_PERSON).empty());
+}
+
+TEST(InstrumentationTest, percentilesCappedByMaximum) {
+	reset();
+	// 1000 ns lies in a bucket bounded by 1024 ns, which is never reported beyond the slowest call
+	record(Stage::TRANSFORM_GROUP, std::chrono::nanoseconds(1000), 1, false);
+	auto stats = getStatistics(Stage::TRANSFORM_GROUP);
+	EXPECT_DOUBLE_EQ(stats.time_p50, 1000e-09);
+	EXPECT_DOUBLE_EQ(stats.time_p99, 1000e-09);
+}
+
+TEST(InstrumentationTest, reset) {
+	reset();
+	recordLatencies(Stage::TRANSFORM_GROUP);
+	recordLatencies(Stage::TRANSFORM_PERSON);
+
+	// reading with reset starts a new window of the stage
+	EXPECT_EQ(getStatistics(Stage::TRANSFORM_GROUP, true).calls, 100);
+	auto stats = getStatistics(Stage::TRANSFORM_GROUP);
+	EXPECT_EQ(stats.calls, 0);
+	EXPECT_EQ(stats.items, 0);
+	EXPECT_EQ(stats.time_total, 0.0);
+	EXPECT_EQ(stats.time_p50, 0.0);
+	EXPECT_EQ(stats.time_max, 0.0);
+	EXPECT_TRUE(getHistogram(Stage::TRANSFORM_GROUP).empty());
+	EXPECT_EQ(getStatistics(Stage::TRANSFORM_PERSON).calls, 100);
+
+	reset();
+	EXPECT_EQ(getStatistics(Stage::TRANSFORM_PERSON).calls, 0);
+	EXPECT_TRUE(getHistogram(Stage::TRANSFORM_PERSON).empty());
+}
+
+TEST(InstrumentationTest, exportCsv) {
+	reset();
+	recordLatencies(Stage::TRANSFORM_GROUP);
+
+	auto lines = parseCsv(exportCsv());
+	ASSERT_EQ(lines.size(), static_cast<size_t>(Stage::COUNT) + 1);
+	EXPECT_EQ(
+		lines[0],
+		std::vector<std::string>({
+			"stage", "calls", "items", "errors", "time_total", "time_p50", "time_p99", "time_max"
+		})
+	);
+	for (size_t i = 0; i < static_cast<size_t>(Stage::COUNT); i++) {
+		const auto& fields = lines[i + 1];
+		ASSERT_EQ(fields.size(), 8);
+		auto stage = static_cast<Stage>(i);
+		EXPECT_EQ(fields[0], toString(stage));
+		if (stage == Stage::TRANSFORM_GROUP) {
+			EXPECT_EQ(fields[1], "100");
+			EXPECT_EQ(fields[2], "200");
+			EXPECT_EQ(fields[3], "0");
+			EXPECT_NEAR(std::stod(fields[4]), 1.18e-03, 1e-09);
+			EXPECT_NEAR(std::stod(fields[5]), 1024e-09, 1e-12);
+			EXPECT_NEAR(std::stod(fields[6]), 10240e-09, 1e-12);
+			EXPECT_NEAR(std::stod(fields[7]), 1e-03, 1e-12);
+		} else {
+			EXPECT_EQ(fields[1], "0");
+		}
+	}
+}
+
+TEST(InstrumentationTest, scopedRecords) {
+	reset();
+	try {
+		PEOPLE_MSGS_UTILS_RECORD_SCOPE(Stage::PARSE_PEOPLE, 3);
+		throw std::runtime_error("malformed tags");
+	} catch (const std::runtime_error&) {
+		// the record has been finished while unwinding
+	}
+	{
+		PEOPLE_MSGS_UTILS_RECORD_SCOPE(Stage::PARSE_PEOPLE, 2);
+	}
+	auto stats = getStatistics(Stage::PARSE_PEOPLE);
+	EXPECT_EQ(stats.calls, 2);
+	EXPECT_EQ(stats.items, 5);
+	EXPECT_EQ(stats.errors, 1);
+
+	// a record stopped explicitly is neither recorded twice nor marked as failed by a later exception
+	try {
+		PEOPLE_MSGS_UTILS_RECORD_START(collection, Stage::COLLECT_GROUPS);
+		PEOPLE_MSGS_UTILS_RECORD_STOP(collection, 7);
+		throw std::runtime_error("after stop");
+	} catch (const std::runtime_error&) {
+	}
+	stats = getStatistics(Stage::COLLECT_GROUPS);
+	EXPECT_EQ(stats.calls, 1);
+	EXPECT_EQ(stats.items, 7);
+	EXPECT_EQ(stats.errors, 0);
+}
+
+TEST(InstrumentationTest, conversionPath) {
+	reset();
+	CrowdGenerator::Parameters params;
+	params.num_people = 20;
+	params.group_ratio = 0.5;
+	auto people = CrowdGenerator(params).generate();
+	auto result = createFromPeople(people);
+
+	auto stats = getStatistics(Stage::CREATE_FROM_PEOPLE);
+	EXPECT_EQ(stats.calls, 1);
+	EXPECT_EQ(stats.errors, 0);
+	EXPECT_GT(stats.time_total, 0.0);
+	EXPECT_EQ(getStatistics(Stage::PARSE_PEOPLE).items, people.size());
+	EXPECT_EQ(getStatistics(Stage::CREATE_GROUPS).calls, 1);
+	EXPECT_GE(getStatistics(Stage::SPATIAL_MODEL).calls, result.second.size());
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+void recordLatencies(Stage stage) {
+	for (unsigned int i = 0; i < 90; i++) {
+		record(stage, std::chrono::nanoseconds(1000), 2, false);
+	}
+	for (unsigned int i = 0; i < 9; i++) {
+		record(stage, std::chrono::nanoseconds(10000), 2, false);
+	}
+	record(stage, std::chrono::nanoseconds(1000000), 2, false);
+}
+
+std::vector<std::vector<std::string>> parseCsv(const std::string& csv) {
+	std::vector<std::vector<std::string>> lines;
+	std::istringstream stream(csv);
+	std::string line;
+	while (std::getline(stream, line)) {
+		lines.emplace_back();
+		std::istringstream line_stream(line);
+		std::string field;
+		while (std::getline(line_stream, field, ',')) {
+			lines.back().push_back(field);
+		}
+	}
+	return lines;
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/occupancy.h>
+#include <people_msgs_utils/utils.h>
+
+#include <cmath>
+
+using namespace people_msgs_utils;
+
+/// Creates an ellipse with the given center, semi-axes and orientation
+OSpaceEllipse createEllipse(double x, double y, double a, double b, double yaw);
+
+// Test cases
+TEST(OccupancyTest, sameAsPerCellCheck) {
+	Prediction prediction;
+	prediction.time_step = 0.5;
+	prediction.num_steps = 3;
+	prediction.num_people = 2;
+	prediction.num_groups = 1;
+	prediction.x = {1.03, -2.52, 1.53, -2.02, 2.03, -1.52};
+	prediction.y = {0.52, 1.27, 0.52, 1.27, 0.52, 1.27};
+	prediction.cov_xx = {0.0, 0.01, 0.0, 0.04, 0.0, 0.09};
+	prediction.cov_xy = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+	prediction.cov_yy = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+	for (size_t step = 0; step < prediction.num_steps; step++) {
+		prediction.group_ellipses.push_back(createEllipse(-0.2 + 0.3 * step, -1.9, 1.3, 0.6, 0.4 + 0.2 * step));
+	}
+
+	GridWindow grid;
+	grid.origin_x = -4.0;
+	grid.origin_y = -3.0;
+	grid.resolution = 0.1;
+	grid.size_x = 70;
+	grid.size_y = 50;
+
+	OccupancyRasterizer::Parameters params;
+	params.person_radius = 0.4;
+	params.inflation = 0.1;
+	params.uncertainty_scale = 2.0;
+	OccupancyRasterizer rasterizer(params, createThreadParallelFor(2));
+	SpaceTimeOccupancy dense;
+	rasterizer.rasterize(prediction, grid, dense);
+	SparseSpaceTimeOccupancy sparse;
+	rasterizer.rasterize(prediction, grid, sparse);
+	ASSERT_EQ(dense.cells.size(), grid.size_x * grid.size_y * prediction.num_steps);
+	ASSERT_EQ(sparse.slice_start.size(), prediction.num_steps + 1);
+
+	size_t occupied = 0;
+	for (size_t step = 0; step < prediction.num_steps; step++) {
+		const auto& e = prediction.group_ellipses[step];
+		for (size_t j = 0; j < grid.size_y; j++) {
+			for (size_t i = 0; i < grid.size_x; i++) {
+				double x = grid.origin_x + (i + 0.5) * grid.resolution;
+				double y = grid.origin_y + (j + 0.5) * grid.resolution;
+				bool expected = false;
+				for (size_t p = 0; p < prediction.num_people; p++) {
+					size_t index = prediction.index(step, p);
+					double radius = 0.5 + 2.0 * std::sqrt(prediction.cov_xx[index]);
+					expected |= std::hypot(x - prediction.x[index], y - prediction.y[index]) <= radius;
+				}
+				// semi-axes inflated
+				double dx = x - e.center_x;
+				double dy = y - e.center_y;
+				double u = (dx * e.cos_yaw + dy * e.sin_yaw) / 1.4;
+				double v = (-dx * e.sin_yaw + dy * e.cos_yaw) / 0.7;
+				expected |= u * u + v * v < 1.0;
+
+				EXPECT_EQ(dense.isOccupied(step, i, j), expected) << step << " " << i << " " << j;
+				EXPECT_EQ(sparse.isOccupied(step, i, j), expected) << step << " " << i << " " << j;
+				occupied += expected;
+			}
+		}
+	}
+	EXPECT_EQ(sparse.cells.size(), occupied);
+	EXPECT_GT(occupied, 0);
+
+	// groups disabled
+	params.use_groups = false;
+	OccupancyRasterizer(params).rasterize(prediction, grid, dense);
+	EXPECT_FALSE(dense.isOccupied(0, 38, 11));
+}
+
+TEST(OccupancyTest, costVolume) {
+	Prediction prediction;
+	prediction.time_step = 0.5;
+	prediction.num_steps = 2;
+	prediction.num_people = 1;
+	prediction.num_groups = 1;
+	prediction.x = {-1.0, -1.0};
+	prediction.y = {0.0, 0.0};
+	prediction.cov_xx = {0.0, 0.0};
+	prediction.cov_xy = {0.0, 0.0};
+	prediction.cov_yy = {0.0, 0.0};
+	prediction.group_ellipses = {createEllipse(1.5, 0.0, 1.0, 0.5, 0.0), createEllipse(1.5, 0.0, 1.0, 0.5, M_PI_2)};
+
+	GridWindow grid;
+	// cell centers at multiples of the resolution
+	grid.origin_x = -3.05;
+	grid.origin_y = -2.05;
+	grid.resolution = 0.1;
+	grid.size_x = 60;
+	grid.size_y = 40;
+
+	OccupancyRasterizer::Parameters params;
+	params.person_radius = 0.4;
+	params.cost_falloff = 0.2;
+	params.cost_cutoff = 2.9;
+	OccupancyRasterizer rasterizer(params, createThreadParallelFor(2));
+	SpaceTimeCost cost;
+	rasterizer.rasterize(prediction, grid, cost);
+	SpaceTimeOccupancy occupancy;
+	rasterizer.rasterize(prediction, grid, occupancy);
+	ASSERT_EQ(cost.cells.size(), occupancy.cells.size());
+
+	for (size_t step = 0; step < prediction.num_steps; step++) {
+		for (size_t j = 0; j < grid.size_y; j++) {
+			for (size_t i = 0; i < grid.size_x; i++) {
+				float value = cost.getCost(step, i, j);
+				EXPECT_GE(value, 0.0f);
+				EXPECT_LE(value, 1.0f);
+				// cost of footprints is maximal
+				if (occupancy.isOccupied(step, i, j)) {
+					EXPECT_FLOAT_EQ(value, 1.0f) << step << " " << i << " " << j;
+				}
+				// the person's disc decays with the distance from its boundary
+				double x = grid.origin_x + (i + 0.5) * grid.resolution;
+				double y = grid.origin_y + (j + 0.5) * grid.resolution;
+				double distance = std::hypot(x + 1.0, y) - 0.4;
+				if (x < 0.0 && distance > 0.0) {
+					double expected = distance <= 0.58 ? std::exp(-0.5 * distance * distance / 0.04) : 0.0;
+					EXPECT_NEAR(value, expected, 1e-6) << step << " " << i << " " << j;
+				}
+			}
+		}
+	}
+	// beyond the cutoff
+	EXPECT_EQ(cost.getCost(0, 0, 0), 0.0f);
+	// along the major axis of the group, 0.2 from its boundary, i.e., one standard deviation
+	EXPECT_NEAR(cost.getCost(0, 57, 20), std::exp(-0.5), 1e-6);
+	// along the minor axis of the group, rotated in the second step
+	EXPECT_NEAR(cost.getCost(0, 45, 27), std::exp(-0.5), 1e-6);
+	EXPECT_NEAR(cost.getCost(1, 52, 20), std::exp(-0.5), 1e-6);
+
+	// without the falloff, the cost volume matches the occupancy
+	params.cost_falloff = 0.0;
+	OccupancyRasterizer(params).rasterize(prediction, grid, cost);
+	size_t mismatches = 0;
+	for (size_t k = 0; k < cost.cells.size(); k++) {
+		mismatches += (cost.cells[k] > 0.5f) != (occupancy.cells[k] != 0);
+	}
+	EXPECT_EQ(mismatches, 0);
+}
+
+TEST(OccupancyTest, predictedFrame) {
+	CrowdGenerator::Parameters crowd;
+	crowd.num_people = 200;
+	crowd.group_ratio = 0.5;
+	auto frame = createFromPeople(CrowdGenerator(crowd).generate());
+
+	GridWindow grid;
+	grid.origin_x = -20.0;
+	grid.origin_y = -20.0;
+	grid.resolution = 0.2;
+	grid.size_x = 200;
+	grid.size_y = 200;
+	ConstantVelocityPredictor::Parameters horizon;
+	horizon.steps = 5;
+	horizon.time_step = 0.4;
+	ConstantVelocityPredictor predictor(horizon);
+
+	SpaceTimeOccupancy sequential;
+	OccupancyRasterizer().rasterize(frame.first, frame.second, predictor, grid, sequential);
+	SpaceTimeOccupancy parallel;
+	OccupancyRasterizer rasterizer(OccupancyRasterizer::Parameters(), createThreadParallelFor(4));
+	rasterizer.rasterize(frame.first, frame.second, predictor, grid, parallel);
+	EXPECT_EQ(parallel.num_steps, 5);
+	EXPECT_EQ(rasterizer.getPrediction().num_people, frame.first.size());
+	EXPECT_EQ(parallel.cells, sequential.cells);
+
+	SparseSpaceTimeOccupancy sparse;
+	rasterizer.rasterize(frame.first, frame.second, predictor, grid, sparse);
+	size_t occupied = 0;
+	for (auto cell: parallel.cells) {
+		occupied += cell;
+	}
+	EXPECT_EQ(sparse.cells.size(), occupied);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+OSpaceEllipse createEllipse(double x, double y, double a, double b, double yaw) {
+	OSpaceEllipse ellipse;
+	ellipse.center_x = x;
+	ellipse.center_y = y;
+	ellipse.cos_yaw = std::cos(yaw);
+	ellipse.sin_yaw = std::sin(yaw);
+	ellipse.inv_a = 1.0 / a;
+	ellipse.inv_b = 1.0 / b;
+	ellipse.min_x = x - a;
+	ellipse.max_x = x + a;
+	ellipse.min_y = y - a;
+	ellipse.max_y = y + a;
+	ellipse.valid = true;
+	return ellipse;
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/ospace.h>
+#include <people_msgs_utils/utils.h>
+
+#include <cmath>
+
+using namespace people_msgs_utils;
+
+// Test cases
+TEST(OSpaceTest, sameAsPerPointChecks) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 200;
+	params.group_ratio = 0.8;
+	params.area_size = 20.0;
+	Groups groups;
+	std::tie(std::ignore, groups) = createFromPeople(CrowdGenerator(params).generate());
+	ASSERT_FALSE(groups.empty());
+
+	OSpaceQuery query;
+	query.setGroups(groups);
+
+	// a trajectory-like set of points, longer than a single block
+	std::vector<double> xs;
+	std::vector<double> ys;
+	for (size_t k = 0; k < 1000; k++) {
+		xs.push_back(-10.0 + 0.02 * k);
+		ys.push_back(4.0 * std::sin(0.01 * k) + 0.5 * std::cos(0.13 * k));
+	}
+	std::vector<uint8_t> inside(xs.size());
+	query.contains(xs.data(), ys.data(), xs.size(), inside.data());
+	std::vector<double> distances(xs.size());
+	std::vector<size_t> nearest(xs.size());
+	query.getNormalizedDistances(xs.data(), ys.data(), xs.size(), distances.data(), nearest.data());
+
+	bool any_inside = false;
+	for (size_t k = 0; k < xs.size(); k++) {
+		bool inside_ref = false;
+		double distance_ref = std::numeric_limits<double>::infinity();
+		for (const auto& group: groups) {
+			auto ellipse = OSpaceEllipse::fromGroup(group);
+			inside_ref = inside_ref || ellipse.contains(xs[k], ys[k]);
+			if (ellipse.valid) {
+				distance_ref = std::min(distance_ref, std::sqrt(ellipse.getNormalizedDistanceSq(xs[k], ys[k])));
+			}
+		}
+		any_inside = any_inside || inside_ref;
+		EXPECT_EQ(inside.at(k) != 0, inside_ref);
+		EXPECT_DOUBLE_EQ(distances.at(k), distance_ref);
+		ASSERT_NE(nearest.at(k), OSpaceQuery::NONE);
+		EXPECT_DOUBLE_EQ(
+			std::sqrt(OSpaceEllipse::fromGroup(groups.at(nearest.at(k))).getNormalizedDistanceSq(xs[k], ys[k])),
+			distance_ref
+		);
+	}
+	EXPECT_EQ(query.containsAny(xs.data(), ys.data(), xs.size()), any_inside);
+
+	// with a bounded distance, distant points have no nearest group
+	query.getNormalizedDistances(xs.data(), ys.data(), xs.size(), distances.data(), nearest.data(), 1.5);
+	for (size_t k = 0; k < xs.size(); k++) {
+		if (nearest.at(k) == OSpaceQuery::NONE) {
+			EXPECT_TRUE(std::isinf(distances.at(k)));
+		} else {
+			EXPECT_LT(distances.at(k), 1.5);
+		}
+	}
+}
+
+TEST(OSpaceTest, canonicalEllipse) {
+	geometry_msgs::PoseWithCovariance pose;
+	geometry_msgs::PoseWithCovariance vel;
+	People members;
+	// members along the x axis, so the ellipse is elongated along it
+	for (double x: {-2.0, -1.0, 0.0, 1.0, 2.0}) {
+		pose.pose.position.x = x;
+		pose.pose.position.y = 0.1 * x * x;
+		members.emplace_back(std::to_string(x), pose, vel, 1.0, false, true, 1, 1, "g");
+	}
+	Group group("g", 1, members, {}, {}, geometry_msgs::Point());
+	auto ellipse = OSpaceEllipse::fromGroup(group);
+	ASSERT_TRUE(ellipse.valid);
+	EXPECT_TRUE(ellipse.contains(group.getPositionX(), group.getPositionY()));
+	EXPECT_NEAR(ellipse.getNormalizedDistanceSq(group.getPositionX(), group.getPositionY()), 0.0, 1e-12);
+	EXPECT_FALSE(ellipse.contains(ellipse.max_x + 0.01, group.getPositionY()));
+	EXPECT_FALSE(ellipse.contains(group.getPositionX(), ellipse.max_y + 0.01));
+
+	// point at the end of the major axis is on the boundary
+	double a = group.getSpanX() / 2.0;
+	double x = group.getPositionX() + a * std::cos(group.getOrientationYaw());
+	double y = group.getPositionY() + a * std::sin(group.getOrientationYaw());
+	EXPECT_NEAR(ellipse.getNormalizedDistanceSq(x, y), 1.0, 1e-9);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
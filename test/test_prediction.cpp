@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/prediction.h>
+#include <people_msgs_utils/utils.h>
+
+using namespace people_msgs_utils;
+
+// Test cases
+TEST(PredictionTest, sameAsScalarComputation) {
+	CrowdGenerator::Parameters crowd;
+	crowd.num_people = 300;
+	crowd.group_ratio = 0.5;
+	auto frame = createFromPeople(CrowdGenerator(crowd).generate());
+	const auto& people = frame.first;
+	const auto& groups = frame.second;
+	PeopleArrays arrays;
+	arrays.assign(people);
+
+	for (auto layout: {Prediction::Layout::TIME_MAJOR, Prediction::Layout::PERSON_MAJOR}) {
+		ConstantVelocityPredictor::Parameters params;
+		params.time_step = 0.25;
+		params.steps = 8;
+		params.layout = layout;
+		params.acceleration_noise = 0.3;
+		Prediction prediction;
+		ConstantVelocityPredictor(params).predict(arrays, groups, prediction);
+		ASSERT_EQ(prediction.x.size(), people.size() * params.steps);
+		ASSERT_EQ(prediction.group_ellipses.size(), groups.size() * params.steps);
+
+		for (size_t step = 0; step < params.steps; step++) {
+			double t = (step + 1) * params.time_step;
+			double noise = params.acceleration_noise * t * t * t / 3.0;
+			for (size_t i = 0; i < people.size(); i++) {
+				const auto& person = people[i];
+				size_t index = prediction.index(step, i);
+				EXPECT_DOUBLE_EQ(prediction.x.at(index), person.getPositionX() + person.getVelocityX() * t);
+				EXPECT_DOUBLE_EQ(prediction.y.at(index), person.getPositionY() + person.getVelocityY() * t);
+				EXPECT_DOUBLE_EQ(
+					prediction.cov_xx.at(index),
+					person.getCovariancePoseXX() + person.getCovarianceVelocityXX() * t * t + noise
+				);
+				EXPECT_DOUBLE_EQ(
+					prediction.cov_xy.at(index),
+					person.getCovariancePoseXY() + person.getCovarianceVelocityXY() * t * t
+				);
+				EXPECT_DOUBLE_EQ(
+					prediction.cov_yy.at(index),
+					person.getCovariancePoseYY() + person.getCovarianceVelocityYY() * t * t + noise
+				);
+			}
+
+			for (size_t g = 0; g < groups.size(); g++) {
+				const auto& members = groups[g].getMembers();
+				double vx = 0.0;
+				double vy = 0.0;
+				for (const auto& member: members) {
+					vx += member.getVelocityX() / members.size();
+					vy += member.getVelocityY() / members.size();
+				}
+				const auto& ellipse = prediction.group_ellipses.at(step * groups.size() + g);
+				EXPECT_NEAR(ellipse.center_x, groups[g].getPositionX() + vx * t, 1e-9);
+				EXPECT_NEAR(ellipse.center_y, groups[g].getPositionY() + vy * t, 1e-9);
+				EXPECT_EQ(ellipse.valid, OSpaceEllipse::fromGroup(groups[g]).valid);
+				if (ellipse.valid) {
+					EXPECT_TRUE(ellipse.contains(ellipse.center_x, ellipse.center_y));
+				}
+			}
+		}
+	}
+}
+
+TEST(PredictionTest, emptyFrame) {
+	Prediction prediction;
+	ConstantVelocityPredictor().predict(PeopleArrays(), prediction);
+	EXPECT_EQ(prediction.num_people, 0);
+	EXPECT_EQ(prediction.num_steps, 10);
+	EXPECT_TRUE(prediction.x.empty());
+	EXPECT_TRUE(prediction.group_ellipses.empty());
+	EXPECT_DOUBLE_EQ(prediction.getTime(0), 0.1);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
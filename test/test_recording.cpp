@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/recording.h>
+#include <people_msgs_utils/utils.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+using namespace people_msgs_utils;
+
+/// Returns a path of a file unique to the test process
+std::string createRecordingPath(const std::string& suffix);
+
+/// Returns the frame of the crowd at the given time, people walk with their velocities and some of them leave
+Frame createFrame(const Frame& crowd, size_t number);
+
+// Test cases
+TEST(RecordingTest, replay) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 200;
+	params.group_ratio = 0.5;
+	Frame crowd;
+	createFromPeople(CrowdGenerator(params).generate(), crowd);
+	crowd.header.frame_id = "map";
+	ASSERT_FALSE(crowd.groups.empty());
+
+	const size_t NUM_FRAMES = 50;
+	FrameRecorder::Parameters recorder_params;
+	recorder_params.keyframe_interval = 8;
+	auto path = createRecordingPath("replay");
+	{
+		FrameRecorder recorder(path, recorder_params);
+		for (size_t n = 0; n < NUM_FRAMES; n++) {
+			recorder.record(createFrame(crowd, n));
+		}
+		EXPECT_EQ(recorder.size(), NUM_FRAMES);
+		// incomplete until closed
+		EXPECT_THROW(FrameRecording recording(path), std::runtime_error);
+	}
+
+	FrameRecording recording(path);
+	ASSERT_EQ(recording.size(), NUM_FRAMES);
+	double tolerance = 0.5 * recorder_params.position_resolution + 1e-9;
+	Frame replayed;
+	for (size_t n: {0, 1, 7, 8, 30, 49, 3}) {
+		auto frame = createFrame(crowd, n);
+		auto view = recording.getFrame(n);
+		EXPECT_EQ(view.stamp, frame.header.stamp);
+		EXPECT_EQ(view.frame_id, "map");
+		ASSERT_EQ(view.num_people, frame.people.size());
+		// deltas w.r.t. keyframes fit in 16 bits
+		EXPECT_EQ(view.position_bytes, 2);
+		for (size_t i = 0; i < view.num_people; i++) {
+			const auto& person = frame.people[i];
+			EXPECT_EQ(view.getName(i), person.getName());
+			EXPECT_NEAR(view.getPositionX(i), person.getPositionX(), tolerance);
+			EXPECT_NEAR(view.getPositionY(i), person.getPositionY(), tolerance);
+			EXPECT_FLOAT_EQ(view.vx[i], person.getVelocityX());
+			EXPECT_FLOAT_EQ(view.cov_yy[i], person.getCovariancePoseYY());
+		}
+
+		recording.read(n, replayed);
+		EXPECT_EQ(replayed.header.stamp, frame.header.stamp);
+		EXPECT_EQ(replayed.header.frame_id, frame.header.frame_id);
+		ASSERT_EQ(replayed.people.size(), frame.people.size());
+		for (size_t i = 0; i < frame.people.size(); i++) {
+			const auto& person = frame.people[i];
+			const auto& replayed_person = replayed.people[i];
+			EXPECT_EQ(replayed_person.getName(), person.getName());
+			EXPECT_EQ(replayed_person.getGroupName(), person.getGroupName());
+			EXPECT_NEAR(replayed_person.getPositionX(), person.getPositionX(), tolerance);
+			EXPECT_NEAR(replayed_person.getOrientationYaw(), person.getOrientationYaw(), 1e-6);
+			EXPECT_FLOAT_EQ(replayed_person.getCovariancePoseXX(), person.getCovariancePoseXX());
+			EXPECT_FLOAT_EQ(replayed_person.getReliability(), person.getReliability());
+			EXPECT_EQ(replayed_person.isOccluded(), person.isOccluded());
+			EXPECT_EQ(replayed_person.getTrackAge(), person.getTrackAge());
+		}
+		ASSERT_EQ(replayed.groups.size(), frame.groups.size());
+		for (size_t g = 0; g < frame.groups.size(); g++) {
+			const auto& group = frame.groups[g];
+			const auto& replayed_group = replayed.groups[g];
+			EXPECT_EQ(replayed_group.getName(), group.getName());
+			EXPECT_EQ(replayed_group.getMemberIDs(), group.getMemberIDs());
+			EXPECT_EQ(replayed_group.getSocialRelations().size(), group.getSocialRelations().size());
+			// stored, not refitted
+			EXPECT_EQ(replayed_group.getEllipse().center_x, group.getEllipse().center_x);
+			EXPECT_EQ(replayed_group.getEllipse().span_y, group.getEllipse().span_y);
+			EXPECT_EQ(replayed_group.getCenterOfGravity().x, group.getCenterOfGravity().x);
+		}
+	}
+
+	// random access by time
+	EXPECT_EQ(recording.findFrame(ros::Time(0.0)), 0);
+	EXPECT_EQ(recording.findFrame(recording.getStamp(17)), 17);
+	EXPECT_EQ(recording.findFrame(recording.getStamp(17) + ros::Duration(0.01)), 18);
+	EXPECT_EQ(recording.findFrame(recording.getStamp(NUM_FRAMES - 1) + ros::Duration(1.0)), NUM_FRAMES);
+	EXPECT_THROW(recording.getFrame(NUM_FRAMES), std::out_of_range);
+	unlink(path.c_str());
+}
+
+TEST(RecordingTest, wideDeltas) {
+	auto path = createRecordingPath("wide");
+	FrameRecorder::Parameters params;
+	params.keyframe_interval = 2;
+	Frame crowd;
+	createFromPeople(CrowdGenerator(CrowdGenerator::Parameters()).generate(), crowd);
+	crowd.groups.clear();
+	{
+		FrameRecorder recorder(path, params);
+		recorder.record(crowd);
+		// jumps that do not fit in 16 or 32 bits
+		for (double offset: {100.0, 1e7}) {
+			auto& person = crowd.people.front();
+			person.setPlanarState(
+				person.getPositionX() + offset,
+				person.getPositionY(),
+				person.getOrientationYaw(),
+				person.getVelocityX(),
+				person.getVelocityY()
+			);
+			recorder.record(crowd);
+		}
+		crowd.people.back().setPlanarState(std::numeric_limits<double>::quiet_NaN(), 0.0, 0.0, 0.0, 0.0);
+		EXPECT_THROW(recorder.record(crowd), std::invalid_argument);
+		// finite, but beyond the range of quantized positions
+		crowd.people.back().setPlanarState(1e300, 0.0, 0.0, 0.0, 0.0);
+		EXPECT_THROW(recorder.record(crowd), std::invalid_argument);
+		crowd.people.back().setPlanarState(1e14, 0.0, 0.0, 0.0, 0.0);
+		EXPECT_THROW(recorder.record(crowd), std::invalid_argument);
+		recorder.close();
+	}
+	FrameRecording recording(path);
+	ASSERT_EQ(recording.size(), 3);
+	EXPECT_EQ(recording.getFrame(1).position_bytes, 4);
+	EXPECT_EQ(recording.getFrame(2).position_bytes, 8);
+	auto view = recording.getFrame(2);
+	EXPECT_NEAR(view.getPositionX(0), crowd.people.front().getPositionX(), 1e-3);
+	std::vector<double> x;
+	std::vector<double> y;
+	view.decodePositions(x, y);
+	ASSERT_EQ(x.size(), crowd.people.size());
+	EXPECT_EQ(x[1], view.getPositionX(1));
+	EXPECT_EQ(y[1], view.getPositionY(1));
+
+	EXPECT_THROW(FrameRecording(createRecordingPath("missing")), std::runtime_error);
+	unlink(path.c_str());
+}
+
+TEST(RecordingTest, corrupt) {
+	auto path = createRecordingPath("corrupt");
+	FrameRecorder::Parameters params;
+	params.keyframe_interval = 2;
+	Frame crowd;
+	createFromPeople(CrowdGenerator(CrowdGenerator::Parameters()).generate(), crowd);
+	{
+		FrameRecorder recorder(path, params);
+		for (size_t n = 0; n < 3; n++) {
+			recorder.record(createFrame(crowd, n));
+		}
+	}
+	std::string contents;
+	{
+		std::ifstream file(path, std::ios::binary);
+		contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+	ASSERT_NO_THROW(FrameRecording recording(path));
+	auto write_file = [&path](const std::string& data) {
+		std::ofstream(path, std::ios::binary | std::ios::trunc).write(data.data(), data.size());
+	};
+
+	// the index (and the string table) at the end of the file is cut off
+	for (size_t size: {size_t(0), size_t(16), contents.size() / 2, contents.size() - 1}) {
+		write_file(contents.substr(0, size));
+		EXPECT_THROW(FrameRecording recording(path), std::runtime_error) << size;
+	}
+
+	// the first record, starting right after the 56-byte header of the file, is overwritten, so its counts point
+	// beyond the file; the next frame is delta-encoded w.r.t. it
+	std::string corrupt = contents;
+	std::fill(corrupt.begin() + 56, corrupt.begin() + 56 + 64, '\xff');
+	write_file(corrupt);
+	{
+		FrameRecording recording(path);
+		ASSERT_EQ(recording.size(), 3);
+		Frame frame;
+		EXPECT_THROW(recording.getFrame(0), std::runtime_error);
+		EXPECT_THROW(recording.read(1, frame), std::runtime_error);
+		EXPECT_NO_THROW(recording.read(2, frame));
+		EXPECT_EQ(frame.header.seq, 2);
+	}
+	unlink(path.c_str());
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+std::string createRecordingPath(const std::string& suffix) {
+	return testing::TempDir() + "people_msgs_utils_test_" + std::to_string(getpid()) + "_" + suffix + ".rec";
+}
+
+Frame createFrame(const Frame& crowd, size_t number) {
+	Frame frame = crowd;
+	frame.header.stamp = ros::Time(100.0 + 0.1 * number);
+	frame.header.seq = number;
+	// people without groups leave one by one, so later frames do not match their keyframes exactly
+	size_t left = 0;
+	for (auto it = frame.people.begin(); it != frame.people.end();) {
+		if (it->getGroupName().empty() && left < number) {
+			it = frame.people.erase(it);
+			left++;
+			continue;
+		}
+		it->setPlanarState(
+			it->getPositionX() + 0.1 * number * it->getVelocityX(),
+			it->getPositionY() + 0.1 * number * it->getVelocityY(),
+			it->getOrientationYaw(),
+			it->getVelocityX(),
+			it->getVelocityY()
+		);
+		++it;
+	}
+	return frame;
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/robot_metrics.h>
+#include <people_msgs_utils/utils.h>
+
+#include <cmath>
+
+using namespace people_msgs_utils;
+
+// Test cases
+TEST(RobotMetricsTest, headOnApproach) {
+	PeopleArrays people;
+	people.x = {5.0, 5.0, -3.0, 0.5};
+	people.y = {0.0, 2.0, 0.0, 0.0};
+	people.vx = {-1.0, -1.0, -1.0, 0.0};
+	people.vy = {0.0, 0.0, 0.0, 0.0};
+
+	RobotState robot;
+	robot.yaw = M_PI / 2.0;
+	robot.vx = 1.0;
+
+	RobotRelativeMetrics metrics;
+	computeRobotRelativeMetrics(robot, people, 1.0, metrics);
+	ASSERT_EQ(metrics.size(), 4);
+
+	// approaching head-on with the relative speed of 2 m/s
+	EXPECT_DOUBLE_EQ(metrics.distance.at(0), 5.0);
+	EXPECT_DOUBLE_EQ(metrics.relative_vx.at(0), -2.0);
+	EXPECT_NEAR(metrics.bearing.at(0), -M_PI / 2.0, 1e-12);
+	EXPECT_NEAR(metrics.closest_approach_time.at(0), 2.5, 1e-12);
+	EXPECT_NEAR(metrics.closest_approach_distance.at(0), 0.0, 1e-12);
+	EXPECT_NEAR(metrics.time_to_collision.at(0), 2.0, 1e-12);
+
+	// passing by in a distance that is larger than the collision distance
+	EXPECT_NEAR(metrics.closest_approach_distance.at(1), 2.0, 1e-12);
+	EXPECT_TRUE(std::isinf(metrics.time_to_collision.at(1)));
+
+	// moving apart
+	EXPECT_DOUBLE_EQ(metrics.closest_approach_time.at(2), 0.0);
+	EXPECT_DOUBLE_EQ(metrics.closest_approach_distance.at(2), 3.0);
+	EXPECT_TRUE(std::isinf(metrics.time_to_collision.at(2)));
+
+	// already colliding
+	EXPECT_DOUBLE_EQ(metrics.time_to_collision.at(3), 0.0);
+
+	std::vector<size_t> critical;
+	selectMostCritical(metrics, 2, CriticalityCriterion::TIME_TO_COLLISION, critical);
+	EXPECT_EQ(critical, (std::vector<size_t>{3, 0}));
+	selectMostCritical(metrics, 10, CriticalityCriterion::DISTANCE, critical);
+	EXPECT_EQ(critical, (std::vector<size_t>{3, 2, 0, 1}));
+}
+
+TEST(RobotMetricsTest, sameAsScalarComputation) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 700;
+	People people;
+	std::tie(people, std::ignore) = createFromPeople(CrowdGenerator(params).generate());
+	PeopleArrays arrays;
+	arrays.assign(people);
+	ASSERT_EQ(arrays.size(), people.size());
+
+	RobotState robot;
+	robot.x = 1.0;
+	robot.y = -2.0;
+	robot.yaw = 0.3;
+	robot.vx = 0.4;
+	robot.vy = 0.2;
+	RobotRelativeMetrics metrics;
+	computeRobotRelativeMetrics(robot, arrays, 0.8, metrics);
+
+	for (size_t i = 0; i < people.size(); i++) {
+		double px = people[i].getPositionX() - robot.x;
+		double py = people[i].getPositionY() - robot.y;
+		double vx = people[i].getVelocityX() - robot.vx;
+		double vy = people[i].getVelocityY() - robot.vy;
+		EXPECT_DOUBLE_EQ(metrics.distance.at(i), std::hypot(px, py));
+		double bearing = std::remainder(std::atan2(py, px) - robot.yaw, 2.0 * M_PI);
+		EXPECT_NEAR(metrics.bearing.at(i), bearing, 1e-12);
+
+		// closest approach found by sampling
+		double t_ca = std::max(0.0, -(px * vx + py * vy) / (vx * vx + vy * vy));
+		EXPECT_NEAR(metrics.closest_approach_time.at(i), t_ca, 1e-9);
+		double d_ca = std::hypot(px + vx * t_ca, py + vy * t_ca);
+		EXPECT_NEAR(metrics.closest_approach_distance.at(i), d_ca, 1e-9);
+		if (std::isfinite(metrics.time_to_collision.at(i))) {
+			double t = metrics.time_to_collision.at(i);
+			EXPECT_NEAR(std::hypot(px + vx * t, py + vy * t), std::min(0.8, std::hypot(px, py)), 1e-6);
+		} else {
+			EXPECT_GT(d_ca, 0.8);
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
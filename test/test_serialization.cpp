@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/serialization.h>
+#include <people_msgs_utils/utils.h>
+
+#include <ros/serialization.h>
+
+using namespace people_msgs_utils;
+
+people_msgs::People createFixture();
+
+// Test cases
+TEST(SerializationTest, decodeView) {
+	people_msgs::People msg = createFixture();
+	ros::SerializedMessage serialized = ros::serialization::serializeMessage(msg);
+
+	PeopleView view;
+	size_t prefix_length = static_cast<size_t>(serialized.message_start - serialized.buf.get());
+	ASSERT_TRUE(decodePeople(serialized.message_start, serialized.num_bytes - prefix_length, view));
+
+	EXPECT_EQ(view.seq, 42);
+	EXPECT_EQ(view.stamp.sec, 1234);
+	EXPECT_EQ(view.stamp.nsec, 5678);
+	EXPECT_EQ(view.frame_id, "map");
+	ASSERT_EQ(view.people.size(), 3);
+	EXPECT_EQ(view.people.at(1).name, "1");
+	EXPECT_DOUBLE_EQ(view.people.at(1).position.x, 1.5);
+	EXPECT_DOUBLE_EQ(view.people.at(1).velocity.y, -0.2);
+	EXPECT_DOUBLE_EQ(view.people.at(1).reliability, 0.8);
+	ASSERT_EQ(view.people.at(1).tagnames.size(), 5);
+	ASSERT_EQ(view.people.at(1).tags.size(), 5);
+	EXPECT_EQ(view.people.at(1).tagnames.at(1), "group_id");
+	EXPECT_EQ(view.people.at(1).tags.at(1), "7");
+}
+
+TEST(SerializationTest, sameAsDeserialized) {
+	people_msgs::People msg = createFixture();
+	ros::SerializedMessage serialized = ros::serialization::serializeMessage(msg);
+
+	std::vector<Person> people_ref;
+	std::vector<Group> groups_ref;
+	std::tie(people_ref, groups_ref) = createFromPeople(msg.people);
+
+	std::vector<Person> people;
+	std::vector<Group> groups;
+	std::tie(people, groups) = createFromSerializedPeople(serialized);
+
+	ASSERT_EQ(people.size(), people_ref.size());
+	for (size_t i = 0; i < people.size(); i++) {
+		EXPECT_EQ(people.at(i).getName(), people_ref.at(i).getName());
+		EXPECT_DOUBLE_EQ(people.at(i).getPositionX(), people_ref.at(i).getPositionX());
+		EXPECT_DOUBLE_EQ(people.at(i).getPositionY(), people_ref.at(i).getPositionY());
+		EXPECT_DOUBLE_EQ(people.at(i).getOrientationYaw(), people_ref.at(i).getOrientationYaw());
+		EXPECT_DOUBLE_EQ(people.at(i).getVelocityX(), people_ref.at(i).getVelocityX());
+		EXPECT_DOUBLE_EQ(people.at(i).getReliability(), people_ref.at(i).getReliability());
+		EXPECT_EQ(people.at(i).getTrackAge(), people_ref.at(i).getTrackAge());
+		EXPECT_EQ(people.at(i).getGroupName(), people_ref.at(i).getGroupName());
+	}
+
+	ASSERT_EQ(groups.size(), 1);
+	ASSERT_EQ(groups.size(), groups_ref.size());
+	EXPECT_EQ(groups.at(0).getName(), groups_ref.at(0).getName());
+	EXPECT_EQ(groups.at(0).getAge(), groups_ref.at(0).getAge());
+	EXPECT_EQ(groups.at(0).getMemberIDs(), groups_ref.at(0).getMemberIDs());
+	EXPECT_EQ(groups.at(0).getSocialRelations(), groups_ref.at(0).getSocialRelations());
+	EXPECT_DOUBLE_EQ(groups.at(0).getSpanX(), groups_ref.at(0).getSpanX());
+}
+
+TEST(SerializationTest, truncatedBuffer) {
+	people_msgs::People msg = createFixture();
+	ros::SerializedMessage serialized = ros::serialization::serializeMessage(msg);
+	size_t prefix_length = static_cast<size_t>(serialized.message_start - serialized.buf.get());
+	size_t length = serialized.num_bytes - prefix_length;
+
+	PeopleView view;
+	for (size_t len = 0; len < length; len++) {
+		ASSERT_FALSE(decodePeople(serialized.message_start, len, view));
+	}
+	std::vector<Person> people;
+	std::tie(people, std::ignore) = createFromSerializedPeople(serialized.message_start, length / 2);
+	EXPECT_TRUE(people.empty());
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+people_msgs::People createFixture() {
+	people_msgs::People msg;
+	msg.header.seq = 42;
+	msg.header.stamp.sec = 1234;
+	msg.header.stamp.nsec = 5678;
+	msg.header.frame_id = "map";
+
+	people_msgs::Person person;
+	person.name = "0";
+	person.position.x = 1.0;
+	person.position.y = 2.0;
+	person.velocity.x = 0.3;
+	person.velocity.y = 0.1;
+	person.reliability = 0.9;
+	person.tagnames = {"orientation", "group_id", "group_age", "group_track_ids", "social_relations"};
+	person.tags = {"0.0 0.0 0.247404 0.9689124", "7", "31", "0 1", "0 1 0.75"};
+	msg.people.push_back(person);
+
+	person.name = "1";
+	person.position.x = 1.5;
+	person.position.y = 2.5;
+	person.velocity.x = 0.3;
+	person.velocity.y = -0.2;
+	person.reliability = 0.8;
+	person.tags = {"0.0 0.0 0.0 1.0", "7", "31", "1 0", "1 0 0.75"};
+	msg.people.push_back(person);
+
+	person.name = "2";
+	person.position.x = -4.0;
+	person.position.y = 0.5;
+	person.velocity.x = 0.0;
+	person.velocity.y = 0.0;
+	person.reliability = 0.7;
+	person.tagnames = {"track_age", "occluded"};
+	person.tags = {"15", "true"};
+	msg.people.push_back(person);
+	return msg;
+}
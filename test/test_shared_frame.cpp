@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/shared_frame.h>
+#include <people_msgs_utils/utils.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+using namespace people_msgs_utils;
+
+/// Returns a name of a shared-memory object unique to the test process
+std::string createSegmentName(const std::string& suffix);
+
+/// Checks that the frame is consistent with the frame published as number @ref number in the test of processes
+bool isPublishedFrame(const SharedFrameView& view, uint64_t number);
+
+// Test cases
+TEST(SharedFrameTest, contents) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 300;
+	params.group_ratio = 0.5;
+	Frame frame;
+	createFromPeople(CrowdGenerator(params).generate(), frame);
+	frame.header.frame_id = "map";
+	frame.header.stamp = ros::Time(12.5);
+	ASSERT_FALSE(frame.groups.empty());
+
+	auto name = createSegmentName("contents");
+	SharedFrameWriter writer(name);
+	SharedFrameReader reader(name);
+	SharedFrameView view;
+	EXPECT_FALSE(reader.getLatest(view));
+	EXPECT_FALSE(view.isValid());
+	EXPECT_EQ(reader.getLatestNumber(), 0);
+
+	ASSERT_TRUE(writer.publish(frame));
+	ASSERT_TRUE(reader.getLatest(view));
+	EXPECT_EQ(view.number, 1);
+	EXPECT_EQ(view.stamp, frame.header.stamp);
+	EXPECT_EQ(view.frame_id, "map");
+	ASSERT_EQ(view.num_people, frame.people.size());
+	ASSERT_EQ(view.num_groups, frame.groups.size());
+	for (size_t i = 0; i < view.num_people; i++) {
+		const auto& person = frame.people[i];
+		EXPECT_EQ(view.getName(i), person.getName());
+		EXPECT_EQ(view.x[i], person.getPositionX());
+		EXPECT_EQ(view.y[i], person.getPositionY());
+		EXPECT_EQ(view.yaw[i], person.getOrientationYaw());
+		EXPECT_EQ(view.vx[i], person.getVelocityX());
+		EXPECT_EQ(view.vy[i], person.getVelocityY());
+		EXPECT_EQ(view.cov_xy[i], person.getCovariancePoseXY());
+		EXPECT_EQ(view.reliability[i], person.getReliability());
+		if (view.group[i] == SharedFrameView::NO_GROUP) {
+			EXPECT_TRUE(person.getGroupName().empty());
+		} else {
+			EXPECT_EQ(view.getGroupName(view.group[i]), person.getGroupName());
+		}
+	}
+	for (size_t g = 0; g < view.num_groups; g++) {
+		const auto& group = frame.groups[g];
+		EXPECT_EQ(view.getGroupName(g), group.getName());
+		EXPECT_EQ(view.group_x[g], group.getEllipse().center_x);
+		EXPECT_EQ(view.group_span_y[g], group.getEllipse().span_y);
+		ASSERT_EQ(view.group_member_start[g + 1] - view.group_member_start[g], group.getMembers().size());
+		for (size_t k = view.group_member_start[g]; k < view.group_member_start[g + 1]; k++) {
+			EXPECT_EQ(view.group[view.group_members[k]], g);
+		}
+	}
+	EXPECT_TRUE(view.isValid());
+
+	// the frame is overwritten once the ring is lapped
+	for (size_t i = 0; i < SharedFrameWriter::Parameters().slots - 1; i++) {
+		ASSERT_TRUE(writer.publish(frame));
+		EXPECT_TRUE(view.isValid());
+	}
+	ASSERT_TRUE(writer.publish(frame));
+	EXPECT_FALSE(view.isValid());
+	EXPECT_EQ(reader.getLatestNumber(), SharedFrameWriter::Parameters().slots + 1);
+}
+
+TEST(SharedFrameTest, capacities) {
+	SharedFrameWriter::Parameters params;
+	params.slots = 2;
+	params.max_people = 2;
+	params.max_groups = 1;
+	params.max_string_bytes = 16;
+	auto name = createSegmentName("capacities");
+	SharedFrameWriter writer(name, params);
+
+	Frame frame;
+	createFromPeople(CrowdGenerator(CrowdGenerator::Parameters()).generate(), frame);
+	EXPECT_FALSE(writer.publish(frame));
+	frame.people.erase(frame.people.begin() + 2, frame.people.end());
+	frame.groups.clear();
+	frame.people[0].setName("abcdefgh");
+	frame.people[1].setName("abcdefghi");
+	EXPECT_FALSE(writer.publish(frame));
+	frame.people[1].setName("abcdefg");
+	EXPECT_TRUE(writer.publish(frame));
+	EXPECT_EQ(writer.getPublishedCount(), 1);
+
+	EXPECT_THROW(SharedFrameReader(createSegmentName("missing")), std::runtime_error);
+	params.slots = 0;
+	EXPECT_THROW(SharedFrameWriter(createSegmentName("invalid"), params), std::invalid_argument);
+}
+
+TEST(SharedFrameTest, processes) {
+	// the reader verifies each frame it gets, while the writer keeps lapping the ring
+	const uint64_t NUM_FRAMES = 2000;
+	CrowdGenerator::Parameters params;
+	params.num_people = 200;
+	Frame frame;
+	createFromPeople(CrowdGenerator(params).generate(), frame);
+	frame.groups.clear();
+
+	SharedFrameWriter::Parameters shm_params;
+	shm_params.slots = 2;
+	auto name = createSegmentName("processes");
+	SharedFrameWriter writer(name, shm_params);
+
+	// the consumer reports that it is attached before frames are produced and how many distinct frames it got
+	int ready[2];
+	int result[2];
+	ASSERT_EQ(pipe(ready), 0);
+	ASSERT_EQ(pipe(result), 0);
+	pid_t pid = fork();
+	ASSERT_NE(pid, -1);
+	if (pid == 0) {
+		// consumer
+		close(ready[0]);
+		close(result[0]);
+		int status = 0;
+		uint64_t distinct = 0;
+		try {
+			SharedFrameReader reader(name);
+			SharedFrameView view;
+			char byte = 1;
+			if (write(ready[1], &byte, 1) != 1) {
+				_exit(5);
+			}
+			uint64_t last = 0;
+			auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(60);
+			while (last < NUM_FRAMES && std::chrono::steady_clock::now() < deadline) {
+				if (!reader.getLatest(view) || view.number == last) {
+					std::this_thread::yield();
+					continue;
+				}
+				bool consistent = isPublishedFrame(view, view.number);
+				// torn frames must be detected
+				if (view.isValid() && !consistent) {
+					status = 1;
+					break;
+				}
+				if (view.number < last) {
+					status = 2;
+					break;
+				}
+				last = view.number;
+				distinct++;
+			}
+			if (status == 0 && last != NUM_FRAMES) {
+				status = 3;
+			}
+		} catch (const std::exception&) {
+			status = 4;
+		}
+		if (write(result[1], &distinct, sizeof(distinct)) != sizeof(distinct) && status == 0) {
+			status = 5;
+		}
+		_exit(status);
+	}
+	close(ready[1]);
+	close(result[1]);
+
+	// producer, started once the consumer is attached (the pipe is closed without a byte if attaching failed)
+	char byte = 0;
+	bool attached = read(ready[0], &byte, 1) == 1;
+	EXPECT_TRUE(attached);
+	for (uint64_t number = 1; attached && number <= NUM_FRAMES; number++) {
+		for (size_t i = 0; i < frame.people.size(); i++) {
+			frame.people[i].setPlanarState(number, i, 0.0, number * 0.5, i * 0.5);
+		}
+		frame.header.seq = number;
+		EXPECT_TRUE(writer.publish(frame));
+	}
+	int status = 0;
+	ASSERT_EQ(waitpid(pid, &status, 0), pid);
+	ASSERT_TRUE(WIFEXITED(status));
+	EXPECT_EQ(WEXITSTATUS(status), 0);
+	uint64_t distinct = 0;
+	ASSERT_EQ(read(result[0], &distinct, sizeof(distinct)), sizeof(distinct));
+	// frames were read while being produced, not only the last one
+	EXPECT_GT(distinct, 1);
+	close(ready[0]);
+	close(result[0]);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+std::string createSegmentName(const std::string& suffix) {
+	return "/people_msgs_utils_test_" + std::to_string(getpid()) + "_" + suffix;
+}
+
+bool isPublishedFrame(const SharedFrameView& view, uint64_t number) {
+	if (view.seq != number) {
+		return false;
+	}
+	for (size_t i = 0; i < view.num_people; i++) {
+		bool valid = view.x[i] == number
+			&& view.y[i] == i
+			&& view.vx[i] == number * 0.5
+			&& view.vy[i] == i * 0.5;
+		if (!valid) {
+			return false;
+		}
+	}
+	return true;
+}
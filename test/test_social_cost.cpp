@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/social_cost.h>
+#include <people_msgs_utils/utils.h>
+
+#include <cmath>
+
+using namespace people_msgs_utils;
+
+/// Straightforward evaluation of a single Gaussian
+double gaussian(double dx, double dy, double amplitude, double sxx, double sxy, double syy, double cutoff);
+
+// Test cases
+TEST(SocialCostTest, gridSameAsScalarLoop) {
+	CrowdGenerator::Parameters crowd_params;
+	crowd_params.num_people = 40;
+	crowd_params.area_size = 10.0;
+	crowd_params.group_ratio = 0.5;
+	auto frame = createFromPeople(CrowdGenerator(crowd_params).generate());
+	const auto& people = frame.first;
+	const auto& groups = frame.second;
+
+	for (auto reduction: {SocialCostModel::Reduction::SUM, SocialCostModel::Reduction::MAX}) {
+		SocialCostModel::Parameters params;
+		params.person_sigma = 0.4;
+		params.group_amplitude = 2.0;
+		params.cutoff = 2.5;
+		params.reduction = reduction;
+		SocialCostModel model(params);
+		model.setFrame(people, groups);
+
+		GridWindow grid;
+		grid.origin_x = -6.0;
+		grid.origin_y = -5.5;
+		grid.resolution = 0.1;
+		grid.size_x = 117;
+		grid.size_y = 103;
+		std::vector<double> costs;
+		model.evaluateGrid(grid, costs);
+		ASSERT_EQ(costs.size(), grid.size_x * grid.size_y);
+
+		std::vector<double> xs;
+		std::vector<double> ys;
+		for (size_t j = 0; j < grid.size_y; j++) {
+			for (size_t i = 0; i < grid.size_x; i++) {
+				double x = grid.origin_x + (i + 0.5) * grid.resolution;
+				double y = grid.origin_y + (j + 0.5) * grid.resolution;
+				xs.push_back(x);
+				ys.push_back(y);
+
+				double cost = 0.0;
+				auto combine = [&](double value) {
+					cost = reduction == SocialCostModel::Reduction::SUM ? cost + value : std::max(cost, value);
+				};
+				for (const auto& person: people) {
+					double var = params.person_sigma * params.person_sigma;
+					combine(gaussian(x - person.getPositionX(), y - person.getPositionY(), 1.0, var, 0.0, var, 2.5));
+				}
+				for (const auto& group: groups) {
+					double yaw = group.getOrientationYaw();
+					double var_a = std::pow(group.getSpanX() / 2.0, 2);
+					double var_b = std::pow(group.getSpanY() / 2.0, 2);
+					if (var_a <= 0.0 || var_b <= 0.0) {
+						continue;
+					}
+					double sxx = var_a * std::pow(std::cos(yaw), 2) + var_b * std::pow(std::sin(yaw), 2);
+					double sxy = (var_a - var_b) * std::cos(yaw) * std::sin(yaw);
+					double syy = var_a * std::pow(std::sin(yaw), 2) + var_b * std::pow(std::cos(yaw), 2);
+					combine(gaussian(x - group.getPositionX(), y - group.getPositionY(), 2.0, sxx, sxy, syy, 2.5));
+				}
+				EXPECT_NEAR(costs.at(j * grid.size_x + i), cost, 1e-9);
+			}
+		}
+
+		// scattered points give the same results
+		std::vector<double> costs_points(xs.size());
+		model.evaluatePoints(xs.data(), ys.data(), xs.size(), costs_points.data());
+		for (size_t k = 0; k < costs.size(); k++) {
+			EXPECT_NEAR(costs_points.at(k), costs.at(k), 1e-12);
+		}
+	}
+}
+
+TEST(SocialCostTest, cutoff) {
+	geometry_msgs::PoseWithCovariance pose;
+	geometry_msgs::PoseWithCovariance vel;
+	People people;
+	people.emplace_back("0", pose, vel, 1.0, false, true, 1, 1, "");
+
+	SocialCostModel::Parameters params;
+	params.person_sigma = 1.0;
+	params.cutoff = 2.0;
+	SocialCostModel model(params);
+	model.setFrame(people);
+	EXPECT_DOUBLE_EQ(model.evaluate(0.0, 0.0), 1.0);
+	EXPECT_NEAR(model.evaluate(1.0, 0.0), std::exp(-0.5), 1e-14);
+	EXPECT_NEAR(model.evaluate(0.0, 1.99), std::exp(-0.5 * 1.99 * 1.99), 1e-14);
+	EXPECT_EQ(model.evaluate(0.0, 2.01), 0.0);
+	EXPECT_EQ(model.evaluate(-1e6, 3e6), 0.0);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+double gaussian(double dx, double dy, double amplitude, double sxx, double sxy, double syy, double cutoff) {
+	double det = sxx * syy - sxy * sxy;
+	double mahalanobis_sq = (syy * dx * dx - 2.0 * sxy * dx * dy + sxx * dy * dy) / det;
+	if (mahalanobis_sq > cutoff * cutoff) {
+		return 0.0;
+	}
+	return amplitude * std::exp(-0.5 * mahalanobis_sq);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/crowd_generator.h>
+#include <people_msgs_utils/spatial_index.h>
+#include <people_msgs_utils/utils.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace people_msgs_utils;
+
+// Test cases
+TEST(SpatialIndexTest, sameAsLinearScan) {
+	CrowdGenerator::Parameters params;
+	params.num_people = 300;
+	params.group_ratio = 0.5;
+	auto frame = createFromPeople(CrowdGenerator(params).generate());
+	const auto& people = frame.first;
+	const auto& groups = frame.second;
+
+	SpatialIndex index(2.0);
+	index.build(people, groups);
+	ASSERT_EQ(index.getPeopleCount(), people.size());
+	ASSERT_EQ(index.getGroupsCount(), groups.size());
+
+	for (double x = -25.0; x <= 25.0; x += 2.7) {
+		for (double y = -25.0; y <= 25.0; y += 3.1) {
+			// radius
+			auto within = index.queryRadius(x, y, 3.0);
+			std::sort(within.begin(), within.end());
+			std::vector<size_t> within_ref;
+			for (size_t i = 0; i < people.size(); i++) {
+				if (std::hypot(people[i].getPositionX() - x, people[i].getPositionY() - y) <= 3.0) {
+					within_ref.push_back(i);
+				}
+			}
+			EXPECT_EQ(within, within_ref);
+
+			// nearest
+			std::vector<size_t> nearest_ref(people.size());
+			for (size_t i = 0; i < people.size(); i++) {
+				nearest_ref[i] = i;
+			}
+			auto distance = [&](size_t i) {
+				double dx = people[i].getPositionX() - x;
+				double dy = people[i].getPositionY() - y;
+				return std::make_pair(dx * dx + dy * dy, i);
+			};
+			std::sort(
+				nearest_ref.begin(),
+				nearest_ref.end(),
+				[&](size_t lhs, size_t rhs) {
+					return distance(lhs) < distance(rhs);
+				}
+			);
+			nearest_ref.resize(5);
+			EXPECT_EQ(index.queryNearest(x, y, 5), nearest_ref);
+
+			// groups
+			std::vector<size_t> containing_ref;
+			for (size_t i = 0; i < groups.size(); i++) {
+				const auto& group = groups[i];
+				double dx = x - group.getPositionX();
+				double dy = y - group.getPositionY();
+				double yaw = group.getOrientationYaw();
+				double u = (dx * std::cos(yaw) + dy * std::sin(yaw)) / (group.getSpanX() / 2.0);
+				double v = (-dx * std::sin(yaw) + dy * std::cos(yaw)) / (group.getSpanY() / 2.0);
+				if (group.getSpanX() > 0.0 && group.getSpanY() > 0.0 && u * u + v * v < 1.0) {
+					containing_ref.push_back(i);
+				}
+			}
+			auto containing = index.queryGroupsContaining(x, y);
+			std::sort(containing.begin(), containing.end());
+			EXPECT_EQ(containing, containing_ref);
+		}
+	}
+}
+
+TEST(SpatialIndexTest, outliersAndEmpty) {
+	SpatialIndex index;
+	index.build(People());
+	EXPECT_TRUE(index.queryRadius(0.0, 0.0, 10.0).empty());
+	EXPECT_TRUE(index.queryNearest(0.0, 0.0, 3).empty());
+	EXPECT_TRUE(index.queryGroupsContaining(0.0, 0.0).empty());
+
+	// a distant person must not blow up the grid
+	geometry_msgs::PoseWithCovariance pose;
+	geometry_msgs::PoseWithCovariance vel;
+	People people;
+	pose.pose.position.x = 1.0;
+	people.emplace_back("near", pose, vel, 1.0, false, true, 1, 1, "");
+	pose.pose.position.x = 1e9;
+	people.emplace_back("far", pose, vel, 1.0, false, true, 2, 1, "");
+	index.build(people);
+
+	EXPECT_EQ(index.queryRadius(0.0, 0.0, 2.0), std::vector<size_t>{0});
+	EXPECT_EQ(index.queryNearest(1e9, 5.0, 1), std::vector<size_t>{1});
+	EXPECT_EQ(index.queryNearest(-1e12, 0.0, 5), (std::vector<size_t>{0, 1}));
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
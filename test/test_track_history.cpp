@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <people_msgs_utils/track_history.h>
+
+#include <cmath>
+
+using namespace people_msgs_utils;
+
+/// Creates a person at the given position and orientation
+Person createPerson(const std::string& name, double x, double y, double yaw, unsigned long int age = 1);
+
+// Test cases
+TEST(TrackHistoryTest, estimates) {
+	TrackHistory::Parameters params;
+	params.capacity = 4;
+	TrackHistory history(params);
+
+	// constant velocity and heading rate are estimated exactly
+	for (int k = 0; k < 10; k++) {
+		double t = 0.1 * k;
+		People people{createPerson("a", 1.0 + 0.5 * t, -2.0 * t, 0.3 * t, k)};
+		history.update(people, t);
+	}
+	size_t track = history.find("a");
+	ASSERT_NE(track, TrackHistory::NONE);
+	EXPECT_EQ(history.size(), 1);
+	EXPECT_EQ(history.getName(track), "a");
+	EXPECT_EQ(history.getStatesCount(track), 4);
+	EXPECT_DOUBLE_EQ(history.getLastSeen(track), 0.9);
+	// latest states first
+	for (size_t k = 0; k < 4; k++) {
+		EXPECT_NEAR(history.getState(track, k).stamp, 0.9 - 0.1 * k, 1e-12);
+		EXPECT_NEAR(history.getState(track, k).x, 1.0 + 0.5 * (0.9 - 0.1 * k), 1e-12);
+	}
+	// the tracker reported zero velocity initially, which is smoothed out
+	const auto& estimate = history.getEstimate(track);
+	EXPECT_NEAR(estimate.vx, 0.5, 1e-2);
+	EXPECT_NEAR(estimate.vy, -2.0, 1e-2);
+	EXPECT_NEAR(estimate.heading_rate, 0.3, 1e-3);
+	EXPECT_LT(std::abs(estimate.ax), 0.5);
+
+	// constant acceleration
+	TrackHistory accelerating(params);
+	for (int k = 0; k < 100; k++) {
+		double t = 0.1 * k;
+		accelerating.update(createPerson("b", 0.5 * t * t, 0.0, 0.0, k), t);
+	}
+	EXPECT_NEAR(accelerating.getEstimate(0).ax, 1.0, 1e-3);
+	EXPECT_NEAR(accelerating.getEstimate(0).vx, 9.9, 0.2);
+
+	// old observations are ignored
+	accelerating.update(createPerson("b", 0.0, 0.0, 0.0, 200), 5.0);
+	EXPECT_DOUBLE_EQ(accelerating.getLastSeen(0), 9.9);
+}
+
+TEST(TrackHistoryTest, eviction) {
+	TrackHistory::Parameters params;
+	params.max_tracks = 2;
+	params.timeout = 1.0;
+	TrackHistory history(params);
+
+	history.update(People{createPerson("a", 0.0, 0.0, 0.0), createPerson("b", 1.0, 0.0, 0.0)}, 0.0);
+	EXPECT_EQ(history.size(), 2);
+	history.update(People{createPerson("a", 0.1, 0.0, 0.0, 2)}, 0.5);
+	// no free slot, the least recently seen track is replaced
+	history.update(People{createPerson("c", 2.0, 0.0, 0.0)}, 0.6);
+	EXPECT_EQ(history.size(), 2);
+	EXPECT_EQ(history.find("b"), TrackHistory::NONE);
+	EXPECT_NE(history.find("a"), TrackHistory::NONE);
+	EXPECT_EQ(history.getStatesCount(history.find("c")), 1);
+
+	// timeout
+	history.update(People{createPerson("c", 2.0, 0.0, 0.0, 2)}, 1.55);
+	EXPECT_EQ(history.find("a"), TrackHistory::NONE);
+	EXPECT_EQ(history.size(), 1);
+
+	// reused ID
+	size_t track = history.find("c");
+	history.update(createPerson("c", 5.0, 0.0, 0.0, 1), 1.6);
+	EXPECT_EQ(history.find("c"), track);
+	EXPECT_EQ(history.getStatesCount(track), 1);
+	EXPECT_DOUBLE_EQ(history.getState(track, 0).x, 5.0);
+
+	history.clear();
+	EXPECT_EQ(history.size(), 0);
+	EXPECT_EQ(history.find("c"), TrackHistory::NONE);
+	history.update(createPerson("d", 0.0, 0.0, 0.0), 2.0);
+	EXPECT_EQ(history.find("d"), 0);
+}
+
+int main(int argc, char** argv) {
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
+
+// .........................................................................
+
+Person createPerson(const std::string& name, double x, double y, double yaw, unsigned long int age) {
+	geometry_msgs::PoseWithCovariance pose;
+	pose.pose.position.x = x;
+	pose.pose.position.y = y;
+	pose.pose.orientation.z = std::sin(yaw / 2.0);
+	pose.pose.orientation.w = std::cos(yaw / 2.0);
+	geometry_msgs::PoseWithCovariance vel;
+	return Person(name, pose, vel, 1.0, false, true, 1, age, "");
+}